@@ -0,0 +1,256 @@
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+#include "../include/blackScholesModel.h"
+#include "../include/optionGreeks.h"
+#include "../include/batchPricing.h"
+#include "../include/chainPricing.h"
+#include "../include/pricingCore.h"
+
+using namespace std;
+
+// Compares the per-object blackScholesModel and optionGreeks paths against blackScholesBatchPrice and
+// the fused blackScholesBatchGreeks, and the flat batch against the per-expiry chain functions.
+int main()
+{
+    const size_t numOptions = 500000;
+
+    optionBatch batch;
+    batch.resize(numOptions);
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> spotDist(50.0, 150.0);
+    std::uniform_real_distribution<double> moneynessDist(0.7, 1.3);
+    std::uniform_real_distribution<double> timeDist(0.05, 2.0);
+    std::uniform_real_distribution<double> rateDist(0.0, 0.08);
+    std::uniform_real_distribution<double> volDist(0.1, 0.6);
+
+    for (size_t i = 0; i < numOptions; ++i)
+    {
+        batch.underlyingPrice[i] = spotDist(generator);
+        batch.strikePrice[i] = batch.underlyingPrice[i] * moneynessDist(generator);
+        batch.timeToExperation[i] = timeDist(generator);
+        batch.riskFreeRate[i] = rateDist(generator);
+        batch.volatility[i] = volDist(generator);
+        batch.optionType[i] = (i % 2 == 0) ? CALL : PUT;
+    }
+
+    // Per-object path, as the row loops in main.cpp do it.
+    std::vector<double> objectPrices(numOptions);
+    auto start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < numOptions; ++i)
+    {
+        blackScholesModel model(batch.underlyingPrice[i], batch.strikePrice[i], batch.timeToExperation[i],
+                                batch.riskFreeRate[i], batch.volatility[i], batch.optionType[i]);
+        objectPrices[i] = model.calculateOptionPrice();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> objectElapsed = end - start;
+
+    // Batch path.
+    std::vector<double> batchPrices;
+    start = std::chrono::high_resolution_clock::now();
+    blackScholesBatchPrice(batch, batchPrices);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> batchElapsed = end - start;
+
+    double maxAbsDiff = 0.0;
+    for (size_t i = 0; i < numOptions; ++i)
+    {
+        maxAbsDiff = std::max(maxAbsDiff, std::abs(objectPrices[i] - batchPrices[i]));
+    }
+
+    cout << "Options priced: " << numOptions << endl;
+    cout << "Per-object path: " << objectElapsed.count() << " s, "
+         << numOptions / objectElapsed.count() / 1e6 << " M options/s" << endl;
+    cout << "Batch path:      " << batchElapsed.count() << " s, "
+         << numOptions / batchElapsed.count() / 1e6 << " M options/s" << endl;
+    cout << "Speedup: " << objectElapsed.count() / batchElapsed.count() << "x" << endl;
+    cout << "Max abs difference: " << maxAbsDiff << endl;
+
+    // Price and Greeks: one optionGreeks object per option against one fused pass.
+    double checksum = 0.0;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < numOptions; ++i)
+    {
+        optionGreeks greeks(batch.underlyingPrice[i], batch.strikePrice[i], batch.timeToExperation[i],
+                            batch.riskFreeRate[i], batch.volatility[i]);
+        checksum += greeks.calculateOptionPrice() + greeks.getDelta() + greeks.getGamma() + greeks.getVega()
+                    + greeks.getTheta() + greeks.getRho();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> greeksObjectElapsed = end - start;
+
+    greeksBatch greeks;
+    start = std::chrono::high_resolution_clock::now();
+    blackScholesBatchGreeks(batch, greeks);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> greeksBatchElapsed = end - start;
+
+    cout << "Per-object price + Greeks: " << greeksObjectElapsed.count() << " s, "
+         << numOptions / greeksObjectElapsed.count() / 1e6 << " M options/s (checksum " << checksum << ")" << endl;
+    cout << "Fused batch price + Greeks: " << greeksBatchElapsed.count() << " s, "
+         << numOptions / greeksBatchElapsed.count() / 1e6 << " M options/s" << endl;
+    cout << "Speedup: " << greeksObjectElapsed.count() / greeksBatchElapsed.count() << "x" << endl;
+
+    // The batch alternates calls and puts, so everything above ran on the mixed-type kernels. After
+    // partitionByOptionType each half runs on a kernel specialized on its type.
+    optionBatch sorted = batch;
+    std::vector<size_t> originalIndex;
+    partitionByOptionType(sorted, originalIndex);
+
+    // Outputs are already allocated here, so time the mixed kernels again for a like-for-like comparison.
+    start = std::chrono::high_resolution_clock::now();
+    blackScholesBatchPrice(batch, batchPrices);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> mixedPriceElapsed = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    blackScholesBatchGreeks(batch, greeks);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> mixedGreeksElapsed = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    blackScholesBatchPrice(sorted, batchPrices);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> typedPriceElapsed = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    blackScholesBatchGreeks(sorted, greeks);
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> typedGreeksElapsed = end - start;
+
+    cout << "Mixed-type price:           " << numOptions / mixedPriceElapsed.count() / 1e6 << " M options/s" << endl;
+    cout << "Partitioned price:          " << numOptions / typedPriceElapsed.count() / 1e6 << " M options/s" << endl;
+    cout << "Mixed-type price + Greeks:  " << numOptions / mixedGreeksElapsed.count() / 1e6 << " M options/s" << endl;
+    cout << "Partitioned price + Greeks: " << numOptions / typedGreeksElapsed.count() / 1e6 << " M options/s" << endl;
+
+    // Runtime Greek masks: only the selected columns are computed and written.
+    const std::pair<const char*, unsigned> masks[] = {
+        {"delta", GREEK_DELTA},
+        {"gamma + vega", GREEK_GAMMA | GREEK_VEGA},
+        {"price + Greeks", GREEK_ALL},
+        {"optionPriceIV", GREEK_PRICE_IV},
+        {"all + adjusted", GREEK_ALL | GREEK_ADJUSTED_ALL},
+    };
+    selectedGreeksBatch selected;
+    for (const auto& [name, mask] : masks)
+    {
+        blackScholesBatchGreeks(batch, mask, selected);
+        start = std::chrono::high_resolution_clock::now();
+        blackScholesBatchGreeks(batch, mask, selected);
+        end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double> maskElapsed = end - start;
+        cout << "Mask " << name << ": " << numOptions / maskElapsed.count() / 1e6 << " M options/s" << endl;
+    }
+
+    // An options chain: 64 expiries of 256 strikes on one underlying. The flat batch recomputes ln(S / K),
+    // sqrt(T) and e^{-rT} per option; the chain functions compute sqrt(T), e^{-rT} and ln(S) once per expiry.
+    const size_t numExpiries = 64;
+    const size_t numStrikes = 256;
+    const int repetitions = 50;
+    optionBatch chainBatch;
+    chainBatch.resize(numExpiries * numStrikes);
+    for (size_t e = 0; e < numExpiries; ++e)
+    {
+        for (size_t k = 0; k < numStrikes; ++k)
+        {
+            const size_t i = e * numStrikes + k;
+            chainBatch.underlyingPrice[i] = 100.0;
+            chainBatch.strikePrice[i] = 60.0 + 80.0 * k / numStrikes;
+            chainBatch.timeToExperation[i] = 0.02 + 0.03 * e;
+            chainBatch.riskFreeRate[i] = 0.04;
+            chainBatch.volatility[i] = volDist(generator);
+            chainBatch.optionType[i] = (k % 2 == 0) ? CALL : PUT;
+        }
+    }
+    std::vector<size_t> chainIndex;
+    const std::vector<optionChain> chains = groupIntoChains(chainBatch, chainIndex);
+
+    blackScholesBatchGreeks(chainBatch, greeks);
+    start = std::chrono::high_resolution_clock::now();
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+        blackScholesBatchGreeks(chainBatch, greeks);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> flatElapsed = end - start;
+
+    std::vector<greeksBatch> chainGreeks(chains.size());
+    for (size_t c = 0; c < chains.size(); ++c)
+    {
+        blackScholesChainGreeks(chains[c], chainGreeks[c]);
+    }
+    start = std::chrono::high_resolution_clock::now();
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+        for (size_t c = 0; c < chains.size(); ++c)
+        {
+            blackScholesChainGreeks(chains[c], chainGreeks[c]);
+        }
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> chainElapsed = end - start;
+
+    double chainMaxDiff = 0.0;
+    size_t k = 0;
+    for (const greeksBatch& chainResult : chainGreeks)
+    {
+        for (size_t j = 0; j < chainResult.size(); ++j, ++k)
+        {
+            chainMaxDiff = std::max(chainMaxDiff, std::abs(chainResult.price[j] - greeks.price[chainIndex[k]]));
+        }
+    }
+
+    const double chainOptions = static_cast<double>(chainBatch.size()) * repetitions;
+    cout << "Chain of " << numExpiries << " x " << numStrikes << ", price + Greeks" << endl;
+    cout << "Flat batch:       " << chainOptions / flatElapsed.count() / 1e6 << " M options/s" << endl;
+    cout << "Per-expiry chain: " << chainOptions / chainElapsed.count() / 1e6 << " M options/s" << endl;
+    cout << "Speedup: " << flatElapsed.count() / chainElapsed.count() << "x, max abs price difference "
+         << chainMaxDiff << endl;
+
+    // Per-option scalar paths: price alone, the closed-form first-order Greeks, and the price with its
+    // first and second-order sensitivities from one evaluation on second-order duals.
+    const size_t scalarOptions = 200000;
+    double scalarChecksum = 0.0;
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < scalarOptions; ++i)
+    {
+        scalarChecksum += blackScholesPrice(batch.underlyingPrice[i], batch.strikePrice[i], batch.timeToExperation[i],
+                                            batch.riskFreeRate[i], batch.volatility[i], batch.optionType[i]);
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> scalarPriceElapsed = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < scalarOptions; ++i)
+    {
+        scalarChecksum += blackScholesPriceAndGreeks(batch.underlyingPrice[i], batch.strikePrice[i],
+                                                     batch.timeToExperation[i], batch.riskFreeRate[i],
+                                                     batch.volatility[i], batch.optionType[i]).gamma;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> scalarGreeksElapsed = end - start;
+
+    start = std::chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < scalarOptions; ++i)
+    {
+        scalarChecksum += blackScholesPriceAndSensitivities(batch.underlyingPrice[i], batch.strikePrice[i],
+                                                            batch.timeToExperation[i], batch.riskFreeRate[i],
+                                                            batch.volatility[i], batch.optionType[i]).vanna;
+    }
+    end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> scalarDualElapsed = end - start;
+
+    cout << "Scalar price:                      " << scalarPriceElapsed.count() / scalarOptions * 1e9 << " ns/option" << endl;
+    cout << "Scalar closed-form Greeks:         " << scalarGreeksElapsed.count() / scalarOptions * 1e9 << " ns/option" << endl;
+    cout << "Scalar dual, 1st + 2nd order:      " << scalarDualElapsed.count() / scalarOptions * 1e9
+         << " ns/option (checksum " << scalarChecksum << ")" << endl;
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/ErrorHandler.h"
+
+using namespace std;
+
+// A burst of bad inputs: numThreads threads each logging perThread messages from one call site, with
+// the open-append-close logging ErrorHandler used to do, the asynchronous ring buffer alone, and the
+// ring buffer behind the default per-site rate limit.
+static void logErrorSynchronously(const std::string& errorMessage)
+{
+    std::ofstream errorLog("error.log", std::ios::app);
+    if (errorLog.is_open())
+    {
+        errorLog << errorMessage << std::endl;
+        errorLog.close();
+    }
+}
+
+template <class Log>
+static double secondsForBurst(int numThreads, int perThread, Log&& log)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < perThread; ++i)
+            {
+                log("Error in benchmarkErrorHandler: thread " + std::to_string(t) + ", option " + std::to_string(i)
+                    + ", Invalid input: Volatility must be greater than or equal to 0");
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    return elapsed.count();
+}
+
+int main()
+{
+    const int numThreads = 4;
+    const int perThread = 20000;
+    const double messages = static_cast<double>(numThreads) * perThread;
+
+    const double synchronous = secondsForBurst(numThreads, perThread, logErrorSynchronously);
+
+    ErrorHandler::setRateLimit(ErrorHandler::noLimit, 1);
+    const std::uint64_t writtenBefore = ErrorHandler::writtenCount();
+    const std::uint64_t droppedBefore = ErrorHandler::droppedCount();
+    const double asynchronous = secondsForBurst(numThreads, perThread, [](const std::string& message) {
+        ErrorHandler::logError(message);
+    });
+    auto start = std::chrono::high_resolution_clock::now();
+    ErrorHandler::flush();
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> flushElapsed = end - start;
+    const std::uint64_t written = ErrorHandler::writtenCount() - writtenBefore;
+    const std::uint64_t dropped = ErrorHandler::droppedCount() - droppedBefore;
+
+    ErrorHandler::setRateLimit(100, 10000);
+    const std::uint64_t limitedBefore = ErrorHandler::writtenCount();
+    const double limited = secondsForBurst(numThreads, perThread, [](const std::string& message) {
+        ErrorHandler::logError(message);
+    });
+    ErrorHandler::flush();
+
+    cout << "Messages logged: " << messages << " from " << numThreads << " threads" << endl;
+    cout << "Open-append-close: " << messages / synchronous / 1e6 << " M messages/s" << endl;
+    cout << "Ring buffer:       " << messages / asynchronous / 1e6 << " M messages/s at the call site, flush "
+         << flushElapsed.count() << " s" << endl;
+    cout << "Written " << written << ", dropped " << dropped << " (buffer of " << ErrorHandler::capacity
+         << " messages)" << endl;
+    cout << "Rate-limited:      " << messages / limited / 1e6 << " M messages/s at the call site, written "
+         << ErrorHandler::writtenCount() - limitedBefore << endl;
+
+    return 0;
+}
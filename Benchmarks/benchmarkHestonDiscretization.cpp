@@ -0,0 +1,78 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "../include/pricingCore.h"
+
+using namespace std;
+
+// Discretization bias of the Heston Monte Carlo price against the number of time steps, full-truncation
+// Euler against quadratic-exponential, for a few maturities. The reference is hestonTerminalVariancePrice,
+// the limit of the estimator as the steps go to zero. The standard error is that of the mean of independent
+// seeds, so a bias within two of it is noise.
+struct biasEstimate
+{
+    double bias;
+    double standardError;
+    double seconds;
+};
+
+static biasEstimate biasOf(double S, double K, double T, double r, const hestonParameters& params, int steps,
+                           HestonDiscretization discretization, double reference)
+{
+    const int seeds = 10, paths = 10000;
+    double sum = 0.0, sumOfSquares = 0.0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int seed = 1; seed <= seeds; ++seed)
+    {
+        const double price = hestonMonteCarloPrice(S, K, T, r, params, CALL, paths, steps,
+                                                   static_cast<std::uint64_t>(seed), CDF_POLYNOMIAL, 0, discretization);
+        sum += price;
+        sumOfSquares += price * price;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+
+    const double mean = sum / seeds;
+    const double variance = (sumOfSquares - seeds * mean * mean) / (seeds - 1);
+    return {mean - reference, std::sqrt(std::max(variance, 0.0) / seeds), elapsed.count() / seeds};
+}
+
+int main()
+{
+    const double S = 100.0, K = 100.0, r = 0.03;
+    struct scenario
+    {
+        const char* name;
+        hestonParameters params;
+    };
+    const scenario scenarios[] = {
+        {"Feller condition met (2 kappa theta / sigma^2 = 1.8)", {0.04, 2.0, 0.04, 0.3, -0.7}},
+        {"Feller condition violated (2 kappa theta / sigma^2 = 0.15)", {0.04, 1.5, 0.04, 0.9, -0.7}},
+    };
+
+    cout << fixed;
+    for (const scenario& s : scenarios)
+    {
+        cout << s.name << endl;
+        for (double T : {0.25, 1.0, 5.0})
+        {
+            const double reference = hestonTerminalVariancePrice(S, K, T, r, s.params, CALL);
+            cout << "  T = " << setprecision(2) << T << ", reference " << setprecision(6) << reference << endl;
+            cout << "    steps   Euler bias      QE bias   std error   Euler ms   QE ms" << endl;
+            for (int steps : {1, 2, 5, 10, 20, 50, 100, 200})
+            {
+                const biasEstimate euler = biasOf(S, K, T, r, s.params, steps, HESTON_EULER, reference);
+                const biasEstimate qe = biasOf(S, K, T, r, s.params, steps, HESTON_QE, reference);
+                cout << setw(9) << steps << setprecision(4) << setw(13) << euler.bias << setw(13) << qe.bias
+                     << setw(12) << std::max(euler.standardError, qe.standardError) << setprecision(2) << setw(11)
+                     << euler.seconds * 1e3 << setw(8) << qe.seconds * 1e3 << endl;
+            }
+        }
+        cout << endl;
+    }
+    return 0;
+}
@@ -0,0 +1,171 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <cstdint>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "../include/pricingCore.h"
+#include "../include/philox.h"
+#include "../include/randomNormals.h"
+
+using namespace std;
+
+// Heston Monte Carlo: one pricing, the adjoint sensitivities, and the 14 central-difference pricings of
+// bump-and-reprice for the same seven sensitivities; the generator and path-blocked engines on the pricing of
+// one main.cpp row; then the counter-based pricing on 1 to N worker threads,
+// and the rate of the normal generators behind them.
+template <class Work>
+static double secondsOf(int repetitions, Work&& work)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+        work();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    return elapsed.count() / repetitions;
+}
+
+int main()
+{
+    const hestonParameters params = {0.04, 2.0, 0.04, 0.3, -0.7};
+    const double S = 100.0, K = 100.0, T = 1.0, r = 0.05;
+    const int simulations = 20000, steps = 100;
+
+    double price = 0.0;
+    const double pricing = secondsOf(3, [&]() {
+        std::mt19937 generator(42);
+        price = hestonMonteCarloPrice(S, K, T, r, params, CALL, simulations, steps, generator);
+    });
+
+    double counterPrice = 0.0;
+    const double counterPricing = secondsOf(3, [&]() {
+        counterPrice = hestonMonteCarloPrice(S, K, T, r, params, CALL, simulations, steps, std::uint64_t{42});
+    });
+
+    hestonSensitivities sensitivities{};
+    const double adjoint = secondsOf(3, [&]() {
+        std::mt19937 generator(42);
+        sensitivities = hestonMonteCarloSensitivities(S, K, T, r, params, CALL, simulations, steps, generator);
+    });
+
+    // Central differences with common random numbers.
+    const double h = 1e-4;
+    double bumpedV0 = 0.0;
+    const double bumped = secondsOf(1, [&]() {
+        double hestonParameters::* const members[] = {&hestonParameters::v0, &hestonParameters::kappa,
+                                                      &hestonParameters::theta, &hestonParameters::sigma,
+                                                      &hestonParameters::rho};
+        for (auto member : members)
+        {
+            hestonParameters up = params, down = params;
+            up.*member += h;
+            down.*member -= h;
+            std::mt19937 upGenerator(42), downGenerator(42);
+            const double difference = (hestonMonteCarloPrice(S, K, T, r, up, CALL, simulations, steps, upGenerator)
+                                       - hestonMonteCarloPrice(S, K, T, r, down, CALL, simulations, steps, downGenerator)) / (2 * h);
+            if (member == &hestonParameters::v0)
+            {
+                bumpedV0 = difference;
+            }
+        }
+        for (double bump : {h, -h})
+        {
+            std::mt19937 spotGenerator(42), rateGenerator(42);
+            hestonMonteCarloPrice(S + bump, K, T, r, params, CALL, simulations, steps, spotGenerator);
+            hestonMonteCarloPrice(S, K, T, r + bump, params, CALL, simulations, steps, rateGenerator);
+        }
+    });
+
+    cout << fixed << setprecision(6);
+    cout << "Paths: " << simulations << ", steps: " << steps << endl;
+    cout << "Price:                " << price << " in " << pricing * 1e3 << " ms" << endl;
+    cout << "Philox price:         " << counterPrice << " in " << counterPricing * 1e3 << " ms" << endl;
+    cout << "Adjoint sensitivities: " << adjoint * 1e3 << " ms (" << adjoint / pricing << "x one pricing)" << endl;
+    cout << "Bump and reprice:      " << bumped * 1e3 << " ms (" << bumped / pricing << "x one pricing)" << endl;
+    cout << "dV/dv0 adjoint " << sensitivities.v0 << ", central difference " << bumpedV0 << endl;
+    cout << "delta " << sensitivities.delta << ", rho(r) " << sensitivities.riskFreeRate << ", kappa "
+         << sensitivities.kappa << ", theta " << sensitivities.theta << ", sigma " << sensitivities.sigma
+         << ", rho " << sensitivities.rho << endl;
+
+    // The per-row pricing of main.cpp: 1000 paths of 1000 steps.
+    double rowPrice = 0.0, rowBlockedPrice = 0.0;
+    const double row = secondsOf(3, [&]() {
+        std::mt19937 generator(42);
+        rowPrice = hestonMonteCarloPrice(S, K, T, r, params, CALL, 1000, 1000, generator, CDF_POLYNOMIAL, 1);
+    });
+    const double rowBlocked = secondsOf(3, [&]() {
+        rowBlockedPrice = hestonMonteCarloPrice(S, K, T, r, params, CALL, 1000, 1000, std::uint64_t{42}, CDF_POLYNOMIAL, 1);
+    });
+    cout << "1000 x 1000, one thread: generator " << row * 1e3 << " ms (" << rowPrice << "), path-blocked "
+         << rowBlocked * 1e3 << " ms (" << rowBlockedPrice << "), " << setprecision(1) << row / rowBlocked
+         << "x" << setprecision(6) << endl;
+
+    // Scaling: counter-based normals, so the prices must be bit-identical.
+    const unsigned hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    cout << endl << "Threads    ms    M paths/s  speedup  price" << endl;
+    double serial = 0.0;
+    for (unsigned threads = 1; threads <= 2 * hardwareThreads; threads *= 2)
+    {
+        double threadedPrice = 0.0;
+        const double seconds = secondsOf(3, [&]() {
+            threadedPrice = hestonMonteCarloPrice(S, K, T, r, params, CALL, 4 * simulations, steps, std::uint64_t{42},
+                                                  CDF_POLYNOMIAL, threads);
+        });
+        if (threads == 1)
+        {
+            serial = seconds;
+        }
+        cout << setw(7) << threads << setw(9) << setprecision(1) << seconds * 1e3 << setw(11) << setprecision(3)
+             << 4 * simulations / seconds / 1e6 << setw(9) << setprecision(2) << serial / seconds << "  "
+             << setprecision(10) << threadedPrice << endl;
+    }
+
+    // Normals: one buffer of 2 * steps per path, as the engines draw them.
+    const std::size_t count = 2 * steps;
+    const int paths = 20000;
+    std::vector<double> normals(count);
+    double checksum = 0.0;
+    const double mersenne = secondsOf(1, [&]() {
+        std::mt19937 generator(42);
+        std::normal_distribution<double> distribution(0.0, 1.0);
+        for (int path = 0; path < paths; ++path)
+        {
+            for (double& z : normals)
+            {
+                z = distribution(generator);
+            }
+            checksum += normals[0];
+        }
+    });
+    const double scalarPhilox = secondsOf(1, [&]() {
+        for (int path = 0; path < paths; ++path)
+        {
+            philoxNormalStream stream(42, path);
+            for (double& z : normals)
+            {
+                z = stream();
+            }
+            checksum += normals[0];
+        }
+    });
+    const double batchPhilox = secondsOf(1, [&]() {
+        for (int path = 0; path < paths; ++path)
+        {
+            philoxNormals(42, path, 0, count, normals.data());
+            checksum += normals[0];
+        }
+    });
+    const double normalsPerSecond = paths * static_cast<double>(count) / 1e6;
+    cout << endl << setprecision(1);
+    cout << "mt19937 normal_distribution: " << normalsPerSecond / mersenne << " M normals/s" << endl;
+    cout << "philoxNormalStream:          " << normalsPerSecond / scalarPhilox << " M normals/s" << endl;
+    cout << "philoxNormals:               " << normalsPerSecond / batchPhilox << " M normals/s ("
+         << scalarPhilox / batchPhilox << "x the scalar stream)" << endl;
+    cout << setprecision(3) << "(checksum " << checksum << ")" << endl;
+    return 0;
+}
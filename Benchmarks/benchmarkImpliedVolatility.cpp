@@ -0,0 +1,265 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../include/cpuDispatch.h"
+#include "../include/batchPricing.h"
+#include "../include/chainPricing.h"
+#include "../include/impliedVolatility.h"
+#include "../include/impliedVolatilityCache.h"
+
+using namespace std;
+
+// Implied volatility throughput per SIMD level on random quotes, next to pricing the same batch, plus how
+// many Householder steps the solves took and how closely they recover the volatilities the prices came from.
+template <class Kernel>
+static double millionsPerSecond(size_t count, int repetitions, Kernel&& kernel)
+{
+    kernel();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+        kernel();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    return count * static_cast<double>(repetitions) / elapsed.count() / 1e6;
+}
+
+int main()
+{
+    const size_t count = 1 << 20;
+    const int repetitions = 10;
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> spotDist(50.0, 150.0);
+    std::uniform_real_distribution<double> moneynessDist(0.7, 1.3);
+    std::uniform_real_distribution<double> timeDist(0.02, 2.0);
+    std::uniform_real_distribution<double> volDist(0.05, 0.8);
+
+    optionBatch batch;
+    batch.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch.underlyingPrice[i] = spotDist(generator);
+        batch.strikePrice[i] = batch.underlyingPrice[i] * moneynessDist(generator);
+        batch.timeToExperation[i] = timeDist(generator);
+        batch.riskFreeRate[i] = 0.03;
+        batch.volatility[i] = volDist(generator);
+        batch.optionType[i] = (i % 2 == 0) ? CALL : PUT;
+    }
+
+    // Prices from erfc in long double rather than the batch kernels, whose polynomial N(x) is only accurate
+    // to 7.5e-8, so that the solved volatilities can be compared with the ones the prices came from.
+    std::vector<double> optionPrice(count), vegaOverPrice(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const long double s = batch.volatility[i] * std::sqrt(static_cast<long double>(batch.timeToExperation[i]));
+        const long double d1 = (std::log(static_cast<long double>(batch.underlyingPrice[i]) / batch.strikePrice[i])
+                                + batch.riskFreeRate[i] * batch.timeToExperation[i]) / s + 0.5L * s;
+        const long double sign = batch.optionType[i] == CALL ? 1.0L : -1.0L;
+        const long double discountedStrike = batch.strikePrice[i] * std::exp(-static_cast<long double>(batch.riskFreeRate[i]) * batch.timeToExperation[i]);
+        const long double price = sign * (batch.underlyingPrice[i] * 0.5L * std::erfc(-sign * d1 / std::sqrt(2.0L))
+                                          - discountedStrike * 0.5L * std::erfc(-sign * (d1 - s) / std::sqrt(2.0L)));
+        const long double vega = batch.underlyingPrice[i] * std::sqrt(static_cast<long double>(batch.timeToExperation[i]))
+                                 * std::exp(-0.5L * d1 * d1) / std::sqrt(2.0L * std::numbers::pi_v<long double>);
+        optionPrice[i] = static_cast<double>(price);
+        vegaOverPrice[i] = static_cast<double>(vega / price);
+    }
+
+    std::vector<double> volatility(count), prices(count);
+    std::vector<std::uint8_t> iterations(count);
+
+    cout << "Quotes: " << count << ", detected level: " << simdLevelName(detectSimdLevel()) << endl;
+    cout << setw(8) << "level" << setw(16) << "IV M quotes/s" << setw(18) << "price M options/s" << endl;
+    for (SimdLevel level : {SCALAR, SSE42, AVX2, AVX512})
+    {
+        const simdKernelTable* kernels = simdKernelsFor(level);
+        if (kernels == nullptr)
+        {
+            cout << setw(8) << simdLevelName(level) << "  not supported" << endl;
+            continue;
+        }
+
+        const double solve = millionsPerSecond(count, repetitions, [&]() {
+            kernels->impliedVolatility(count, optionPrice.data(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                                       batch.timeToExperation.data(), batch.riskFreeRate.data(),
+                                       batch.optionType.data(), volatility.data(), iterations.data());
+        });
+        const double price = millionsPerSecond(count, repetitions, [&]() {
+            kernels->blackScholesPrice(count, batch.underlyingPrice.data(), batch.strikePrice.data(),
+                                       batch.timeToExperation.data(), batch.riskFreeRate.data(),
+                                       batch.volatility.data(), batch.optionType.data(), prices.data());
+        });
+        cout << setw(8) << simdLevelName(level) << setw(16) << fixed << setprecision(2) << solve << setw(18) << price
+             << endl;
+    }
+
+    size_t histogram[9] = {};
+    for (size_t i = 0; i < count; ++i)
+    {
+        ++histogram[std::min<size_t>(iterations[i], 8)];
+    }
+    cout << "Householder steps:";
+    for (size_t k = 0; k <= 8; ++k)
+    {
+        if (histogram[k] != 0)
+        {
+            cout << "  " << k << ": " << histogram[k];
+        }
+    }
+    cout << endl;
+
+    // A price rounded to double moves the volatility by up to price eps / vega, and the volatility itself is
+    // rounded to vol eps, so errors are counted in units of eps (vol + price / vega).
+    // Quotes whose rounded price is 0 or at most the intrinsic value have no volatility to recover, and
+    // below 1e-10 the long double reference prices lose too many digits to N(d1) - N(d2) cancellation.
+    double maxError = 0.0;
+    size_t unsolved = 0;
+    size_t tiny = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (!(volatility[i] > 0.0))
+        {
+            ++unsolved;
+            continue;
+        }
+        if (optionPrice[i] < 1e-10)
+        {
+            ++tiny;
+            continue;
+        }
+        const double error = std::abs(volatility[i] - batch.volatility[i])
+                             / (std::numeric_limits<double>::epsilon() * (batch.volatility[i] + 1.0 / vegaOverPrice[i]));
+        maxError = std::max(maxError, error);
+    }
+    cout << "Max error: " << fixed << setprecision(2) << maxError << " ulp (" << unsolved
+         << " quotes without time value, " << tiny << " priced below 1e-10 not checked)" << endl;
+
+    // Warm starts on a surface of smiles: cold batch solves, chain solves seeded from the neighboring strike,
+    // and surface solves seeded from the previous snapshot after a 1% move in every volatility.
+    const size_t expiries = 64, strikes = 401;
+    std::vector<optionChain> chains(expiries);
+    std::vector<std::vector<double>> chainPrice(expiries), snapshot(expiries);
+    for (size_t c = 0; c < expiries; ++c)
+    {
+        optionChain& chain = chains[c];
+        chain.underlyingPrice = 100.0;
+        chain.timeToExperation = 0.02 + 2.0 * c / expiries;
+        chain.riskFreeRate = 0.03;
+        chain.resize(strikes);
+        snapshot[c].resize(strikes);
+        for (size_t k = 0; k < strikes; ++k)
+        {
+            const double strikePrice = 60.0 + 0.25 * k;
+            const double moneyness = std::log(strikePrice / 100.0) / std::sqrt(chain.timeToExperation);
+            const double vol = 0.2 - 0.03 * moneyness + 0.01 * moneyness * moneyness;
+            chain.strikePrice[k] = strikePrice;
+            chain.optionType[k] = strikePrice < 100.0 ? PUT : CALL;
+            chain.volatility[k] = vol;
+            snapshot[c][k] = vol * 1.01;
+        }
+        blackScholesChainPrice(chain, chainPrice[c]);
+    }
+
+    const size_t surfaceSize = expiries * strikes;
+    std::vector<double> flatSpot(strikes, 100.0), flatExpiry(strikes), flatRate(strikes, 0.03), flatVol(strikes);
+    std::vector<std::uint8_t> flatSteps(strikes);
+    std::vector<std::vector<std::uint8_t>> surfaceSteps;
+    impliedVolatilityStats stats[3];
+
+    const double cold = millionsPerSecond(surfaceSize, repetitions, [&]() {
+        for (size_t c = 0; c < expiries; ++c)
+        {
+            std::fill(flatExpiry.begin(), flatExpiry.end(), chains[c].timeToExperation);
+            impliedVolatilityBatch(strikes, chainPrice[c].data(), flatSpot.data(), chains[c].strikePrice.data(),
+                                   flatExpiry.data(), flatRate.data(), chains[c].optionType.data(), flatVol.data(),
+                                   flatSteps.data());
+            for (std::uint8_t step : flatSteps)
+            {
+                stats[0].iterations += step;
+            }
+        }
+    });
+    const double neighbor = millionsPerSecond(surfaceSize, repetitions, [&]() {
+        for (size_t c = 0; c < expiries; ++c)
+        {
+            impliedVolatilityChain(chains[c].underlyingPrice, chains[c].timeToExperation, chains[c].riskFreeRate,
+                                   strikes, chainPrice[c].data(), chains[c].strikePrice.data(),
+                                   chains[c].optionType.data(), nullptr, flatVol.data(), flatSteps.data());
+            for (std::uint8_t step : flatSteps)
+            {
+                stats[1].iterations += step;
+            }
+        }
+    });
+    const double warm = millionsPerSecond(surfaceSize, repetitions, [&]() {
+        for (size_t c = 0; c < expiries; ++c)
+        {
+            chains[c].volatility = snapshot[c];
+        }
+        stats[2].iterations += impliedVolatilitySurface(chains, chainPrice, surfaceSteps, 1).iterations;
+    });
+    double parallel = 0.0;
+    const unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    if (threads > 1)
+    {
+        parallel = millionsPerSecond(surfaceSize, repetitions, [&]() {
+            for (size_t c = 0; c < expiries; ++c)
+            {
+                chains[c].volatility = snapshot[c];
+            }
+            impliedVolatilitySurface(chains, chainPrice, surfaceSteps, threads);
+        });
+    }
+
+    const double solves = static_cast<double>(surfaceSize) * (repetitions + 1);
+    cout << "Surface of " << expiries << " x " << strikes << " (M quotes/s, mean steps):" << endl;
+    cout << setw(22) << "cold" << setw(10) << setprecision(2) << cold << setw(8) << stats[0].iterations / solves << endl;
+    cout << setw(22) << "neighbor seeds" << setw(10) << neighbor << setw(8) << stats[1].iterations / solves << endl;
+    cout << setw(22) << "snapshot seeds" << setw(10) << warm << setw(8) << stats[2].iterations / solves << endl;
+    if (threads > 1)
+    {
+        cout << setw(22) << ("snapshot, " + std::to_string(threads) + " threads") << setw(10) << parallel << endl;
+    }
+
+    // A feed replay in which 60% of the quotes repeat one of the last 4096, solved one quote at a time as
+    // optionGreeksModel does, without and with the quote cache.
+    const size_t replayCount = 1 << 18;
+    std::vector<size_t> replay(replayCount);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    for (size_t i = 0; i < replayCount; ++i)
+    {
+        replay[i] = (i > 4096 && unit(generator) < 0.6) ? replay[i - 1 - generator() % 4096] : i;
+    }
+    double sink = 0.0;
+    const double uncached = millionsPerSecond(replayCount, 1, [&]() {
+        for (size_t q : replay)
+        {
+            sink += impliedVolatility(optionPrice[q], batch.underlyingPrice[q], batch.strikePrice[q],
+                                      batch.timeToExperation[q], batch.riskFreeRate[q], batch.optionType[q]);
+        }
+    });
+    impliedVolatilityCache cache;
+    const double cached = millionsPerSecond(replayCount, 1, [&]() {
+        cache.clear();
+        cache.resetStatistics();
+        for (size_t q : replay)
+        {
+            sink += cache.impliedVolatility(optionPrice[q], batch.underlyingPrice[q], batch.strikePrice[q],
+                                            batch.timeToExperation[q], batch.riskFreeRate[q], batch.optionType[q]);
+        }
+    });
+    cout << "Replay, one quote at a time (M quotes/s): uncached " << uncached << ", cached " << cached
+         << ", hit rate " << cache.statistics().hitRate() << (std::isnan(sink) ? " " : "") << endl;
+
+    return 0;
+}
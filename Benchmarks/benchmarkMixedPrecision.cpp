@@ -0,0 +1,130 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "../include/batchPricing.h"
+
+using namespace std;
+
+// Throughput and accuracy of the float and mixed-precision batch paths against the double path.
+static double relativeDifference(double value, double reference)
+{
+    if (reference == 0.0)
+    {
+        return value == 0.0 ? 0.0 : std::numeric_limits<double>::infinity();
+    }
+    return std::abs(value - reference) / std::abs(reference);
+}
+
+static double percentile(std::vector<double> values, double p)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+    const size_t k = std::min(values.size() - 1, static_cast<size_t>(p * values.size()));
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+
+int main()
+{
+    const size_t numOptions = 1 << 20;
+    const double tolerance = 1e-5;
+
+    // Deliberately wide: deep in/out of the money and expiries down to one day.
+    optionBatch batch;
+    batch.resize(numOptions);
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> spotDist(50.0, 150.0);
+    std::uniform_real_distribution<double> moneynessDist(0.5, 1.5);
+    std::uniform_real_distribution<double> timeDist(1.0 / 365.0, 3.0);
+    std::uniform_real_distribution<double> rateDist(0.0, 0.08);
+    std::uniform_real_distribution<double> volDist(0.05, 0.9);
+    for (size_t i = 0; i < numOptions; ++i)
+    {
+        batch.underlyingPrice[i] = spotDist(generator);
+        batch.strikePrice[i] = batch.underlyingPrice[i] * moneynessDist(generator);
+        batch.timeToExperation[i] = timeDist(generator);
+        batch.riskFreeRate[i] = rateDist(generator);
+        batch.volatility[i] = volDist(generator);
+        batch.optionType[i] = (i % 2 == 0) ? CALL : PUT;
+    }
+
+    optionBatchFloat floatBatch;
+    floatBatch.resize(numOptions);
+    for (size_t i = 0; i < numOptions; ++i)
+    {
+        floatBatch.underlyingPrice[i] = static_cast<float>(batch.underlyingPrice[i]);
+        floatBatch.strikePrice[i] = static_cast<float>(batch.strikePrice[i]);
+        floatBatch.timeToExperation[i] = static_cast<float>(batch.timeToExperation[i]);
+        floatBatch.riskFreeRate[i] = static_cast<float>(batch.riskFreeRate[i]);
+        floatBatch.volatility[i] = static_cast<float>(batch.volatility[i]);
+        floatBatch.optionType[i] = batch.optionType[i];
+    }
+
+    std::vector<double> doublePrices(numOptions), mixedPrices(numOptions);
+    std::vector<float> floatPrices(numOptions), floatErrors(numOptions);
+    mixedPrecisionStats stats;
+
+    auto time = [](auto&& run) {
+        run();
+        auto start = std::chrono::high_resolution_clock::now();
+        const int repetitions = 10;
+        for (int rep = 0; rep < repetitions; ++rep)
+        {
+            run();
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration<double>(end - start).count() / repetitions;
+    };
+
+    double doubleTime = time([&]() { blackScholesBatchPrice(batch, doublePrices); });
+    double floatTime = time([&]() {
+        blackScholesBatchPrice(numOptions, floatBatch.underlyingPrice.data(), floatBatch.strikePrice.data(),
+                               floatBatch.timeToExperation.data(), floatBatch.riskFreeRate.data(),
+                               floatBatch.volatility.data(), floatBatch.optionType.data(), floatPrices.data(),
+                               floatErrors.data());
+    });
+    double mixedTime = time([&]() { blackScholesBatchPriceMixed(batch, mixedPrices, tolerance, &stats); });
+
+    // Accuracy against the double path. The float error includes the rounding of the inputs to float.
+    std::vector<double> floatErrorAll, floatErrorAccepted, mixedError;
+    size_t acceptedAboveTolerance = 0;
+    for (size_t i = 0; i < numOptions; ++i)
+    {
+        const double floatError = relativeDifference(floatPrices[i], doublePrices[i]);
+        floatErrorAll.push_back(floatError);
+        if (floatErrors[i] <= tolerance)
+        {
+            floatErrorAccepted.push_back(floatError);
+            if (floatError > tolerance)
+            {
+                ++acceptedAboveTolerance;
+            }
+        }
+        mixedError.push_back(relativeDifference(mixedPrices[i], doublePrices[i]));
+    }
+
+    cout << "Options: " << numOptions << ", tolerance " << tolerance << endl;
+    cout << fixed << setprecision(1);
+    cout << "double batch: " << setw(7) << numOptions / doubleTime / 1e6 << " M options/s" << endl;
+    cout << "float batch:  " << setw(7) << numOptions / floatTime / 1e6 << " M options/s" << endl;
+    cout << "mixed batch:  " << setw(7) << numOptions / mixedTime / 1e6 << " M options/s, "
+         << 100.0 * stats.reevaluated / stats.count << "% re-priced in double" << endl;
+
+    cout << scientific << setprecision(2);
+    cout << "float vs double, all options:       median " << percentile(floatErrorAll, 0.5) << ", p99 "
+         << percentile(floatErrorAll, 0.99) << ", max " << percentile(floatErrorAll, 1.0) << endl;
+    cout << "float vs double, estimate <= tol:   median " << percentile(floatErrorAccepted, 0.5) << ", p99 "
+         << percentile(floatErrorAccepted, 0.99) << ", max " << percentile(floatErrorAccepted, 1.0) << endl;
+    cout << "mixed vs double:                    median " << percentile(mixedError, 0.5) << ", p99 "
+         << percentile(mixedError, 0.99) << ", max " << percentile(mixedError, 1.0) << endl;
+    cout << "accepted float prices off by more than tol: " << acceptedAboveTolerance << endl;
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+#include <functional>
+
+#include "../include/cpuDispatch.h"
+#include "../include/batchPricing.h"
+#include "../include/pricingCore.h"
+#include "../include/normalCDFTable.h"
+
+using namespace std;
+
+// Polynomial vs table-driven N(x): accuracy, scalar and vectorized throughput, and the effect on the
+// Black-Scholes batch and the Heston Monte Carlo loop.
+static double secondsFor(int repetitions, const std::function<void()>& kernel)
+{
+    kernel();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+        kernel();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    return elapsed.count() / repetitions;
+}
+
+int main()
+{
+    const size_t count = 1 << 20;
+    const int repetitions = 20;
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> xDist(-6.0, 6.0);
+    std::vector<double> x(count), result(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        x[i] = xDist(generator);
+    }
+
+    // Accuracy against erfc on a fine grid, tails included.
+    double polynomialError = 0.0;
+    double tableError = 0.0;
+    for (double v = -10.0; v <= 10.0; v += 1e-4)
+    {
+        const double exact = 0.5 * std::erfc(-v / std::sqrt(2.0));
+        polynomialError = std::max(polynomialError, std::abs(normalCDF(v) - exact));
+        tableError = std::max(tableError, std::abs(normalCDFTabulated(v) - exact));
+    }
+    cout << scientific << setprecision(2);
+    cout << "Max absolute error: polynomial " << polynomialError << ", table " << tableError
+         << " (bound " << normalCDFTable::errorBound << ")" << endl;
+
+    // Scalar calls, as in the model classes and the Monte Carlo loop.
+    double sink = 0.0;
+    const double polynomialScalar = secondsFor(repetitions, [&]() {
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            sum += normalCDF(x[i]);
+        }
+        sink += sum;
+    });
+    const double tableScalar = secondsFor(repetitions, [&]() {
+        double sum = 0.0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            sum += normalCDFTabulated(x[i]);
+        }
+        sink += sum;
+    });
+
+    cout << fixed << setprecision(1);
+    cout << "Throughput in M elements/s" << endl;
+    cout << setw(8) << "scalar" << setw(14) << "polynomial" << setw(10) << "table" << endl;
+    cout << setw(8) << "" << setw(14) << count / polynomialScalar / 1e6 << setw(10) << count / tableScalar / 1e6 << endl;
+
+    // Vectorized arrays and Black-Scholes batches at every level.
+    optionBatch batch;
+    batch.resize(count);
+    std::uniform_real_distribution<double> spotDist(50.0, 150.0);
+    std::uniform_real_distribution<double> moneynessDist(0.7, 1.3);
+    std::uniform_real_distribution<double> timeDist(0.05, 2.0);
+    std::uniform_real_distribution<double> volDist(0.1, 0.6);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch.underlyingPrice[i] = spotDist(generator);
+        batch.strikePrice[i] = batch.underlyingPrice[i] * moneynessDist(generator);
+        batch.timeToExperation[i] = timeDist(generator);
+        batch.riskFreeRate[i] = 0.03;
+        batch.volatility[i] = volDist(generator);
+        batch.optionType[i] = (i % 2 == 0) ? CALL : PUT;
+    }
+
+    cout << setw(8) << "level" << setw(14) << "polynomial" << setw(10) << "table" << setw(16) << "BS polynomial"
+         << setw(12) << "BS table" << endl;
+    for (SimdLevel level : {SCALAR, SSE42, AVX2, AVX512})
+    {
+        const simdKernelTable* kernels = simdKernelsFor(level);
+        if (kernels == nullptr)
+        {
+            cout << setw(8) << simdLevelName(level) << "  not supported" << endl;
+            continue;
+        }
+
+        const double polynomial = secondsFor(repetitions, [&]() { kernels->normalCDF(x.data(), result.data(), count); });
+        const double table = secondsFor(repetitions, [&]() { kernels->normalCDFTabulated(x.data(), result.data(), count); });
+        const double pricePolynomial = secondsFor(repetitions, [&]() {
+            kernels->blackScholesPrice(count, batch.underlyingPrice.data(), batch.strikePrice.data(),
+                                       batch.timeToExperation.data(), batch.riskFreeRate.data(),
+                                       batch.volatility.data(), batch.optionType.data(), result.data());
+        });
+        const double priceTable = secondsFor(repetitions, [&]() {
+            kernels->blackScholesPriceTabulated(count, batch.underlyingPrice.data(), batch.strikePrice.data(),
+                                                batch.timeToExperation.data(), batch.riskFreeRate.data(),
+                                                batch.volatility.data(), batch.optionType.data(), result.data());
+        });
+
+        cout << setw(8) << simdLevelName(level) << setw(14) << count / polynomial / 1e6 << setw(10)
+             << count / table / 1e6 << setw(16) << count / pricePolynomial / 1e6 << setw(12)
+             << count / priceTable / 1e6 << endl;
+    }
+
+    // The Heston Monte Carlo loop: two N(x) per path, same random paths for both methods.
+    const hestonParameters params = {0.04, 2.0, 0.04, 0.3, -0.7};
+    const int numSimulations = 200000;
+    const int numTimeSteps = 10;
+    for (NormalCDFMethod method : {CDF_POLYNOMIAL, CDF_TABLE})
+    {
+        double price = 0.0;
+        const double seconds = secondsFor(3, [&]() {
+            std::mt19937 pathGenerator(7);
+            price = hestonMonteCarloPrice(100.0, 100.0, 1.0, 0.03, params, CALL, numSimulations, numTimeSteps,
+                                          pathGenerator, method);
+        });
+        cout << "Heston MC, " << (method == CDF_TABLE ? "table:      " : "polynomial: ") << setprecision(1)
+             << numSimulations / seconds / 1e6 << " M paths/s, price " << setprecision(10) << price << endl;
+    }
+
+    return sink == 0.0 ? 1 : 0;
+}
@@ -0,0 +1,87 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <random>
+#include <vector>
+#include <functional>
+
+#include "../include/cpuDispatch.h"
+#include "../include/batchPricing.h"
+
+using namespace std;
+
+// Throughput of every dispatched kernel at every level this CPU supports.
+static double millionsPerSecond(size_t count, int repetitions, const std::function<void()>& kernel)
+{
+    kernel();
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+        kernel();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    return count * static_cast<double>(repetitions) / elapsed.count() / 1e6;
+}
+
+int main()
+{
+    const size_t count = 1 << 20;
+    const int repetitions = 20;
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> xDist(-6.0, 6.0);
+    std::uniform_real_distribution<double> positiveDist(1e-3, 1e3);
+
+    std::vector<double> x(count), positive(count), result(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        x[i] = xDist(generator);
+        positive[i] = positiveDist(generator);
+    }
+
+    optionBatch batch;
+    batch.resize(count);
+    std::uniform_real_distribution<double> spotDist(50.0, 150.0);
+    std::uniform_real_distribution<double> moneynessDist(0.7, 1.3);
+    std::uniform_real_distribution<double> timeDist(0.05, 2.0);
+    std::uniform_real_distribution<double> volDist(0.1, 0.6);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch.underlyingPrice[i] = spotDist(generator);
+        batch.strikePrice[i] = batch.underlyingPrice[i] * moneynessDist(generator);
+        batch.timeToExperation[i] = timeDist(generator);
+        batch.riskFreeRate[i] = 0.03;
+        batch.volatility[i] = volDist(generator);
+        batch.optionType[i] = (i % 2 == 0) ? CALL : PUT;
+    }
+
+    cout << "Detected level: " << simdLevelName(detectSimdLevel()) << endl;
+    cout << "Throughput in M elements/s" << endl;
+    cout << setw(8) << "level" << setw(12) << "normalCDF" << setw(12) << "exp" << setw(12) << "log"
+         << setw(14) << "blackScholes" << endl;
+
+    for (SimdLevel level : {SCALAR, SSE42, AVX2, AVX512})
+    {
+        const simdKernelTable* kernels = simdKernelsFor(level);
+        if (kernels == nullptr)
+        {
+            cout << setw(8) << simdLevelName(level) << "  not supported" << endl;
+            continue;
+        }
+
+        double cdf = millionsPerSecond(count, repetitions, [&]() { kernels->normalCDF(x.data(), result.data(), count); });
+        double expRate = millionsPerSecond(count, repetitions, [&]() { kernels->exp(x.data(), result.data(), count); });
+        double logRate = millionsPerSecond(count, repetitions, [&]() { kernels->log(positive.data(), result.data(), count); });
+        double price = millionsPerSecond(count, repetitions, [&]() {
+            kernels->blackScholesPrice(count, batch.underlyingPrice.data(), batch.strikePrice.data(),
+                                       batch.timeToExperation.data(), batch.riskFreeRate.data(),
+                                       batch.volatility.data(), batch.optionType.data(), result.data());
+        });
+
+        cout << fixed << setprecision(1) << setw(8) << simdLevelName(level) << setw(12) << cdf << setw(12) << expRate
+             << setw(12) << logRate << setw(14) << price << endl;
+    }
+
+    return 0;
+}
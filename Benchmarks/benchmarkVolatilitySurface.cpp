@@ -0,0 +1,118 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../include/batchPricing.h"
+#include "../include/volatilitySurface.h"
+
+using namespace std;
+
+// SVI surface: cold fit of every slice, refit after one slice moves, and evaluation cost per volatility,
+// alone and inside batch pricing.
+template <class Work>
+static double secondsOf(int repetitions, Work&& work)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int rep = 0; rep < repetitions; ++rep)
+    {
+        work();
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double> elapsed = end - start;
+    return elapsed.count() / repetitions;
+}
+
+int main()
+{
+    const size_t expiries = 24, strikes = 41;
+    std::mt19937 generator(42);
+    std::normal_distribution<double> noise(0.0, 0.002);
+
+    std::vector<std::vector<double>> logMoneyness(expiries), volatility(expiries);
+    std::vector<double> expiry(expiries);
+    for (size_t e = 0; e < expiries; ++e)
+    {
+        expiry[e] = 0.02 + 0.125 * e;
+        sviParameters smile;
+        smile.a = 0.03 * expiry[e];
+        smile.b = 0.1;
+        smile.rho = -0.5;
+        smile.m = 0.02;
+        smile.sigma = 0.2;
+        for (size_t k = 0; k < strikes; ++k)
+        {
+            const double x = -0.6 + 1.2 * k / (strikes - 1);
+            logMoneyness[e].push_back(x);
+            volatility[e].push_back(std::sqrt(smile.totalVariance(x) / expiry[e]) + noise(generator));
+        }
+    }
+
+    volatilitySurface surface(100.0, 0.03);
+    const double coldFit = secondsOf(1, [&]() {
+        for (size_t e = 0; e < expiries; ++e)
+        {
+            surface.setSliceQuotes(expiry[e], logMoneyness[e], volatility[e]);
+        }
+        surface.refit();
+    });
+    double worstError = 0.0;
+    for (const volatilitySlice& slice : surface.slices())
+    {
+        worstError = std::max(worstError, slice.rootMeanSquareError);
+    }
+
+    const int refits = 200;
+    const double oneSlice = secondsOf(refits, [&]() {
+        for (double& v : volatility[7])
+        {
+            v *= 1.0 + noise(generator);
+        }
+        surface.setSliceQuotes(expiry[7], logMoneyness[7], volatility[7]);
+        surface.refit();
+    });
+
+    cout << "Slices: " << expiries << " x " << strikes << " quotes" << endl;
+    cout << "Cold fit of every slice: " << fixed << setprecision(1) << coldFit * 1e3 << " ms (worst vol RMSE "
+         << scientific << setprecision(2) << worstError << ")" << endl;
+    cout << "Refit after one slice moved: " << fixed << setprecision(1) << oneSlice * 1e6 << " us" << endl;
+
+    const size_t count = 1 << 20;
+    std::uniform_real_distribution<double> strikeDist(60.0, 160.0), timeDist(0.01, 3.0);
+    optionBatch batch;
+    batch.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch.underlyingPrice[i] = 100.0;
+        batch.strikePrice[i] = strikeDist(generator);
+        batch.timeToExperation[i] = timeDist(generator);
+        batch.riskFreeRate[i] = 0.03;
+        batch.optionType[i] = i % 2 == 0 ? CALL : PUT;
+    }
+    std::vector<double> vols(count), prices;
+
+    const int repetitions = 10;
+    double sink = 0.0;
+    const double single = secondsOf(repetitions, [&]() {
+        for (size_t i = 0; i < count; ++i)
+        {
+            sink += surface.volatility(batch.strikePrice[i], batch.timeToExperation[i]);
+        }
+    });
+    const double many = secondsOf(repetitions, [&]() {
+        surface.volatilityBatch(count, batch.underlyingPrice.data(), batch.strikePrice.data(),
+                                batch.timeToExperation.data(), batch.riskFreeRate.data(), vols.data());
+    });
+    batch.volatility = vols;
+    const double flat = secondsOf(repetitions, [&]() { blackScholesBatchPrice(batch, prices); });
+    const double fromSurface = secondsOf(repetitions, [&]() { blackScholesBatchPrice(batch, surface, prices); });
+
+    cout << "volatility(K, T): " << fixed << setprecision(2) << single / count * 1e9 << " ns, volatilityBatch: "
+         << many / count * 1e9 << " ns per option" << (std::isnan(sink) ? " " : "") << endl;
+    cout << "Batch pricing with given vols: " << flat / count * 1e9 << " ns, with surface vols: "
+         << fromSurface / count * 1e9 << " ns per option" << endl;
+
+    return 0;
+}
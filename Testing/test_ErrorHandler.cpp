@@ -0,0 +1,146 @@
+#include "gtest/gtest.h"
+#include "../include/ErrorHandler.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    /// @brief a prefix no earlier run has written, since error.log is appended to across runs.
+    std::string uniqueTag(const std::string& name)
+    {
+        return "ErrorHandlerTest." + name + " "
+               + std::to_string(std::chrono::system_clock::now().time_since_epoch().count());
+    }
+
+    /// @brief the lines of error.log that start with prefix.
+    std::vector<std::string> linesStartingWith(const std::string& prefix)
+    {
+        std::vector<std::string> lines;
+        std::ifstream errorLog("error.log");
+        std::string line;
+        while (std::getline(errorLog, line))
+        {
+            if (line.rfind(prefix, 0) == 0)
+            {
+                lines.push_back(line);
+            }
+        }
+        return lines;
+    }
+}
+
+TEST(ErrorHandlerTest, FlushWritesQueuedMessages)
+{
+    const std::string tag = uniqueTag("Flush");
+    ErrorHandler::logError(tag + " first");
+    ErrorHandler::logError(tag + " second");
+    ErrorHandler::flush();
+
+    std::vector<std::string> lines = linesStartingWith(tag);
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0], tag + " first");
+    EXPECT_EQ(lines[1], tag + " second");
+}
+
+TEST(ErrorHandlerTest, ConcurrentMessagesAreWholeLines)
+{
+    const std::string tag = uniqueTag("Concurrent");
+    const int numThreads = 4;
+    const int perThread = 200;
+    ErrorHandler::setRateLimit(ErrorHandler::noLimit, 1);
+    const std::uint64_t writtenBefore = ErrorHandler::writtenCount();
+    const std::uint64_t droppedBefore = ErrorHandler::droppedCount();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < perThread; ++i)
+            {
+                ErrorHandler::logError(tag + " thread " + std::to_string(t) + " message " + std::to_string(i));
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    ErrorHandler::flush();
+
+    const std::uint64_t written = ErrorHandler::writtenCount() - writtenBefore;
+    const std::uint64_t dropped = ErrorHandler::droppedCount() - droppedBefore;
+    EXPECT_EQ(written + dropped, static_cast<std::uint64_t>(numThreads * perThread));
+
+    std::vector<std::string> lines = linesStartingWith(tag);
+    EXPECT_EQ(lines.size(), written);
+    for (const std::string& line : lines)
+    {
+        EXPECT_NE(line.find(" message "), std::string::npos) << line;
+        EXPECT_EQ(line.find(tag, 1), std::string::npos) << line;
+    }
+    ErrorHandler::setRateLimit(100, 10000);
+}
+
+TEST(ErrorHandlerTest, LongMessagesAreTruncated)
+{
+    const std::string tag = uniqueTag("Truncated");
+    ErrorHandler::logError(tag + std::string(2 * ErrorHandler::messageSize, 'x'));
+    ErrorHandler::flush();
+
+    std::vector<std::string> lines = linesStartingWith(tag);
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0].size(), ErrorHandler::messageSize - 1);
+}
+
+TEST(ErrorHandlerTest, RateLimitLogsBurstThenEveryNth)
+{
+    const std::string tag = uniqueTag("RateLimit");
+    ErrorHandler::setRateLimit(3, 5);
+    for (int i = 1; i <= 20; ++i)
+    {
+        ErrorHandler::logError(tag + " message " + std::to_string(i));
+    }
+    ErrorHandler::flush();
+    ErrorHandler::setRateLimit(100, 10000);
+
+    // Messages 1-3, then 8, 13 and 18.
+    std::vector<std::string> lines = linesStartingWith(tag);
+    ASSERT_EQ(lines.size(), 6u);
+    EXPECT_EQ(lines[2], tag + " message 3");
+    EXPECT_EQ(lines[3], tag + " message 8 [4 similar messages suppressed]");
+    EXPECT_EQ(lines[5], tag + " message 18 [4 similar messages suppressed]");
+}
+
+TEST(ErrorHandlerTest, SiteSummaryMergesThreads)
+{
+    const std::string tag = uniqueTag("Summary");
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t)
+    {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 10; ++i)
+            {
+                ErrorHandler::logError(tag + " message " + std::to_string(i));
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::vector<ErrorHandler::errorSite> sites = ErrorHandler::siteSummary();
+    auto site = std::find_if(sites.begin(), sites.end(), [&](const ErrorHandler::errorSite& candidate) {
+        return candidate.firstMessage.rfind(tag, 0) == 0;
+    });
+    ASSERT_NE(site, sites.end());
+    EXPECT_EQ(site->count, 30u);
+    EXPECT_EQ(site->logged, 30u);
+    EXPECT_NE(site->file.find("test_ErrorHandler.cpp"), std::string::npos);
+    EXPECT_EQ(site->firstMessage, tag + " message 0");
+    EXPECT_EQ(site->lastMessage, tag + " message 9");
+}
@@ -0,0 +1,460 @@
+#include "gtest/gtest.h"
+#include "../include/batchPricing.h"
+#include "../include/blackScholesModel.h"
+#include "../include/pricingCore.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+class batchPricingTest : public testing::Test
+{
+    protected:
+        batchPricingTest()
+        {
+            batch.resize(4);
+            batch.underlyingPrice = {16.2, 5.6, 100.0, 50.0};
+            batch.strikePrice = {13.3, 4.2, 100.0, 45.0};
+            batch.timeToExperation = {18.0, 45.3, 1.0, 0.0822};
+            batch.riskFreeRate = {6.2, 3.14, 0.05, 0.05};
+            batch.volatility = {0.45, 0.27, 0.2, 0.2};
+            batch.optionType = {PUT, CALL, PUT, CALL};
+        }
+
+        optionBatch batch;
+};
+
+TEST_F(batchPricingTest, MatchesPerObjectPrices)
+{
+    std::vector<double> prices;
+    blackScholesBatchPrice(batch, prices);
+
+    ASSERT_EQ(prices.size(), batch.size());
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        blackScholesModel model(batch.underlyingPrice[i], batch.strikePrice[i], batch.timeToExperation[i],
+                                batch.riskFreeRate[i], batch.volatility[i], batch.optionType[i]);
+        EXPECT_NEAR(prices[i], model.calculateOptionPrice(), 1e-12);
+    }
+}
+
+TEST_F(batchPricingTest, PointerOverloadMatchesBatchOverload)
+{
+    std::vector<double> expected;
+    blackScholesBatchPrice(batch, expected);
+
+    std::vector<double> prices(batch.size());
+    blackScholesBatchPrice(batch.size(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                           batch.timeToExperation.data(), batch.riskFreeRate.data(), batch.volatility.data(),
+                           batch.optionType.data(), prices.data());
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        EXPECT_DOUBLE_EQ(prices[i], expected[i]);
+    }
+}
+
+TEST_F(batchPricingTest, InvalidInputsPriceAsNaN)
+{
+    batch.volatility[0] = -0.45;
+    batch.timeToExperation[1] = -1.0;
+    batch.underlyingPrice[2] = NAN;
+
+    std::vector<double> prices;
+    blackScholesBatchPrice(batch, prices);
+
+    EXPECT_TRUE(isnan(prices[0]));
+    EXPECT_TRUE(isnan(prices[1]));
+    EXPECT_TRUE(isnan(prices[2]));
+    EXPECT_FALSE(isnan(prices[3]));
+}
+
+TEST_F(batchPricingTest, UnknownOptionTypePricesAsNaN)
+{
+    // As pricingCore's blackScholesPrice, alone and in a run long enough for the typed kernels.
+    batch.optionType[3] = static_cast<OptionType>(7);
+    std::vector<double> prices;
+    blackScholesBatchPrice(batch, prices);
+    EXPECT_TRUE(isnan(prices[3]));
+    EXPECT_FALSE(isnan(prices[2]));
+
+    greeksBatch greeks;
+    blackScholesBatchGreeks(batch, greeks);
+    EXPECT_TRUE(isnan(greeks.price[3]));
+    EXPECT_TRUE(isnan(greeks.gamma[3]));
+    EXPECT_FALSE(isnan(greeks.gamma[2]));
+
+    optionBatch run;
+    run.resize(100);
+    std::fill(run.underlyingPrice.begin(), run.underlyingPrice.end(), 100.0);
+    std::fill(run.strikePrice.begin(), run.strikePrice.end(), 100.0);
+    std::fill(run.timeToExperation.begin(), run.timeToExperation.end(), 1.0);
+    std::fill(run.riskFreeRate.begin(), run.riskFreeRate.end(), 0.05);
+    std::fill(run.volatility.begin(), run.volatility.end(), 0.2);
+    std::fill(run.optionType.begin(), run.optionType.end(), static_cast<OptionType>(7));
+    blackScholesBatchPrice(run, prices);
+    for (double price : prices)
+    {
+        EXPECT_TRUE(isnan(price));
+    }
+}
+
+TEST_F(batchPricingTest, EmptyBatch)
+{
+    optionBatch empty;
+    std::vector<double> prices = {1.0};
+    blackScholesBatchPrice(empty, prices);
+    EXPECT_TRUE(prices.empty());
+}
+
+TEST_F(batchPricingTest, GreeksMatchFusedScalarKernel)
+{
+    greeksBatch greeks;
+    blackScholesBatchGreeks(batch, greeks);
+
+    std::vector<double> prices;
+    blackScholesBatchPrice(batch, prices);
+
+    ASSERT_EQ(greeks.size(), batch.size());
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        blackScholesGreeks expected = blackScholesPriceAndGreeks(batch.underlyingPrice[i], batch.strikePrice[i],
+                                                                 batch.timeToExperation[i], batch.riskFreeRate[i],
+                                                                 batch.volatility[i], batch.optionType[i]);
+        EXPECT_NEAR(greeks.price[i], prices[i], 1e-12);
+        EXPECT_NEAR(greeks.delta[i], expected.delta, 1e-12);
+        EXPECT_NEAR(greeks.gamma[i], expected.gamma, 1e-12);
+        EXPECT_NEAR(greeks.vega[i], expected.vega, 1e-12);
+        EXPECT_NEAR(greeks.theta[i], expected.theta, 1e-12);
+        EXPECT_NEAR(greeks.rho[i], expected.rho, 1e-12);
+    }
+}
+
+TEST_F(batchPricingTest, GreeksOfInvalidOptionsAreNaN)
+{
+    batch.volatility[0] = 1.5;
+
+    greeksBatch greeks;
+    blackScholesBatchGreeks(batch, greeks);
+
+    EXPECT_TRUE(isnan(greeks.price[0]));
+    EXPECT_TRUE(isnan(greeks.delta[0]));
+    EXPECT_TRUE(isnan(greeks.rho[0]));
+    EXPECT_FALSE(isnan(greeks.delta[1]));
+}
+
+TEST_F(batchPricingTest, SelectedGreeksMatchFusedGreeks)
+{
+    greeksBatch all;
+    blackScholesBatchGreeks(batch, all);
+
+    selectedGreeksBatch selected;
+    blackScholesBatchGreeks(batch, GREEK_ALL | GREEK_ADJUSTED_ALL, selected);
+
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        const double S = batch.underlyingPrice[i];
+        const double T = batch.timeToExperation[i];
+        const double discountedStrike = batch.strikePrice[i] * std::exp(-batch.riskFreeRate[i] * T);
+        const double delta = all.delta[i], gamma = all.gamma[i], vega = all.vega[i], theta = all.theta[i];
+
+        EXPECT_NEAR(selected[GREEK_PRICE][i], all.price[i], 1e-12);
+        EXPECT_NEAR(selected[GREEK_DELTA][i], delta, 1e-12);
+        EXPECT_NEAR(selected[GREEK_GAMMA][i], gamma, 1e-12);
+        EXPECT_NEAR(selected[GREEK_VEGA][i], vega, 1e-12);
+        EXPECT_NEAR(selected[GREEK_THETA][i], theta, 1e-12);
+        EXPECT_NEAR(selected[GREEK_RHO][i], all.rho[i], 1e-12);
+
+        EXPECT_NEAR(selected[GREEK_IV_ADJUSTED_DELTA][i], delta, 1e-12);
+        EXPECT_NEAR(selected[GREEK_GAMMA_ADJUSTED_DELTA][i], delta + 0.5 * gamma, 1e-12);
+        EXPECT_NEAR(selected[GREEK_VEGA_ADJUSTED_DELTA][i], delta + vega, 1e-12);
+        EXPECT_NEAR(selected[GREEK_THETA_ADJUSTED_DELTA][i], delta - theta, 1e-12);
+        EXPECT_NEAR(selected[GREEK_GAMMA_VEGA_ADJUSTED_DELTA][i], delta + 0.5 * gamma + vega, 1e-12);
+        EXPECT_NEAR(selected[GREEK_PRICE_GAMMA][i], (delta + 0.5 * gamma) * S - discountedStrike, 1e-10);
+        EXPECT_NEAR(selected[GREEK_PRICE_VEGA][i], delta * S - vega * (delta + vega) + 0.5 * vega * vega, 1e-10);
+        EXPECT_NEAR(selected[GREEK_PRICE_THETA][i], delta * S - theta * T + (delta - theta) - discountedStrike, 1e-10);
+        EXPECT_NEAR(selected[GREEK_PRICE_GAMMA_VEGA][i],
+                    (delta + 0.5 * gamma) * S + 0.5 * gamma * S * S
+                        - vega * S * std::sqrt(T) * std::exp(-batch.riskFreeRate[i] * T) / 100.0, 1e-10);
+    }
+
+    // For a call, optionPriceIV = ivAdjustedDelta S N(d1) - K e^{-rT} N(d2) with N(d1) = delta.
+    const double callDelta = all.delta[3];
+    const double discountedStrike = batch.strikePrice[3] * std::exp(-batch.riskFreeRate[3] * batch.timeToExperation[3]);
+    const double Nd2 = (callDelta * batch.underlyingPrice[3] - all.price[3]) / discountedStrike;
+    EXPECT_NEAR(selected[GREEK_PRICE_IV][3], callDelta * batch.underlyingPrice[3] * callDelta - discountedStrike * Nd2,
+                1e-10);
+}
+
+TEST_F(batchPricingTest, SelectedGreeksWriteOnlySelectedColumns)
+{
+    selectedGreeksBatch selected;
+    blackScholesBatchGreeks(batch, GREEK_DELTA | GREEK_PRICE_GAMMA, selected);
+    EXPECT_EQ(selected.greeks, GREEK_DELTA | GREEK_PRICE_GAMMA);
+    for (unsigned b = 0; b < GREEK_COUNT; ++b)
+    {
+        const bool isSelected = b == greekIndex(GREEK_DELTA) || b == greekIndex(GREEK_PRICE_GAMMA);
+        EXPECT_EQ(selected.columns[b].size(), isSelected ? batch.size() : 0u) << b;
+    }
+
+    greeksBatch all;
+    blackScholesBatchGreeks(batch, all);
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        EXPECT_NEAR(selected[GREEK_DELTA][i], all.delta[i], 1e-12);
+    }
+
+    // Columns of unselected results are neither read nor written.
+    std::array<double*, GREEK_COUNT> output{};
+    std::vector<double> gamma(batch.size(), -1.0);
+    output[greekIndex(GREEK_GAMMA)] = gamma.data();
+    blackScholesBatchGreeks(batch.size(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                            batch.timeToExperation.data(), batch.riskFreeRate.data(), batch.volatility.data(),
+                            batch.optionType.data(), GREEK_GAMMA, output.data());
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        EXPECT_NEAR(gamma[i], all.gamma[i], 1e-12);
+    }
+    blackScholesBatchGreeks(batch.size(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                            batch.timeToExperation.data(), batch.riskFreeRate.data(), batch.volatility.data(),
+                            batch.optionType.data(), 0u, output.data());
+}
+
+TEST_F(batchPricingTest, SelectedGreeksOfInvalidOptionsAreNaN)
+{
+    batch.volatility[0] = 1.5;
+
+    selectedGreeksBatch selected;
+    blackScholesBatchGreeks(batch, GREEK_VEGA | GREEK_THETA_ADJUSTED_DELTA | GREEK_PRICE_IV, selected);
+
+    EXPECT_TRUE(std::isnan(selected[GREEK_VEGA][0]));
+    EXPECT_TRUE(std::isnan(selected[GREEK_THETA_ADJUSTED_DELTA][0]));
+    EXPECT_TRUE(std::isnan(selected[GREEK_PRICE_IV][0]));
+    EXPECT_FALSE(std::isnan(selected[GREEK_PRICE_IV][1]));
+}
+
+TEST(batchPricingPartitionTest, LongTypeRunsMatchScalarCore)
+{
+    // 100 calls, 100 puts, then alternating types: both the typed and the mixed kernels are used.
+    optionBatch batch;
+    const size_t count = 300;
+    batch.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch.underlyingPrice[i] = 80.0 + 0.15 * i;
+        batch.strikePrice[i] = 100.0;
+        batch.timeToExperation[i] = 0.25 + 0.005 * i;
+        batch.riskFreeRate[i] = 0.03;
+        batch.volatility[i] = 0.2 + 0.001 * i;
+        batch.optionType[i] = i < 100 ? CALL : (i < 200 ? PUT : (i % 2 == 0 ? CALL : PUT));
+    }
+
+    std::vector<double> prices;
+    blackScholesBatchPrice(batch, prices);
+    greeksBatch greeks;
+    blackScholesBatchGreeks(batch, greeks);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        blackScholesGreeks expected = blackScholesPriceAndGreeks(batch.underlyingPrice[i], batch.strikePrice[i],
+                                                                 batch.timeToExperation[i], batch.riskFreeRate[i],
+                                                                 batch.volatility[i], batch.optionType[i]);
+        EXPECT_NEAR(prices[i], expected.price, 1e-11) << i;
+        EXPECT_NEAR(greeks.price[i], expected.price, 1e-11) << i;
+        EXPECT_NEAR(greeks.delta[i], expected.delta, 1e-12) << i;
+        EXPECT_NEAR(greeks.theta[i], expected.theta, 1e-11) << i;
+    }
+}
+
+TEST(batchPricingPartitionTest, PartitionByOptionTypeIsStable)
+{
+    optionBatch batch;
+    batch.resize(5);
+    batch.underlyingPrice = {1.0, 2.0, 3.0, 4.0, 5.0};
+    batch.optionType = {PUT, CALL, PUT, CALL, CALL};
+
+    std::vector<size_t> originalIndex;
+    size_t calls = partitionByOptionType(batch, originalIndex);
+
+    EXPECT_EQ(calls, 3u);
+    EXPECT_EQ(originalIndex, (std::vector<size_t>{1, 3, 4, 0, 2}));
+    EXPECT_EQ(batch.underlyingPrice, (std::vector<double>{2.0, 4.0, 5.0, 1.0, 3.0}));
+    EXPECT_EQ(batch.optionType, (std::vector<OptionType>{CALL, CALL, CALL, PUT, PUT}));
+}
+
+TEST(batchPricingMixedPrecisionTest, FloatBatchMatchesDoubleForWellConditionedOptions)
+{
+    optionBatch batch;
+    optionBatchFloat floatBatch;
+    const size_t count = 101;
+    batch.resize(count);
+    floatBatch.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        // Exactly representable in float, so only the kernels differ.
+        batch.underlyingPrice[i] = floatBatch.underlyingPrice[i] = 90.0f + 0.25f * i;
+        batch.strikePrice[i] = floatBatch.strikePrice[i] = 100.0f;
+        batch.timeToExperation[i] = floatBatch.timeToExperation[i] = 0.5f + 0.015625f * i;
+        batch.riskFreeRate[i] = floatBatch.riskFreeRate[i] = 0.03125f;
+        batch.volatility[i] = floatBatch.volatility[i] = 0.25f;
+        batch.optionType[i] = floatBatch.optionType[i] = i % 3 == 0 ? PUT : CALL;
+    }
+
+    std::vector<double> expected;
+    blackScholesBatchPrice(batch, expected);
+    std::vector<float> prices;
+    blackScholesBatchPrice(floatBatch, prices);
+    std::vector<float> pointerPrices(count), relativeError(count);
+    blackScholesBatchPrice(count, floatBatch.underlyingPrice.data(), floatBatch.strikePrice.data(),
+                           floatBatch.timeToExperation.data(), floatBatch.riskFreeRate.data(),
+                           floatBatch.volatility.data(), floatBatch.optionType.data(), pointerPrices.data(),
+                           relativeError.data());
+
+    ASSERT_EQ(prices.size(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const double error = std::abs(prices[i] - expected[i]) / expected[i];
+        EXPECT_LT(error, 1e-5) << i;
+        EXPECT_LE(error, relativeError[i]) << i;
+        EXPECT_EQ(pointerPrices[i], prices[i]) << i;
+    }
+}
+
+TEST(batchPricingMixedPrecisionTest, MixedBatchIsWithinTolerance)
+{
+    // Moneyness from 0.5 to 2 and expiries down to a day: many options need the double path.
+    optionBatch batch;
+    const size_t count = 5000;
+    batch.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch.underlyingPrice[i] = 100.0;
+        batch.strikePrice[i] = 50.0 * std::pow(4.0, (i % 97) / 96.0);
+        batch.timeToExperation[i] = 1.0 / 365.0 + (i % 53) / 26.0;
+        batch.riskFreeRate[i] = 0.01 * (i % 7);
+        batch.volatility[i] = 0.05 + 0.9 * (i % 31) / 30.0;
+        batch.optionType[i] = i % 2 == 0 ? CALL : PUT;
+    }
+    batch.volatility[10] = 1.5;
+
+    const double tolerance = 1e-5;
+    std::vector<double> expected, prices;
+    blackScholesBatchPrice(batch, expected);
+    mixedPrecisionStats stats;
+    blackScholesBatchPriceMixed(batch, prices, tolerance, &stats);
+
+    ASSERT_EQ(prices.size(), count);
+    EXPECT_EQ(stats.count, count);
+    EXPECT_GT(stats.reevaluated, 0u);
+    EXPECT_LT(stats.reevaluated, count);
+    EXPECT_TRUE(isnan(prices[10]));
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i != 10)
+        {
+            EXPECT_LE(std::abs(prices[i] - expected[i]), tolerance * std::abs(expected[i])) << i;
+        }
+    }
+}
+
+TEST(batchPricingMixedPrecisionTest, InvalidFloatInputsPriceAsNaN)
+{
+    optionBatchFloat batch;
+    batch.resize(3);
+    batch.underlyingPrice = {100.0f, 100.0f, 100.0f};
+    batch.strikePrice = {100.0f, 100.0f, 100.0f};
+    batch.timeToExperation = {1.0f, -1.0f, 1.0f};
+    batch.riskFreeRate = {0.05f, 0.05f, 0.05f};
+    batch.volatility = {1.5f, 0.2f, 0.2f};
+    batch.optionType = {CALL, PUT, CALL};
+
+    std::vector<float> prices;
+    blackScholesBatchPrice(batch, prices);
+
+    EXPECT_TRUE(std::isnan(prices[0]));
+    EXPECT_TRUE(std::isnan(prices[1]));
+    EXPECT_FALSE(std::isnan(prices[2]));
+}
+
+TEST_F(batchPricingTest, StatusOfValidBatchIsClean)
+{
+    static_assert(optionInputStatus(100.0, 100.0, 1.0, 0.05, 0.2, CALL) == OPTION_VALID);
+
+    std::vector<double> expected, prices;
+    blackScholesBatchPrice(batch, expected);
+    batchStatus status;
+    blackScholesBatchPrice(batch, prices, status);
+
+    ASSERT_EQ(status.size(), batch.size());
+    EXPECT_EQ(status.invalidCount, 0u);
+    EXPECT_EQ(status.fields, OPTION_VALID);
+    EXPECT_EQ(describeBatchStatus(status), "");
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        EXPECT_EQ(status.status[i], OPTION_VALID);
+        EXPECT_DOUBLE_EQ(prices[i], expected[i]);
+    }
+}
+
+TEST_F(batchPricingTest, StatusMarksEachInvalidField)
+{
+    batch.underlyingPrice[0] = 0.0;
+    batch.volatility[0] = NAN;
+    batch.timeToExperation[1] = -1.0;
+    batch.riskFreeRate[2] = NAN;
+
+    std::vector<double> prices;
+    batchStatus status;
+    blackScholesBatchPrice(batch, prices, status);
+
+    EXPECT_EQ(status.invalidCount, 3u);
+    EXPECT_EQ(status.status[0], INVALID_UNDERLYING_PRICE | INVALID_VOLATILITY);
+    EXPECT_EQ(status.status[1], INVALID_TIME_TO_EXPERATION);
+    EXPECT_EQ(status.status[2], INVALID_RISK_FREE_RATE);
+    EXPECT_EQ(status.status[3], OPTION_VALID);
+    EXPECT_EQ(status.fields, INVALID_UNDERLYING_PRICE | INVALID_VOLATILITY | INVALID_TIME_TO_EXPERATION
+                             | INVALID_RISK_FREE_RATE);
+    EXPECT_TRUE(std::isnan(prices[0]));
+    EXPECT_TRUE(std::isnan(prices[1]));
+    EXPECT_TRUE(std::isnan(prices[2]));
+    EXPECT_FALSE(std::isnan(prices[3]));
+}
+
+TEST_F(batchPricingTest, StatusOverloadOfGreeksMarksEveryOutput)
+{
+    batch.strikePrice[3] = -45.0;
+
+    greeksBatch greeks;
+    batchStatus status;
+    blackScholesBatchGreeks(batch, greeks, status);
+
+    EXPECT_EQ(status.status[3], INVALID_STRIKE_PRICE);
+    EXPECT_TRUE(std::isnan(greeks.price[3]));
+    EXPECT_TRUE(std::isnan(greeks.gamma[3]));
+    EXPECT_TRUE(std::isnan(greeks.rho[3]));
+    EXPECT_FALSE(std::isnan(greeks.delta[2]));
+}
+
+TEST(batchPricingStatusTest, DescriptionSummarizesFieldsAndFirstIndices)
+{
+    optionBatch batch;
+    const size_t count = 100;
+    batch.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch.underlyingPrice[i] = 100.0;
+        batch.strikePrice[i] = 100.0;
+        batch.timeToExperation[i] = 1.0;
+        batch.riskFreeRate[i] = 0.03;
+        batch.volatility[i] = i % 10 == 0 ? 1.5 : 0.2;
+        batch.optionType[i] = CALL;
+    }
+    batch.timeToExperation[10] = NAN;
+
+    batchStatus status;
+    validateBatch(batch, status);
+
+    EXPECT_EQ(status.invalidCount, 10u);
+    EXPECT_EQ(describeBatchStatus(status, 3),
+              "10 of 100 options have invalid inputs (time to expiration: 1, volatility: 10), first at 0, 10, 20, ...");
+}
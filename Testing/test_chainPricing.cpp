@@ -0,0 +1,172 @@
+#include "gtest/gtest.h"
+#include "../include/chainPricing.h"
+#include "../include/batchPricing.h"
+#include "../include/pricingCore.h"
+#include <cmath>
+#include <vector>
+
+class chainPricingTest : public testing::Test
+{
+    protected:
+        chainPricingTest()
+        {
+            // 37 strikes: full vector blocks at every level plus a tail.
+            chain.underlyingPrice = 100.0;
+            chain.timeToExperation = 0.5;
+            chain.riskFreeRate = 0.04;
+            chain.resize(37);
+            for (size_t i = 0; i < chain.size(); ++i)
+            {
+                chain.strikePrice[i] = 70.0 + 1.7 * i;
+                chain.volatility[i] = 0.15 + 0.004 * i;
+                chain.optionType[i] = i % 3 == 0 ? PUT : CALL;
+            }
+        }
+
+        optionChain chain;
+};
+
+TEST_F(chainPricingTest, PricesMatchBatchPrices)
+{
+    optionBatch batch;
+    batch.resize(chain.size());
+    for (size_t i = 0; i < chain.size(); ++i)
+    {
+        batch.underlyingPrice[i] = chain.underlyingPrice;
+        batch.strikePrice[i] = chain.strikePrice[i];
+        batch.timeToExperation[i] = chain.timeToExperation;
+        batch.riskFreeRate[i] = chain.riskFreeRate;
+        batch.volatility[i] = chain.volatility[i];
+        batch.optionType[i] = chain.optionType[i];
+    }
+
+    std::vector<double> expected;
+    blackScholesBatchPrice(batch, expected);
+    std::vector<double> prices;
+    blackScholesChainPrice(chain, prices);
+
+    ASSERT_EQ(prices.size(), chain.size());
+    for (size_t i = 0; i < chain.size(); ++i)
+    {
+        EXPECT_NEAR(prices[i], expected[i], 1e-12 * std::max(1.0, expected[i])) << i;
+    }
+}
+
+TEST_F(chainPricingTest, GreeksMatchFusedScalarKernel)
+{
+    greeksBatch greeks;
+    blackScholesChainGreeks(chain, greeks);
+
+    ASSERT_EQ(greeks.size(), chain.size());
+    for (size_t i = 0; i < chain.size(); ++i)
+    {
+        blackScholesGreeks expected = blackScholesPriceAndGreeks(chain.underlyingPrice, chain.strikePrice[i],
+                                                                 chain.timeToExperation, chain.riskFreeRate,
+                                                                 chain.volatility[i], chain.optionType[i]);
+        EXPECT_NEAR(greeks.price[i], expected.price, 1e-11) << i;
+        EXPECT_NEAR(greeks.delta[i], expected.delta, 1e-12) << i;
+        EXPECT_NEAR(greeks.gamma[i], expected.gamma, 1e-12) << i;
+        EXPECT_NEAR(greeks.vega[i], expected.vega, 1e-11) << i;
+        EXPECT_NEAR(greeks.theta[i], expected.theta, 1e-11) << i;
+        EXPECT_NEAR(greeks.rho[i], expected.rho, 1e-11) << i;
+    }
+}
+
+TEST_F(chainPricingTest, InvalidOptionsAreNaN)
+{
+    chain.volatility[0] = -0.2;
+    chain.volatility[5] = NAN;
+
+    std::vector<double> prices;
+    blackScholesChainPrice(chain, prices);
+    greeksBatch greeks;
+    blackScholesChainGreeks(chain, greeks);
+
+    EXPECT_TRUE(std::isnan(prices[0]));
+    EXPECT_TRUE(std::isnan(prices[5]));
+    EXPECT_TRUE(std::isnan(greeks.delta[0]));
+    EXPECT_TRUE(std::isnan(greeks.rho[5]));
+    EXPECT_FALSE(std::isnan(prices[1]));
+    EXPECT_FALSE(std::isnan(greeks.gamma[1]));
+
+    chain.timeToExperation = -1.0;
+    blackScholesChainPrice(chain, prices);
+    for (double price : prices)
+    {
+        EXPECT_TRUE(std::isnan(price));
+    }
+}
+
+TEST_F(chainPricingTest, EmptyChain)
+{
+    optionChain empty;
+    std::vector<double> prices = {1.0};
+    blackScholesChainPrice(empty, prices);
+    EXPECT_TRUE(prices.empty());
+
+    greeksBatch greeks;
+    blackScholesChainGreeks(empty, greeks);
+    EXPECT_EQ(greeks.size(), 0u);
+}
+
+TEST(chainPricingGroupTest, GroupsByExpiryInFirstAppearanceOrder)
+{
+    // Test_Data.csv layout: rows of several expiries interleaved.
+    optionBatch batch;
+    batch.resize(6);
+    batch.underlyingPrice = {100.0, 100.0, 100.0, 100.0, 90.0, 100.0};
+    batch.strikePrice = {95.0, 95.0, 100.0, 105.0, 90.0, 110.0};
+    batch.timeToExperation = {0.5, 1.0, 0.5, 1.0, 0.5, 0.5};
+    batch.riskFreeRate = {0.03, 0.03, 0.03, 0.03, 0.03, 0.03};
+    batch.volatility = {0.2, 0.21, 0.22, 0.23, 0.24, 0.25};
+    batch.optionType = {CALL, PUT, CALL, PUT, CALL, PUT};
+
+    std::vector<size_t> originalIndex;
+    std::vector<optionChain> chains = groupIntoChains(batch, originalIndex);
+
+    ASSERT_EQ(chains.size(), 3u);
+    EXPECT_EQ(originalIndex, (std::vector<size_t>{0, 2, 5, 1, 3, 4}));
+    EXPECT_EQ(chains[0].timeToExperation, 0.5);
+    EXPECT_EQ(chains[0].strikePrice, (std::vector<double>{95.0, 100.0, 110.0}));
+    EXPECT_EQ(chains[0].optionType, (std::vector<OptionType>{CALL, CALL, PUT}));
+    EXPECT_EQ(chains[1].timeToExperation, 1.0);
+    EXPECT_EQ(chains[1].volatility, (std::vector<double>{0.21, 0.23}));
+    EXPECT_EQ(chains[2].underlyingPrice, 90.0);
+    EXPECT_EQ(chains[2].size(), 1u);
+}
+
+TEST(chainPricingGroupTest, ChainPricesMatchBatchAfterRegrouping)
+{
+    optionBatch batch;
+    const size_t count = 120;
+    batch.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch.underlyingPrice[i] = 100.0;
+        batch.strikePrice[i] = 80.0 + 0.35 * i;
+        batch.timeToExperation[i] = 0.25 * (1 + i % 4);
+        batch.riskFreeRate[i] = 0.03;
+        batch.volatility[i] = 0.18 + 0.001 * i;
+        batch.optionType[i] = i % 2 == 0 ? CALL : PUT;
+    }
+
+    std::vector<double> expected;
+    blackScholesBatchPrice(batch, expected);
+
+    std::vector<size_t> originalIndex;
+    std::vector<optionChain> chains = groupIntoChains(batch, originalIndex);
+    ASSERT_EQ(chains.size(), 4u);
+
+    size_t k = 0;
+    std::vector<double> prices;
+    for (const optionChain& chain : chains)
+    {
+        blackScholesChainPrice(chain, prices);
+        for (double price : prices)
+        {
+            const size_t i = originalIndex[k++];
+            EXPECT_NEAR(price, expected[i], 1e-12 * std::max(1.0, expected[i])) << i;
+        }
+    }
+    EXPECT_EQ(k, count);
+}
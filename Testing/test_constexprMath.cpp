@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "../include/constexprMath.h"
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace
+{
+    // Distance in units in the last place between two finite doubles of the same sign.
+    std::int64_t ulpDistance(double a, double b)
+    {
+        const std::int64_t ia = std::bit_cast<std::int64_t>(a);
+        const std::int64_t ib = std::bit_cast<std::int64_t>(b);
+        return ia > ib ? ia - ib : ib - ia;
+    }
+
+    constexpr auto expGrid = constexprMath::tabulate<2001>(-745.0, 709.0, [](double x) { return x; });
+    constexpr auto expTable = constexprMath::tabulate<2001>(-745.0, 709.0, [](double x) { return constexprMath::exp(x); });
+    constexpr auto logGrid = constexprMath::tabulate<2001>(-1020.0, 1020.0, [](double e) { return constexprMath::exp(e * 0.69314718); });
+    constexpr auto logTable = constexprMath::tabulate<2001>(-1020.0, 1020.0, [](double e) { return constexprMath::log(constexprMath::exp(e * 0.69314718)); });
+    constexpr auto sqrtTable = constexprMath::tabulate<2001>(0.0, 1e6, [](double x) { return constexprMath::sqrt(x); });
+}
+
+static_assert(constexprMath::exp(0.0) == 1.0);
+static_assert(constexprMath::exp(1000.0) == std::numeric_limits<double>::infinity());
+static_assert(constexprMath::exp(-1000.0) == 0.0);
+static_assert(constexprMath::log(1.0) == 0.0);
+static_assert(constexprMath::log(0.0) == -std::numeric_limits<double>::infinity());
+static_assert(constexprMath::sqrt(4.0) == 2.0);
+static_assert(constexprMath::sqrt(0.25) == 0.5);
+static_assert(constexprMath::abs(-3.5) == 3.5);
+
+TEST(constexprMathTest, CompileTimeExpMatchesStd)
+{
+    for (size_t i = 0; i < expGrid.size(); ++i)
+    {
+        const double expected = std::exp(expGrid[i]);
+        if (expected < std::numeric_limits<double>::min())
+        {
+            EXPECT_NEAR(expTable[i], expected, 4 * std::numeric_limits<double>::denorm_min()) << expGrid[i];
+        }
+        else
+        {
+            EXPECT_LE(ulpDistance(expTable[i], expected), 2) << expGrid[i];
+        }
+    }
+}
+
+TEST(constexprMathTest, CompileTimeLogMatchesStd)
+{
+    for (size_t i = 0; i < logGrid.size(); ++i)
+    {
+        const double expected = std::log(logGrid[i]);
+        EXPECT_NEAR(logTable[i], expected, 4.5e-16 * std::max(1.0, std::abs(expected))) << logGrid[i];
+    }
+}
+
+TEST(constexprMathTest, CompileTimeSqrtMatchesStd)
+{
+    const auto grid = constexprMath::tabulate<2001>(0.0, 1e6, [](double x) { return x; });
+    for (size_t i = 0; i < grid.size(); ++i)
+    {
+        EXPECT_LE(ulpDistance(sqrtTable[i], std::sqrt(grid[i])), 1) << grid[i];
+    }
+}
+
+TEST(constexprMathTest, CompileTimeSpecialValues)
+{
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+    constexpr double logNegative = constexprMath::log(-1.0);
+    constexpr double sqrtNegative = constexprMath::sqrt(-1.0);
+    constexpr double expNaN = constexprMath::exp(nan);
+    constexpr double subnormalSqrt = constexprMath::sqrt(4.0 * std::numeric_limits<double>::denorm_min());
+    constexpr double subnormalLog = constexprMath::log(std::numeric_limits<double>::denorm_min());
+
+    EXPECT_TRUE(std::isnan(logNegative));
+    EXPECT_TRUE(std::isnan(sqrtNegative));
+    EXPECT_TRUE(std::isnan(expNaN));
+    EXPECT_LE(ulpDistance(subnormalSqrt, std::sqrt(4.0 * std::numeric_limits<double>::denorm_min())), 1);
+    EXPECT_LE(ulpDistance(subnormalLog, std::log(std::numeric_limits<double>::denorm_min())), 2);
+}
+
+TEST(constexprMathTest, RuntimeCallsAreStd)
+{
+    volatile double x = 0.7312;
+    EXPECT_EQ(constexprMath::exp(x), std::exp(x));
+    EXPECT_EQ(constexprMath::log(x), std::log(x));
+    EXPECT_EQ(constexprMath::sqrt(x), std::sqrt(x));
+}
+
+TEST(constexprMathTest, TabulateIncludesBothEnds)
+{
+    constexpr auto table = constexprMath::tabulate<5>(1.0, 2.0, [](double x) { return x; });
+    static_assert(table[0] == 1.0 && table[2] == 1.5 && table[4] == 2.0);
+    EXPECT_EQ(table[1], 1.25);
+}
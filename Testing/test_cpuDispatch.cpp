@@ -0,0 +1,96 @@
+#include "gtest/gtest.h"
+#include "../include/cpuDispatch.h"
+#include "../include/batchPricing.h"
+#include <cmath>
+#include <vector>
+
+class cpuDispatchTest : public testing::Test
+{
+    protected:
+        void TearDown() override
+        {
+            resetSimdLevel();
+        }
+};
+
+TEST_F(cpuDispatchTest, ScalarAlwaysSupported)
+{
+    EXPECT_TRUE(isSimdLevelSupported(SCALAR));
+    EXPECT_TRUE(isSimdLevelSupported(detectSimdLevel()));
+}
+
+TEST_F(cpuDispatchTest, LevelsAboveDetectedAreRejected)
+{
+    SimdLevel detected = detectSimdLevel();
+    for (SimdLevel level : {SCALAR, SSE42, AVX2, AVX512})
+    {
+        EXPECT_EQ(isSimdLevelSupported(level), level <= detected) << simdLevelName(level);
+    }
+}
+
+TEST_F(cpuDispatchTest, ForceLevel)
+{
+    ASSERT_TRUE(setSimdLevel(SCALAR));
+    EXPECT_EQ(activeSimdLevel(), SCALAR);
+    EXPECT_EQ(simdKernels().level, SCALAR);
+
+    ASSERT_TRUE(setSimdLevel(detectSimdLevel()));
+    EXPECT_EQ(activeSimdLevel(), detectSimdLevel());
+}
+
+TEST_F(cpuDispatchTest, ForceUnsupportedLevelKeepsActive)
+{
+    if (detectSimdLevel() == AVX512)
+    {
+        GTEST_SKIP() << "every level is supported on this CPU";
+    }
+    ASSERT_TRUE(setSimdLevel(SCALAR));
+    EXPECT_FALSE(setSimdLevel(AVX512));
+    EXPECT_EQ(activeSimdLevel(), SCALAR);
+}
+
+TEST_F(cpuDispatchTest, ParseLevelNames)
+{
+    for (SimdLevel level : {SCALAR, SSE42, AVX2, AVX512})
+    {
+        SimdLevel parsed;
+        ASSERT_TRUE(parseSimdLevel(simdLevelName(level), parsed));
+        EXPECT_EQ(parsed, level);
+    }
+    SimdLevel parsed = SCALAR;
+    EXPECT_FALSE(parseSimdLevel("neon", parsed));
+    EXPECT_EQ(parsed, SCALAR);
+}
+
+TEST_F(cpuDispatchTest, BatchPricesAgreeAcrossLevels)
+{
+    optionBatch batch;
+    batch.resize(13);
+    for (size_t i = 0; i < batch.size(); ++i)
+    {
+        batch.underlyingPrice[i] = 100.0;
+        batch.strikePrice[i] = 70.0 + 5.0 * i;
+        batch.timeToExperation[i] = 0.25 + 0.1 * i;
+        batch.riskFreeRate[i] = 0.03;
+        batch.volatility[i] = 0.2 + 0.01 * i;
+        batch.optionType[i] = (i % 3 == 0) ? PUT : CALL;
+    }
+
+    ASSERT_TRUE(setSimdLevel(SCALAR));
+    std::vector<double> reference;
+    blackScholesBatchPrice(batch, reference);
+
+    for (SimdLevel level : {SSE42, AVX2, AVX512})
+    {
+        if (!setSimdLevel(level))
+        {
+            continue;
+        }
+        std::vector<double> prices;
+        blackScholesBatchPrice(batch, prices);
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            EXPECT_NEAR(prices[i], reference[i], 1e-12 * std::max(1.0, reference[i])) << simdLevelName(level) << " " << i;
+        }
+    }
+}
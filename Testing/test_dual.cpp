@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "../include/dual.h"
+#include "../include/pricingCore.h"
+#include "../include/blackScholesModel.h"
+#include <cmath>
+#include <numbers>
+
+TEST(dualTest, FirstDerivativesOfElementaryFunctions)
+{
+    const dual<double, 2> x = dualVariable<2>(1.5, 0);
+    const dual<double, 2> y = dualVariable<2>(0.7, 1);
+
+    // f = exp(x y) / sqrt(x) + log(x / y) - 3 / y
+    const dual<double, 2> f = exp(x * y) / sqrt(x) + log(x / y) - 3.0 / y;
+    const double e = std::exp(1.5 * 0.7);
+    EXPECT_DOUBLE_EQ(f.value, e / std::sqrt(1.5) + std::log(1.5 / 0.7) - 3.0 / 0.7);
+    EXPECT_NEAR(f.tangent[0], 0.7 * e / std::sqrt(1.5) - 0.5 * e / std::pow(1.5, 1.5) + 1.0 / 1.5, 1e-14);
+    EXPECT_NEAR(f.tangent[1], 1.5 * e / std::sqrt(1.5) - 1.0 / 0.7 + 3.0 / (0.7 * 0.7), 1e-14);
+
+    const dual<double, 2> negative = abs(-2.0 * x);
+    EXPECT_DOUBLE_EQ(negative.value, 3.0);
+    EXPECT_DOUBLE_EQ(negative.tangent[0], 2.0);
+    EXPECT_TRUE(x > y && y < 1.0 && x == 1.5);
+}
+
+TEST(dualTest, SecondDerivativesOfNestedDuals)
+{
+    const secondOrderDual<2> x = secondOrderVariable<2>(1.5, 0);
+    const secondOrderDual<2> y = secondOrderVariable<2>(0.7, 1);
+
+    // f = x^2 y + exp(y) / x
+    const secondOrderDual<2> f = x * x * y + exp(y) / x;
+    const double ey = std::exp(0.7);
+    EXPECT_DOUBLE_EQ(primal(f), 1.5 * 1.5 * 0.7 + ey / 1.5);
+    EXPECT_NEAR(f.value.tangent[0], 2 * 1.5 * 0.7 - ey / (1.5 * 1.5), 1e-14);
+    EXPECT_NEAR(f.value.tangent[1], 1.5 * 1.5 + ey / 1.5, 1e-14);
+    EXPECT_NEAR(f.tangent[0].tangent[0], 2 * 0.7 + 2 * ey / (1.5 * 1.5 * 1.5), 1e-14);
+    EXPECT_NEAR(f.tangent[1].tangent[1], ey / 1.5, 1e-14);
+    EXPECT_NEAR(f.tangent[0].tangent[1], 2 * 1.5 - ey / (1.5 * 1.5), 1e-14);
+    EXPECT_DOUBLE_EQ(f.tangent[0].tangent[1], f.tangent[1].tangent[0]);
+}
+
+TEST(dualTest, PriceDerivativesMatchClosedFormGreeks)
+{
+    const double S = 100.0, K = 95.0, T = 0.75, r = 0.03, vol = 0.25;
+    for (OptionType type : {CALL, PUT})
+    {
+        const blackScholesGreeks greeks = blackScholesPriceAndGreeks(S, K, T, r, vol, type);
+        const blackScholesSensitivities sensitivities = blackScholesPriceAndSensitivities(S, K, T, r, vol, type);
+
+        EXPECT_DOUBLE_EQ(sensitivities.price, blackScholesPrice(S, K, T, r, vol, type));
+        EXPECT_NEAR(sensitivities.delta, greeks.delta, 1e-12);
+        EXPECT_NEAR(sensitivities.gamma, greeks.gamma, 1e-12);
+        EXPECT_NEAR(sensitivities.vega, greeks.vega, 1e-10);
+        EXPECT_NEAR(sensitivities.theta, greeks.theta, 1e-10);
+        EXPECT_NEAR(sensitivities.rho, greeks.rho, 1e-10);
+
+        const double sqrtT = std::sqrt(T);
+        const double d1 = blackScholesD1(S, K, T, r, vol);
+        const double d2 = d1 - vol * sqrtT;
+        const double density = normalPDF(d1);
+        EXPECT_NEAR(sensitivities.vanna, -density * d2 / vol, 1e-12);
+        EXPECT_NEAR(sensitivities.volga, S * density * sqrtT * d1 * d2 / vol, 1e-10);
+        // Charm is the same for calls and puts without dividends.
+        EXPECT_NEAR(sensitivities.charm, -density * (2 * r * T - d2 * vol * sqrtT) / (2 * T * vol * sqrtT), 1e-12);
+    }
+}
+
+TEST(dualTest, SecondOrderSensitivitiesMatchFiniteDifferences)
+{
+    const double S = 100.0, K = 110.0, T = 0.5, r = 0.02, vol = 0.3;
+    const double h = 1e-3;
+    const blackScholesSensitivities sensitivities = blackScholesPriceAndSensitivities<PUT>(S, K, T, r, vol);
+    auto delta = [&](double s, double t, double v) {
+        return blackScholesPriceAndGreeks<PUT, GREEK_DELTA>(s, K, t, r, v).delta;
+    };
+    auto vega = [&](double v) { return blackScholesPriceAndGreeks<PUT, GREEK_VEGA>(S, K, T, r, v).vega; };
+
+    EXPECT_NEAR(sensitivities.vanna, (delta(S, T, vol + h) - delta(S, T, vol - h)) / (2 * h), 1e-5);
+    EXPECT_NEAR(sensitivities.volga, (vega(vol + h) - vega(vol - h)) / (2 * h), 1e-3);
+    EXPECT_NEAR(sensitivities.charm, -(delta(S, T + h, vol) - delta(S, T - h, vol)) / (2 * h), 1e-5);
+}
+
+TEST(dualTest, SensitivitiesAreConstexpr)
+{
+    constexpr blackScholesSensitivities compileTime = blackScholesPriceAndSensitivities<CALL>(100.0, 100.0, 1.0, 0.05, 0.2);
+    const blackScholesSensitivities runTime = blackScholesPriceAndSensitivities(100.0, 100.0, 1.0, 0.05, 0.2, CALL);
+    EXPECT_NEAR(compileTime.price, runTime.price, 1e-13);
+    EXPECT_NEAR(compileTime.vanna, runTime.vanna, 1e-13);
+    EXPECT_NEAR(compileTime.charm, runTime.charm, 1e-13);
+}
+
+TEST(dualTest, ModelSensitivities)
+{
+    const blackScholesModel model(50.0, 45.0, 0.0822, 0.05, 0.2, CALL);
+    const blackScholesSensitivities sensitivities = model.calculateSensitivities();
+    EXPECT_DOUBLE_EQ(sensitivities.price, model.calculateOptionPrice());
+    EXPECT_NEAR(sensitivities.delta, normalCDF(model.getD1()), 1e-12);
+
+    const blackScholesModel empty;
+    EXPECT_TRUE(std::isnan(empty.calculateSensitivities().vanna));
+}
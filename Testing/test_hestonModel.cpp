@@ -78,8 +78,9 @@ TEST_F(hestonModelTest, SettersAndGetters)
 
 TEST_F(hestonModelTest, CalculateOptionPrice)
 {
+    // The Monte Carlo price converges to the Black-Scholes price averaged over the exact terminal variance.
     double optionPrice = model2.calculateOptionPrice(true, 10000, 100);
-    EXPECT_NEAR(optionPrice, 6.682601659241039, 1e-6); // Adjust the expected value and tolerance as needed
+    EXPECT_NEAR(optionPrice, hestonTerminalVariancePrice(100.0, 100.0, 1.0, 0.05, model2.getParameters(), PUT), 0.1);
 }
 
 // Additional tests
@@ -138,3 +139,62 @@ TEST_F(hestonModelTest, InvalidInputs) {
     EXPECT_TRUE(isnan(model.calculateOptionPrice(true, 10000, 100)));
 }
 
+TEST_F(hestonModelTest, MonteCarloSensitivities)
+{
+    const hestonSensitivities sensitivities = model2.calculateMonteCarloSensitivities(20000, 50);
+    // Same seed, same paths; a put loses value with the spot and gains it with the variance.
+    EXPECT_NEAR(sensitivities.price, model2.calculateOptionPrice(true, 20000, 50), 1e-12);
+    EXPECT_LT(sensitivities.delta, 0.0);
+    EXPECT_GT(sensitivities.v0, 0.0);
+    EXPECT_GT(sensitivities.theta, 0.0);
+
+    EXPECT_TRUE(isnan(model1.calculateMonteCarloSensitivities(100, 10).price));
+}
+
+TEST_F(hestonModelTest, ThreadCount)
+{
+    EXPECT_EQ(model2.getThreadCount(), 0u);
+    model2.setThreadCount(4);
+    EXPECT_EQ(model2.getThreadCount(), 4u);
+
+    // sigma = 0 removes the randomness, so any number of workers gives the same price.
+    hestonModel deterministic(100.0, 100.0, 1.0, 0.05, 0.2, 0.04, 2.0, 0.04, 0.0, -0.7, CALL);
+    deterministic.setThreadCount(1);
+    const double serial = deterministic.calculateOptionPrice(true, 1000, 20);
+    deterministic.setThreadCount(3);
+    EXPECT_NEAR(deterministic.calculateOptionPrice(true, 1000, 20), serial, 1e-12);
+}
+
+TEST_F(hestonModelTest, ReproducibleAcrossRunsAndThreadCounts)
+{
+    EXPECT_EQ(model2.getSeed(), 0u);
+    model2.setThreadCount(1);
+    const double serial = model2.calculateOptionPrice(true, 3000, 50);
+    EXPECT_EQ(model2.calculateOptionPrice(true, 3000, 50), serial);
+    for (unsigned threadCount : {2u, 7u, 0u})
+    {
+        model2.setThreadCount(threadCount);
+        EXPECT_EQ(model2.calculateOptionPrice(true, 3000, 50), serial) << threadCount;
+    }
+
+    model2.setSeed(12345);
+    EXPECT_EQ(model2.getSeed(), 12345u);
+    EXPECT_NE(model2.calculateOptionPrice(true, 3000, 50), serial);
+}
+
+TEST_F(hestonModelTest, Discretization)
+{
+    EXPECT_EQ(model2.getDiscretization(), HESTON_EULER);
+    const double euler = model2.calculateOptionPrice(true, 20000, 20);
+    model2.setDiscretization(HESTON_QE);
+    EXPECT_EQ(model2.getDiscretization(), HESTON_QE);
+
+    // Same seed, other scheme: a different estimate of the same price.
+    const double qe = model2.calculateOptionPrice(true, 20000, 20);
+    const double reference = hestonTerminalVariancePrice(100.0, 100.0, 1.0, 0.05, model2.getParameters(), PUT);
+    EXPECT_NE(qe, euler);
+    EXPECT_NEAR(qe, reference, 0.1);
+
+    std::mt19937 generator(2);
+    EXPECT_GE(model2.simulateVariance(generator, 20), 0.0);
+}
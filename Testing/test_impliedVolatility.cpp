@@ -0,0 +1,377 @@
+#include "gtest/gtest.h"
+#include "../include/impliedVolatility.h"
+#include "../include/millsRatioTable.h"
+#include "../include/cpuDispatch.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+    /// @brief N(z) in long double from erfc, accurate in both tails.
+    long double normalCDFExact(long double z)
+    {
+        return 0.5L * std::erfc(-z / std::sqrt(2.0L));
+    }
+
+    /// @brief Black-Scholes price in long double, as a reference free of the A-S polynomial error.
+    double exactPrice(double underlyingPrice, double strikePrice, double timeToExperation, double riskFreeRate,
+                      double volatility, OptionType optionType)
+    {
+        const long double s = volatility * std::sqrt(static_cast<long double>(timeToExperation));
+        const long double d1 = (std::log(static_cast<long double>(underlyingPrice) / strikePrice)
+                                + (riskFreeRate + 0.5L * volatility * volatility) * timeToExperation) / s;
+        const long double discountedStrike = strikePrice * std::exp(-static_cast<long double>(riskFreeRate) * timeToExperation);
+        if (optionType == CALL)
+        {
+            return static_cast<double>(underlyingPrice * normalCDFExact(d1) - discountedStrike * normalCDFExact(d1 - s));
+        }
+        return static_cast<double>(discountedStrike * normalCDFExact(s - d1) - underlyingPrice * normalCDFExact(-d1));
+    }
+
+    /// @brief dPrice / dvol, to turn the rounding error of a price into a volatility tolerance.
+    double exactVega(double underlyingPrice, double strikePrice, double timeToExperation, double riskFreeRate,
+                     double volatility)
+    {
+        const double s = volatility * std::sqrt(timeToExperation);
+        const double d1 = (std::log(underlyingPrice / strikePrice) + (riskFreeRate + 0.5 * volatility * volatility) * timeToExperation) / s;
+        return underlyingPrice * std::sqrt(timeToExperation) * std::exp(-0.5 * d1 * d1) / std::sqrt(2.0 * M_PI);
+    }
+}
+
+class impliedVolatilityTest : public testing::Test
+{
+    protected:
+        impliedVolatilityTest()
+        {
+            // Strikes 0.5-2 S, vols 1%-200%, expiries 1 day to 5 years, calls and puts: 4 x 7 x 15 x 10 options.
+            for (double moneyness = 0.5; moneyness <= 2.0; moneyness *= 1.05)
+            {
+                for (double volatility = 0.01; volatility <= 2.0; volatility *= 1.5)
+                {
+                    for (double timeToExperation : {1.0 / 365.0, 0.1, 1.0, 5.0})
+                    {
+                        for (OptionType optionType : {CALL, PUT})
+                        {
+                            const double price = exactPrice(100.0, 100.0 * moneyness, timeToExperation, 0.03,
+                                                            volatility, optionType);
+                            // Time values below 1e-250 are tested separately.
+                            if (!(price > 1e-250))
+                            {
+                                continue;
+                            }
+                            batch.underlyingPrice.push_back(100.0);
+                            batch.strikePrice.push_back(100.0 * moneyness);
+                            batch.timeToExperation.push_back(timeToExperation);
+                            batch.riskFreeRate.push_back(0.03);
+                            batch.volatility.push_back(volatility);
+                            batch.optionType.push_back(optionType);
+                            optionPrice.push_back(price);
+                        }
+                    }
+                }
+            }
+        }
+
+        ~impliedVolatilityTest() override
+        {
+            setSimdLevel(detectSimdLevel());
+        }
+
+        /// @brief The volatility error a price rounding of 8 ulp can cause, plus 1e-13 relative.
+        double tolerance(std::size_t i) const
+        {
+            const double vega = exactVega(batch.underlyingPrice[i], batch.strikePrice[i], batch.timeToExperation[i],
+                                          batch.riskFreeRate[i], batch.volatility[i]);
+            return 1e-13 * batch.volatility[i] + 8.0 * 2.2e-16 * optionPrice[i] / vega;
+        }
+
+        /// @brief false deep in the money, where the time value can vanish in the rounding of the price.
+        bool hasTimeValue(std::size_t i) const
+        {
+            const double discountedStrike = batch.strikePrice[i] * std::exp(-batch.riskFreeRate[i] * batch.timeToExperation[i]);
+            const double intrinsic = batch.optionType[i] == CALL ? batch.underlyingPrice[i] - discountedStrike
+                                                                 : discountedStrike - batch.underlyingPrice[i];
+            return optionPrice[i] - std::max(0.0, intrinsic) >= 1e-12 * optionPrice[i];
+        }
+
+        optionBatch batch;
+        std::vector<double> optionPrice;
+};
+
+TEST_F(impliedVolatilityTest, RecoversVolatilityOfExactPrices)
+{
+    ASSERT_GT(batch.size(), 1000u);
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        if (!hasTimeValue(i))
+        {
+            continue;
+        }
+        const double volatility = impliedVolatility(optionPrice[i], batch.underlyingPrice[i], batch.strikePrice[i],
+                                                    batch.timeToExperation[i], batch.riskFreeRate[i], batch.optionType[i]);
+        EXPECT_NEAR(volatility, batch.volatility[i], tolerance(i))
+            << "K=" << batch.strikePrice[i] << " T=" << batch.timeToExperation[i] << " type=" << batch.optionType[i];
+    }
+}
+
+TEST_F(impliedVolatilityTest, ConvergesInFewIterations)
+{
+    std::vector<double> volatility(batch.size());
+    std::vector<std::uint8_t> iterations(batch.size());
+    impliedVolatilityBatch(batch.size(), optionPrice.data(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                           batch.timeToExperation.data(), batch.riskFreeRate.data(), batch.optionType.data(),
+                           volatility.data(), iterations.data());
+
+    std::size_t withinThree = 0;
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        EXPECT_LE(iterations[i], 4) << i;
+        withinThree += iterations[i] <= 3;
+    }
+    EXPECT_GE(withinThree, batch.size() * 99 / 100);
+
+    int steps = 0;
+    impliedVolatility(10.45, 100.0, 100.0, 1.0, 0.05, CALL, &steps);
+    EXPECT_GE(steps, 1);
+    EXPECT_LE(steps, 3);
+}
+
+TEST_F(impliedVolatilityTest, BatchMatchesScalarAtEveryLevel)
+{
+    std::vector<double> reference(batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        reference[i] = impliedVolatility(optionPrice[i], batch.underlyingPrice[i], batch.strikePrice[i],
+                                         batch.timeToExperation[i], batch.riskFreeRate[i], batch.optionType[i]);
+    }
+
+    for (SimdLevel level : {SCALAR, SSE42, AVX2, AVX512})
+    {
+        if (!setSimdLevel(level))
+        {
+            continue;
+        }
+        std::vector<double> volatility;
+        impliedVolatilityBatch(batch, optionPrice, volatility);
+        ASSERT_EQ(volatility.size(), batch.size());
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            if (!hasTimeValue(i))
+            {
+                continue;
+            }
+            EXPECT_NEAR(volatility[i], reference[i], 1e-12 * reference[i] + tolerance(i)) << simdLevelName(level) << " " << i;
+        }
+    }
+}
+
+TEST_F(impliedVolatilityTest, PutCallParity)
+{
+    // A put and a call related by parity have the same implied volatility.
+    const double S = 100.0, K = 110.0, T = 0.75, r = 0.04;
+    const double call = exactPrice(S, K, T, r, 0.35, CALL);
+    const double put = call - S + K * std::exp(-r * T);
+    EXPECT_NEAR(impliedVolatility(call, S, K, T, r, CALL), impliedVolatility(put, S, K, T, r, PUT), 1e-13);
+}
+
+TEST_F(impliedVolatilityTest, TinyPricesKeepRelativeAccuracy)
+{
+    // Out-of-the-money options whose price underflows N(d1) - N(d2) arithmetic.
+    for (double volatility : {0.03, 0.05, 0.07})
+    {
+        const double price = exactPrice(100.0, 150.0, 0.25, 0.0, volatility, CALL);
+        ASSERT_GT(price, 1e-300);
+        ASSERT_LT(price, 1e-20);
+        EXPECT_NEAR(impliedVolatility(price, 100.0, 150.0, 0.25, 0.0, CALL), volatility, 1e-13 * volatility) << price;
+    }
+}
+
+TEST_F(impliedVolatilityTest, PricesOutsideBoundsAreNaN)
+{
+    const double S = 100.0, K = 90.0, T = 0.5, r = 0.02;
+    const double callIntrinsic = S - K * std::exp(-r * T);
+    EXPECT_TRUE(std::isnan(impliedVolatility(callIntrinsic - 0.01, S, K, T, r, CALL)));
+    EXPECT_TRUE(std::isnan(impliedVolatility(S + 0.01, S, K, T, r, CALL)));
+    EXPECT_TRUE(std::isnan(impliedVolatility(-1.0, S, K, T, r, PUT)));
+    EXPECT_TRUE(std::isnan(impliedVolatility(K, S, K, T, r, PUT)));
+    EXPECT_TRUE(std::isnan(impliedVolatility(0.0, S, K, T, r, CALL)));
+    // An out-of-the-money option priced at 0 has zero volatility.
+    EXPECT_EQ(impliedVolatility(0.0, S, K, T, r, PUT), 0.0);
+
+    // Exactly at the upper bound, which normalization alone rounds to just inside it.
+    for (double strike : {50.0, 80.0, 90.0, 120.0, 200.0})
+    {
+        EXPECT_TRUE(std::isnan(impliedVolatility(S, S, strike, 1.0, 0.03, CALL))) << strike;
+        EXPECT_TRUE(std::isnan(impliedVolatility(strike * std::exp(-0.03), S, strike, 1.0, 0.03, PUT))) << strike;
+    }
+}
+
+TEST_F(impliedVolatilityTest, InvalidInputsAreNaN)
+{
+    EXPECT_TRUE(std::isnan(impliedVolatility(NAN, 100.0, 100.0, 1.0, 0.05, CALL)));
+    EXPECT_TRUE(std::isnan(impliedVolatility(10.0, -100.0, 100.0, 1.0, 0.05, CALL)));
+    EXPECT_TRUE(std::isnan(impliedVolatility(10.0, 100.0, 0.0, 1.0, 0.05, CALL)));
+    EXPECT_TRUE(std::isnan(impliedVolatility(10.0, 100.0, 100.0, 0.0, 0.05, CALL)));
+    EXPECT_TRUE(std::isnan(impliedVolatility(10.0, 100.0, 100.0, 1.0, NAN, PUT)));
+    EXPECT_TRUE(std::isnan(impliedVolatility(5.0, 100.0, 100.0, 1.0, 0.0, static_cast<OptionType>(7))));
+}
+
+namespace
+{
+    /// @brief A smile of strikes 60-160 for one expiry, priced exactly, with its volatilities.
+    optionChain smileChain(double timeToExperation, std::vector<double>& optionPrice)
+    {
+        optionChain chain;
+        chain.underlyingPrice = 100.0;
+        chain.timeToExperation = timeToExperation;
+        chain.riskFreeRate = 0.02;
+        for (double strikePrice = 60.0; strikePrice <= 160.0; strikePrice += 2.5)
+        {
+            const double moneyness = std::log(strikePrice / 100.0);
+            const double volatility = 0.2 - 0.1 * moneyness + 0.3 * moneyness * moneyness;
+            chain.strikePrice.push_back(strikePrice);
+            chain.volatility.push_back(volatility);
+            chain.optionType.push_back(strikePrice < 100.0 ? PUT : CALL);
+            optionPrice.push_back(exactPrice(100.0, strikePrice, timeToExperation, 0.02, volatility, chain.optionType.back()));
+        }
+        return chain;
+    }
+}
+
+TEST_F(impliedVolatilityTest, ChainMatchesBatch)
+{
+    std::vector<double> optionPrice;
+    const optionChain chain = smileChain(0.5, optionPrice);
+    const std::size_t count = chain.size();
+
+    std::vector<double> cold(count), warm(count), seeded(count);
+    std::vector<double> spot(count, chain.underlyingPrice), expiry(count, chain.timeToExperation), rate(count, chain.riskFreeRate);
+    impliedVolatilityBatch(count, optionPrice.data(), spot.data(), chain.strikePrice.data(), expiry.data(), rate.data(),
+                           chain.optionType.data(), cold.data());
+    impliedVolatilityChain(chain.underlyingPrice, chain.timeToExperation, chain.riskFreeRate, count, optionPrice.data(),
+                           chain.strikePrice.data(), chain.optionType.data(), nullptr, warm.data());
+    impliedVolatilityChain(chain.underlyingPrice, chain.timeToExperation, chain.riskFreeRate, count, optionPrice.data(),
+                           chain.strikePrice.data(), chain.optionType.data(), chain.volatility.data(), seeded.data());
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        EXPECT_NEAR(warm[i], cold[i], 1e-13 * cold[i]) << chain.strikePrice[i];
+        EXPECT_NEAR(seeded[i], cold[i], 1e-13 * cold[i]) << chain.strikePrice[i];
+        EXPECT_NEAR(cold[i], chain.volatility[i], 1e-12 * chain.volatility[i]) << chain.strikePrice[i];
+    }
+}
+
+TEST_F(impliedVolatilityTest, WarmStartTakesFewerIterations)
+{
+    std::vector<double> optionPrice;
+    const optionChain chain = smileChain(1.0, optionPrice);
+    const std::size_t count = chain.size();
+
+    std::vector<double> volatility(count);
+    std::vector<std::uint8_t> cold(count), neighbor(count), snapshot(count);
+    std::vector<double> spot(count, chain.underlyingPrice), expiry(count, chain.timeToExperation), rate(count, chain.riskFreeRate);
+    impliedVolatilityBatch(count, optionPrice.data(), spot.data(), chain.strikePrice.data(), expiry.data(), rate.data(),
+                           chain.optionType.data(), volatility.data(), cold.data());
+    impliedVolatilityChain(chain.underlyingPrice, chain.timeToExperation, chain.riskFreeRate, count, optionPrice.data(),
+                           chain.strikePrice.data(), chain.optionType.data(), nullptr, volatility.data(), neighbor.data());
+    impliedVolatilityChain(chain.underlyingPrice, chain.timeToExperation, chain.riskFreeRate, count, optionPrice.data(),
+                           chain.strikePrice.data(), chain.optionType.data(), chain.volatility.data(), volatility.data(),
+                           snapshot.data());
+
+    std::size_t coldSteps = 0, neighborSteps = 0, snapshotSteps = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        coldSteps += cold[i];
+        neighborSteps += neighbor[i];
+        snapshotSteps += snapshot[i];
+        EXPECT_LE(snapshot[i], 2) << chain.strikePrice[i];
+    }
+    EXPECT_LT(neighborSteps, coldSteps);
+    EXPECT_LT(snapshotSteps, neighborSteps);
+}
+
+TEST_F(impliedVolatilityTest, BadSeedsStillConverge)
+{
+    std::vector<double> optionPrice;
+    const optionChain chain = smileChain(0.25, optionPrice);
+    const std::size_t count = chain.size();
+
+    for (double factor : {1e-3, 0.2, 5.0, 1e3})
+    {
+        std::vector<double> seed(count), volatility(count);
+        std::vector<std::uint8_t> iterations(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            seed[i] = chain.volatility[i] * factor;
+        }
+        // Non-positive and non-finite seeds fall back to the neighbor.
+        seed[3] = -1.0;
+        seed[7] = NAN;
+        seed[11] = INFINITY;
+        impliedVolatilityChain(chain.underlyingPrice, chain.timeToExperation, chain.riskFreeRate, count,
+                               optionPrice.data(), chain.strikePrice.data(), chain.optionType.data(), seed.data(),
+                               volatility.data(), iterations.data());
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            EXPECT_NEAR(volatility[i], chain.volatility[i], 1e-12 * chain.volatility[i]) << factor << " " << chain.strikePrice[i];
+            EXPECT_LE(iterations[i], 16) << factor << " " << chain.strikePrice[i];
+        }
+    }
+}
+
+TEST_F(impliedVolatilityTest, SurfaceSolvesEveryChainInPlace)
+{
+    std::vector<optionChain> chains;
+    std::vector<std::vector<double>> optionPrice;
+    std::vector<std::vector<double>> expected;
+    for (double timeToExperation : {0.02, 0.1, 0.25, 0.5, 1.0, 2.0, 5.0})
+    {
+        optionPrice.emplace_back();
+        chains.push_back(smileChain(timeToExperation, optionPrice.back()));
+        expected.push_back(chains.back().volatility);
+    }
+
+    for (unsigned threadCount : {1u, 3u, 0u})
+    {
+        std::vector<optionChain> surface = chains;
+        for (optionChain& chain : surface)
+        {
+            std::fill(chain.volatility.begin(), chain.volatility.end(), NAN);
+        }
+        std::vector<std::vector<std::uint8_t>> iterations;
+        const impliedVolatilityStats cold = impliedVolatilitySurface(surface, optionPrice, iterations, threadCount);
+        ASSERT_EQ(iterations.size(), chains.size());
+        std::size_t options = 0;
+        for (std::size_t c = 0; c < chains.size(); ++c)
+        {
+            ASSERT_EQ(iterations[c].size(), chains[c].size());
+            options += chains[c].size();
+            for (std::size_t i = 0; i < chains[c].size(); ++i)
+            {
+                EXPECT_NEAR(surface[c].volatility[i], expected[c][i], 1e-12 * expected[c][i]) << threadCount << " " << c << " " << i;
+            }
+        }
+        EXPECT_EQ(cold.options, options);
+        EXPECT_GT(cold.meanIterations(), 1.0);
+        EXPECT_LE(cold.maxIterations, 8);
+
+        // The solved surface is the snapshot for the next solve of the same prices.
+        const impliedVolatilityStats warm = impliedVolatilitySurface(surface, optionPrice, iterations, threadCount);
+        EXPECT_LT(warm.iterations, cold.iterations);
+        EXPECT_EQ(warm.maxIterations, 1);
+    }
+}
+
+TEST(millsRatioTest, MatchesErfcReference)
+{
+    // Y(z) = N(z) / phi(z) = sqrt(pi / 2) e^{z^2 / 2} erfc(-z / sqrt(2)).
+    for (double z = -45.0; z <= 8.0; z += 0.0371)
+    {
+        const long double expected = std::sqrt(std::acos(-1.0L) / 2.0L) * std::exp(0.5L * z * z)
+                                     * std::erfc(-static_cast<long double>(z) / std::sqrt(2.0L));
+        EXPECT_NEAR(millsRatio(z), static_cast<double>(expected), 6e-16 * static_cast<double>(expected)) << z;
+    }
+    EXPECT_TRUE(std::isnan(millsRatio(NAN)));
+    static_assert(millsRatio(0.0) > 1.2533 && millsRatio(0.0) < 1.2534);
+}
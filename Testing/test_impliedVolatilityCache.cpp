@@ -0,0 +1,168 @@
+#include "gtest/gtest.h"
+#include "../include/impliedVolatilityCache.h"
+#include "../include/impliedVolatility.h"
+#include "../include/optionGreeksModel.h"
+#include <cmath>
+#include <thread>
+#include <vector>
+
+TEST(impliedVolatilityCacheTest, CountsHitsAndMisses)
+{
+    impliedVolatilityCache cache;
+    const double expected = impliedVolatility(10.45, 100.0, 100.0, 1.0, 0.05, CALL);
+
+    EXPECT_EQ(cache.impliedVolatility(10.45, 100.0, 100.0, 1.0, 0.05, CALL), expected);
+    EXPECT_EQ(cache.impliedVolatility(10.45, 100.0, 100.0, 1.0, 0.05, CALL), expected);
+    EXPECT_EQ(cache.impliedVolatility(10.45, 100.0, 100.0, 1.0, 0.05, CALL), expected);
+    // Same quote as a put: a different entry.
+    EXPECT_EQ(cache.impliedVolatility(10.45, 100.0, 100.0, 1.0, 0.05, PUT),
+              impliedVolatility(10.45, 100.0, 100.0, 1.0, 0.05, PUT));
+
+    const impliedVolatilityCacheStats stats = cache.statistics();
+    EXPECT_EQ(stats.hits, 2u);
+    EXPECT_EQ(stats.misses, 2u);
+    EXPECT_EQ(stats.size, 2u);
+    EXPECT_DOUBLE_EQ(stats.hitRate(), 0.5);
+
+    cache.resetStatistics();
+    EXPECT_EQ(cache.statistics().hits, 0u);
+    EXPECT_EQ(cache.statistics().size, 2u);
+    cache.clear();
+    EXPECT_EQ(cache.statistics().size, 0u);
+}
+
+TEST(impliedVolatilityCacheTest, QuotesWithinATickShareAnEntry)
+{
+    quoteQuantization quantization;
+    quantization.priceTick = 0.01;
+    quantization.timeTick = 1.0 / 365.0;
+    impliedVolatilityCache cache(1024, LEAST_RECENTLY_USED, quantization);
+
+    const double first = cache.impliedVolatility(10.451, 100.0, 100.0, 1.0, 0.05, CALL);
+    EXPECT_EQ(cache.impliedVolatility(10.449, 100.0, 100.0, 1.0 + 0.2 / 365.0, 0.05, CALL), first);
+    EXPECT_NE(cache.impliedVolatility(10.46, 100.0, 100.0, 1.0, 0.05, CALL), first);
+    EXPECT_EQ(cache.statistics().hits, 1u);
+    EXPECT_EQ(cache.statistics().misses, 2u);
+}
+
+TEST(impliedVolatilityCacheTest, NaNResultsAndInvalidQuotes)
+{
+    impliedVolatilityCache cache;
+    // Above the upper bound: cached as NaN.
+    EXPECT_TRUE(std::isnan(cache.impliedVolatility(120.0, 100.0, 100.0, 1.0, 0.05, CALL)));
+    EXPECT_TRUE(std::isnan(cache.impliedVolatility(120.0, 100.0, 100.0, 1.0, 0.05, CALL)));
+    EXPECT_EQ(cache.statistics().hits, 1u);
+
+    // Not finite or beyond 2^62 ticks: solved every time, never cached.
+    EXPECT_TRUE(std::isnan(cache.impliedVolatility(NAN, 100.0, 100.0, 1.0, 0.05, CALL)));
+    EXPECT_TRUE(std::isnan(cache.impliedVolatility(10.0, 1e60, 100.0, 1.0, 0.05, CALL)));
+    const impliedVolatilityCacheStats stats = cache.statistics();
+    EXPECT_EQ(stats.uncacheable, 2u);
+    EXPECT_EQ(stats.size, 1u);
+}
+
+TEST(impliedVolatilityCacheTest, LeastRecentlyUsedKeepsHotEntries)
+{
+    impliedVolatilityCache cache(2, LEAST_RECENTLY_USED, quoteQuantization(), 1);
+    cache.impliedVolatility(10.0, 100.0, 100.0, 1.0, 0.05, CALL);
+    cache.impliedVolatility(11.0, 100.0, 100.0, 1.0, 0.05, CALL);
+    cache.impliedVolatility(10.0, 100.0, 100.0, 1.0, 0.05, CALL);   // hit, now the most recent
+    cache.impliedVolatility(12.0, 100.0, 100.0, 1.0, 0.05, CALL);   // evicts 11
+    cache.resetStatistics();
+
+    cache.impliedVolatility(10.0, 100.0, 100.0, 1.0, 0.05, CALL);
+    cache.impliedVolatility(11.0, 100.0, 100.0, 1.0, 0.05, CALL);
+    const impliedVolatilityCacheStats stats = cache.statistics();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.evictions, 1u);
+    EXPECT_EQ(stats.size, 2u);
+}
+
+TEST(impliedVolatilityCacheTest, FirstInFirstOutIgnoresHits)
+{
+    impliedVolatilityCache cache(2, FIRST_IN_FIRST_OUT, quoteQuantization(), 1);
+    cache.impliedVolatility(10.0, 100.0, 100.0, 1.0, 0.05, CALL);
+    cache.impliedVolatility(11.0, 100.0, 100.0, 1.0, 0.05, CALL);
+    cache.impliedVolatility(10.0, 100.0, 100.0, 1.0, 0.05, CALL);   // hit, still the oldest
+    cache.impliedVolatility(12.0, 100.0, 100.0, 1.0, 0.05, CALL);   // evicts 10
+    cache.resetStatistics();
+
+    cache.impliedVolatility(11.0, 100.0, 100.0, 1.0, 0.05, CALL);
+    cache.impliedVolatility(10.0, 100.0, 100.0, 1.0, 0.05, CALL);
+    EXPECT_EQ(cache.statistics().hits, 1u);
+    EXPECT_EQ(cache.statistics().misses, 1u);
+}
+
+TEST(impliedVolatilityCacheTest, CapacityBoundsEveryShard)
+{
+    impliedVolatilityCache cache(64, LEAST_RECENTLY_USED, quoteQuantization(), 4);
+    EXPECT_EQ(cache.capacity(), 64u);
+    for (int i = 0; i < 1000; ++i)
+    {
+        cache.impliedVolatility(5.0 + 0.01 * i, 100.0, 100.0, 1.0, 0.05, CALL);
+    }
+    const impliedVolatilityCacheStats stats = cache.statistics();
+    EXPECT_LE(stats.size, 64u);
+    EXPECT_EQ(stats.size + stats.evictions, 1000u);
+
+    cache.configure(0, LEAST_RECENTLY_USED, quoteQuantization());
+    EXPECT_EQ(cache.statistics().size, 0u);
+    cache.impliedVolatility(10.0, 100.0, 100.0, 1.0, 0.05, CALL);
+    EXPECT_EQ(cache.statistics().size, 0u);
+}
+
+TEST(impliedVolatilityCacheTest, ConcurrentLookupsAgreeWithTheSolver)
+{
+    impliedVolatilityCache cache(4096);
+    std::vector<double> prices;
+    for (int i = 0; i < 100; ++i)
+    {
+        prices.push_back(2.0 + 0.1 * i);
+    }
+
+    std::vector<std::thread> threads;
+    std::vector<int> mismatches(4, 0);
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&, t]() {
+            for (int pass = 0; pass < 20; ++pass)
+            {
+                for (double price : prices)
+                {
+                    const double expected = impliedVolatility(price, 100.0, 105.0, 0.5, 0.02, CALL);
+                    mismatches[t] += cache.impliedVolatility(price, 100.0, 105.0, 0.5, 0.02, CALL) != expected;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int t = 0; t < 4; ++t)
+    {
+        EXPECT_EQ(mismatches[t], 0);
+    }
+    const impliedVolatilityCacheStats stats = cache.statistics();
+    EXPECT_EQ(stats.hits + stats.misses, 4u * 20u * prices.size());
+    EXPECT_EQ(stats.size, prices.size());
+    EXPECT_GE(stats.hits, 4u * 19u * prices.size());
+}
+
+TEST(impliedVolatilityCacheTest, ModelsShareTheQuoteCache)
+{
+    impliedVolatilityCache& cache = optionGreeksModel::impliedVolatilityQuoteCache();
+    cache.clear();
+    cache.resetStatistics();
+
+    optionGreeksModel model(100.0, 100.0, 1.0, 0.05, 0.3);
+    optionGreeksModel other(100.0, 100.0, 1.0, 0.05, 0.25);
+    const impliedVolatilityCacheStats before = cache.statistics();
+    EXPECT_NEAR(model.calculateImpliedVolatility(10.450583572185565), 0.2, 1e-12);
+    EXPECT_NEAR(other.calculateImpliedVolatility(10.450583572185565), 0.2, 1e-12);
+    const impliedVolatilityCacheStats after = cache.statistics();
+    EXPECT_EQ(after.misses - before.misses, 1u);
+    EXPECT_EQ(after.hits - before.hits, 1u);
+}
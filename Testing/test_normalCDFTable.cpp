@@ -0,0 +1,170 @@
+#include "gtest/gtest.h"
+#include "../include/normalCDFTable.h"
+#include "../include/pricingCore.h"
+#include "../include/batchPricing.h"
+#include "../include/cpuDispatch.h"
+#include <cmath>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    double exactNormalCDF(double x)
+    {
+        return 0.5 * std::erfc(-x / std::sqrt(2.0));
+    }
+
+    constexpr auto erfcGrid = constexprMath::tabulate<2001>(-10.0, 27.0, [](double x) { return x; });
+    constexpr auto erfcTable = constexprMath::tabulate<2001>(-10.0, 27.0, [](double x) { return constexprMath::erfc(x); });
+}
+
+static_assert(normalCDFTabulated(0.0) == 0.5);
+static_assert(normalCDFTabulated(-100.0) < 1e-15);
+static_assert(normalCDFTabulated(100.0) > 1.0 - 1e-15);
+static_assert(constexprMath::erfc(0.0) == 1.0);
+
+TEST(normalCDFTableTest, CompileTimeErfcMatchesStd)
+{
+    for (size_t i = 0; i < erfcGrid.size(); ++i)
+    {
+        const double expected = std::erfc(erfcGrid[i]);
+        EXPECT_NEAR(erfcTable[i], expected, 1e-15) << erfcGrid[i];
+        if (erfcGrid[i] >= 3.0)
+        {
+            EXPECT_NEAR(erfcTable[i], expected, 1e-13 * expected) << erfcGrid[i];
+        }
+    }
+}
+
+TEST(normalCDFTableTest, WithinDocumentedErrorBound)
+{
+    double maxError = 0.0;
+    for (double x = -12.0; x <= 12.0; x += 1.0 / 4096.0 + 1e-9)
+    {
+        maxError = std::max(maxError, std::abs(normalCDFTabulated(x) - exactNormalCDF(x)));
+    }
+    EXPECT_LE(maxError, normalCDFTable::errorBound);
+    // Much tighter than the Abramowitz-Stegun polynomial it replaces.
+    EXPECT_LT(maxError, 7.5e-8 / 20.0);
+}
+
+TEST(normalCDFTableTest, ExactAtNodesAndContinuous)
+{
+    for (size_t i = 0; i <= normalCDFTable::intervals; i += 7)
+    {
+        const double node = normalCDFTable::lower + normalCDFTable::step * static_cast<double>(i);
+        EXPECT_NEAR(normalCDFTabulated(node), exactNormalCDF(node), 4.5e-16) << node;
+        // Both neighbouring cubics meet at the node.
+        EXPECT_NEAR(normalCDFTabulated(std::nextafter(node, -100.0)), normalCDFTabulated(node), 1e-15) << node;
+    }
+}
+
+TEST(normalCDFTableTest, SpecialValues)
+{
+    EXPECT_TRUE(std::isnan(normalCDFTabulated(NAN)));
+    EXPECT_EQ(normalCDFTabulated(std::numeric_limits<double>::infinity()), normalCDFTabulated(normalCDFTable::upper));
+    EXPECT_EQ(normalCDFTabulated(-std::numeric_limits<double>::infinity()), normalCDFTabulated(normalCDFTable::lower));
+}
+
+TEST(normalCDFTableTest, TabulatedPriceCloseToPolynomialPrice)
+{
+    for (OptionType type : {CALL, PUT})
+    {
+        const double polynomial = blackScholesPrice(100.0, 95.0, 0.5, 0.03, 0.25, type);
+        const double table = type == CALL ? blackScholesPrice<CALL, CDF_TABLE>(100.0, 95.0, 0.5, 0.03, 0.25)
+                                          : blackScholesPrice<PUT, CDF_TABLE>(100.0, 95.0, 0.5, 0.03, 0.25);
+        EXPECT_NEAR(table, polynomial, 7.6e-8 * (100.0 + 95.0));
+    }
+}
+
+TEST(normalCDFTableTest, BatchTableMethodMatchesScalarTable)
+{
+    // Long runs of one type and a mixed tail, so both the typed and the mixed kernels are used.
+    optionBatch batch;
+    const size_t count = 300;
+    batch.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        batch.underlyingPrice[i] = 80.0 + 0.15 * i;
+        batch.strikePrice[i] = 100.0;
+        batch.timeToExperation[i] = 0.25 + 0.005 * i;
+        batch.riskFreeRate[i] = 0.03;
+        batch.volatility[i] = 0.2 + 0.001 * i;
+        batch.optionType[i] = i < 100 ? CALL : (i < 200 ? PUT : (i % 2 == 0 ? CALL : PUT));
+    }
+    batch.volatility[250] = 1.5;
+
+    std::vector<double> polynomial, table;
+    blackScholesBatchPrice(batch, polynomial);
+    blackScholesBatchPrice(batch, table, CDF_TABLE);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i == 250)
+        {
+            EXPECT_TRUE(std::isnan(table[i]));
+            continue;
+        }
+        const double S = batch.underlyingPrice[i];
+        const double K = batch.strikePrice[i];
+        const double T = batch.timeToExperation[i];
+        const double r = batch.riskFreeRate[i];
+        const double vol = batch.volatility[i];
+        const double expected = batch.optionType[i] == CALL ? blackScholesPrice<CALL, CDF_TABLE>(S, K, T, r, vol)
+                                                            : blackScholesPrice<PUT, CDF_TABLE>(S, K, T, r, vol);
+        EXPECT_NEAR(table[i], expected, 1e-12) << i;
+        EXPECT_NEAR(table[i], polynomial[i], 7.6e-8 * (S + K)) << i;
+    }
+}
+
+TEST(normalCDFTableTest, HestonMonteCarloWithTable)
+{
+    const hestonParameters params = {0.04, 2.0, 0.04, 0.3, -0.7};
+    std::mt19937 polynomialGenerator(11);
+    std::mt19937 tableGenerator(11);
+    const double polynomial = hestonMonteCarloPrice(100.0, 100.0, 1.0, 0.03, params, CALL, 2000, 10,
+                                                    polynomialGenerator);
+    const double table = hestonMonteCarloPrice(100.0, 100.0, 1.0, 0.03, params, CALL, 2000, 10, tableGenerator,
+                                               CDF_TABLE);
+
+    // Same paths, so the prices differ only by the N(x) error.
+    EXPECT_NEAR(table, polynomial, 7.6e-8 * 200.0);
+    EXPECT_TRUE(std::isnan(hestonMonteCarloPrice(100.0, 100.0, 1.0, 0.03, params, static_cast<OptionType>(7), 10, 1,
+                                                 tableGenerator, CDF_TABLE)));
+}
+
+class normalCDFTableSimdTest : public testing::TestWithParam<SimdLevel>
+{
+};
+
+TEST_P(normalCDFTableSimdTest, KernelMatchesScalarTable)
+{
+    const simdKernelTable* kernels = simdKernelsFor(GetParam());
+    if (kernels == nullptr)
+    {
+        GTEST_SKIP() << simdLevelName(GetParam()) << " is not supported on this CPU";
+    }
+
+    std::vector<double> x;
+    for (double v = -9.0; v <= 9.0; v += 0.0173)
+    {
+        x.push_back(v);
+    }
+    x.push_back(normalCDFTable::upper);
+    x.push_back(normalCDFTable::lower);
+    x.push_back(std::numeric_limits<double>::infinity());
+    x.push_back(NAN);
+    std::vector<double> result(x.size());
+    kernels->normalCDFTabulated(x.data(), result.data(), x.size());
+
+    for (size_t i = 0; i + 1 < x.size(); ++i)
+    {
+        EXPECT_NEAR(result[i], normalCDFTabulated(x[i]), 1e-15) << x[i];
+    }
+    EXPECT_TRUE(std::isnan(result.back()));
+}
+
+INSTANTIATE_TEST_SUITE_P(AllLevels, normalCDFTableSimdTest, testing::Values(SCALAR, SSE42, AVX2, AVX512),
+                         [](const testing::TestParamInfo<SimdLevel>& info) { return std::string(simdLevelName(info.param)); });
@@ -210,4 +210,21 @@ TEST_F(optionGreeksModelTest, CalculateD1WithNaN)
 {
     model.calculateD1(NAN);
     EXPECT_TRUE(isnan(model.getD1()));
-}
\ No newline at end of file
+}
+
+TEST_F(optionGreeksModelTest, CalculateImpliedVolatilityFromMarketPrice)
+{
+    optionGreeksModel paramModel(100.0, 100.0, 1.0, 0.05, 0.3);
+    // The Black-Scholes price of this call at 20% volatility.
+    EXPECT_NEAR(paramModel.calculateImpliedVolatility(10.450583572185565), 0.2, 1e-12);
+    EXPECT_TRUE(isnan(paramModel.calculateImpliedVolatility(120.0)));
+    // A call worth the spot is at the upper bound, which has no volatility either.
+    EXPECT_TRUE(isnan(paramModel.calculateImpliedVolatility(100.0)));
+}
+
+TEST_F(optionGreeksModelTest, CalculateImpliedVolatilityInvertsModelPrice)
+{
+    optionGreeksModel paramModel(100.0, 100.0, 1.0, 0.05, 0.2);
+    EXPECT_NEAR(paramModel.calculateImpliedVolatility(), 0.2, 1e-6);
+    EXPECT_TRUE(isnan(model.calculateImpliedVolatility()));
+}
@@ -0,0 +1,56 @@
+#include "gtest/gtest.h"
+#include "../include/philox.h"
+#include <cmath>
+
+TEST(philoxTest, KnownAnswers)
+{
+    // The philox4x32-10 vectors of the Random123 distribution.
+    constexpr std::array<std::uint32_t, 4> zero = philox4x32({0, 0, 0, 0}, {0, 0});
+    static_assert(zero[0] == 0x6627e8d5u);
+    EXPECT_EQ(zero, (std::array<std::uint32_t, 4>{0x6627e8d5u, 0xe169c58du, 0xbc57ac4cu, 0x9b00dbd8u}));
+    EXPECT_EQ(philox4x32({0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu}, {0xffffffffu, 0xffffffffu}),
+              (std::array<std::uint32_t, 4>{0x408f276du, 0x41c83b0eu, 0xa20bc7c6u, 0x6d5451fdu}));
+    EXPECT_EQ(philox4x32({0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u}, {0xa4093822u, 0x299f31d0u}),
+              (std::array<std::uint32_t, 4>{0xd16cfe09u, 0x94fdccebu, 0x5001e420u, 0x24126ea1u}));
+}
+
+TEST(philoxTest, UniformsAreInsideTheOpenInterval)
+{
+    EXPECT_EQ(philoxUniform(0, 0), 0x1.0p-53);
+    EXPECT_EQ(philoxUniform(0xffffffffu, 0xffffffffu), 1.0 - 0x1.0p-53);
+    EXPECT_EQ(philoxUniform(0x80000000u, 0), 0.5 + 0x1.0p-53);
+}
+
+TEST(philoxTest, StreamsReplayTheirCounters)
+{
+    philoxNormalStream stream(7, 3);
+    for (std::uint64_t index = 0; index < 5; ++index)
+    {
+        const std::array<double, 2> pair = philoxNormalPair(7, 3, index);
+        EXPECT_EQ(stream(), pair[0]);
+        EXPECT_EQ(stream(), pair[1]);
+    }
+    EXPECT_NE(philoxNormalPair(7, 3, 0)[0], philoxNormalPair(7, 4, 0)[0]);
+    EXPECT_NE(philoxNormalPair(7, 3, 0)[0], philoxNormalPair(8, 3, 0)[0]);
+}
+
+TEST(philoxTest, NormalMoments)
+{
+    philoxNormalStream stream(42, 0);
+    const int count = 200000;
+    double sum = 0.0, squares = 0.0, fourth = 0.0, products = 0.0, previous = 0.0;
+    for (int i = 0; i < count; ++i)
+    {
+        const double z = stream();
+        sum += z;
+        squares += z * z;
+        fourth += z * z * z * z;
+        products += z * previous;
+        previous = z;
+    }
+    // Within about four standard errors.
+    EXPECT_NEAR(sum / count, 0.0, 0.01);
+    EXPECT_NEAR(squares / count, 1.0, 0.015);
+    EXPECT_NEAR(fourth / count, 3.0, 0.1);
+    EXPECT_NEAR(products / count, 0.0, 0.01);
+}
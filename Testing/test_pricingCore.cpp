@@ -0,0 +1,364 @@
+#include "gtest/gtest.h"
+#include "../include/pricingCore.h"
+#include "../include/blackScholesModel.h"
+#include "../include/hestonModel.h"
+#include "../include/philox.h"
+#include <cmath>
+#include <thread>
+#include <vector>
+
+TEST(pricingCoreTest, IntermediatesMatchModel)
+{
+    blackScholesModel model(16.2, 13.3, 18.0, 6.2, 0.45, PUT);
+    blackScholesTerms terms = blackScholesIntermediates(16.2, 13.3, 18.0, 6.2, 0.45);
+
+    EXPECT_DOUBLE_EQ(terms.d1, model.getD1());
+    EXPECT_DOUBLE_EQ(terms.d2, model.getD2());
+    EXPECT_DOUBLE_EQ(terms.K, model.getK());
+}
+
+TEST(pricingCoreTest, PriceMatchesModel)
+{
+    for (OptionType type : {CALL, PUT})
+    {
+        blackScholesModel model(100.0, 95.0, 0.5, 0.03, 0.25, type);
+        EXPECT_DOUBLE_EQ(blackScholesPrice(100.0, 95.0, 0.5, 0.03, 0.25, type), model.calculateOptionPrice());
+    }
+}
+
+TEST(pricingCoreTest, NaNPropagates)
+{
+    EXPECT_TRUE(std::isnan(normalCDF(NAN)));
+    EXPECT_TRUE(std::isnan(blackScholesD1(NAN, 100.0, 1.0, 0.05, 0.2)));
+    EXPECT_TRUE(std::isnan(blackScholesPrice(100.0, 100.0, 1.0, 0.05, NAN, CALL)));
+}
+
+TEST(pricingCoreTest, PutCallParity)
+{
+    double call = blackScholesPrice(100.0, 105.0, 1.0, 0.05, 0.2, CALL);
+    double put = blackScholesPrice(100.0, 105.0, 1.0, 0.05, 0.2, PUT);
+    EXPECT_NEAR(call - put, 100.0 - 105.0 * std::exp(-0.05), 1e-6);
+}
+
+TEST(pricingCoreTest, SharedModelAcrossThreads)
+{
+    const blackScholesModel model(100.0, 95.0, 0.5, 0.03, 0.25, CALL);
+    const double expected = model.calculateOptionPrice();
+
+    std::vector<double> prices(8);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < prices.size(); ++t)
+    {
+        threads.emplace_back([&model, &prices, t]() {
+            for (int i = 0; i < 1000; ++i)
+            {
+                prices[t] = model.calculateOptionPrice();
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (double price : prices)
+    {
+        EXPECT_EQ(price, expected);
+    }
+}
+
+TEST(pricingCoreTest, HestonSimulateVarianceZeroVolOfVol)
+{
+    // With sigma = 0 the Euler scheme is deterministic: V <- V + kappa (theta - V) dt.
+    hestonParameters params = {0.09, 2.0, 0.04, 0.0, -0.7};
+    std::mt19937 generator(1);
+    double expected = params.v0;
+    for (int i = 0; i < 100; ++i)
+    {
+        expected += params.kappa * (params.theta - expected) * 0.01;
+    }
+    EXPECT_NEAR(hestonSimulateVariance(params, 1.0, 100, generator), expected, 1e-12);
+}
+
+TEST(pricingCoreTest, HestonMonteCarloMatchesModelDelegation)
+{
+    hestonModel model(100.0, 100.0, 1.0, 0.05, 0.2, 0.04, 2.0, 0.04, 0.0, -0.7, CALL);
+    std::mt19937 generator(7);
+    double corePrice = hestonMonteCarloPrice(100.0, 100.0, 1.0, 0.05, model.getParameters(), CALL, 100, 50, generator);
+
+    // sigma = 0 removes the randomness, so the class and the core must agree exactly.
+    EXPECT_NEAR(model.calculateOptionPrice(true, 100, 50), corePrice, 1e-12);
+}
+
+TEST(pricingCoreTest, HestonAdjointMatchesBumpAndReprice)
+{
+    // The same seed for every run makes the price a smooth function of the inputs, path by path.
+    const hestonParameters params = {0.04, 1.5, 0.05, 0.3, -0.6};
+    const double S = 100.0, K = 105.0, T = 0.75, r = 0.02;
+    const int simulations = 1000, steps = 40;
+    auto price = [&](double spot, double rate, const hestonParameters& bumped) {
+        std::mt19937 generator(11);
+        return hestonMonteCarloPrice(spot, K, T, rate, bumped, PUT, simulations, steps, generator);
+    };
+
+    std::mt19937 generator(11);
+    const hestonSensitivities sensitivities = hestonMonteCarloSensitivities(S, K, T, r, params, PUT, simulations, steps, generator);
+    EXPECT_NEAR(sensitivities.price, price(S, r, params), 1e-12);
+
+    const double h = 1e-6;
+    EXPECT_NEAR(sensitivities.delta, (price(S + h, r, params) - price(S - h, r, params)) / (2 * h), 1e-6);
+    EXPECT_NEAR(sensitivities.riskFreeRate, (price(S, r + h, params) - price(S, r - h, params)) / (2 * h), 1e-4);
+
+    double hestonParameters::* const members[] = {&hestonParameters::v0, &hestonParameters::kappa,
+                                                  &hestonParameters::theta, &hestonParameters::sigma,
+                                                  &hestonParameters::rho};
+    const double adjoints[] = {sensitivities.v0, sensitivities.kappa, sensitivities.theta, sensitivities.sigma,
+                               sensitivities.rho};
+    for (int k = 0; k < 5; ++k)
+    {
+        hestonParameters up = params, down = params;
+        up.*members[k] += h;
+        down.*members[k] -= h;
+        const double difference = (price(S, r, up) - price(S, r, down)) / (2 * h);
+        EXPECT_NEAR(adjoints[k], difference, 1e-4 * (1.0 + std::abs(difference))) << k;
+    }
+}
+
+TEST(pricingCoreTest, HestonAdjointBlocksAndInvalidType)
+{
+    // More paths than one block, with a partial last block, and a variance that hits zero.
+    const hestonParameters params = {0.01, 0.5, 0.02, 0.8, 0.3};
+    std::mt19937 generator(5), reference(5);
+    const int simulations = 3 * hestonAdjointBlockPaths + 7;
+    const hestonSensitivities sensitivities = hestonMonteCarloSensitivities(100.0, 100.0, 1.0, 0.03, params, CALL,
+                                                                            simulations, 25, generator);
+    EXPECT_NEAR(sensitivities.price, hestonMonteCarloPrice(100.0, 100.0, 1.0, 0.03, params, CALL, simulations, 25, reference), 1e-12);
+    EXPECT_TRUE(std::isfinite(sensitivities.v0) && std::isfinite(sensitivities.rho));
+    EXPECT_GT(sensitivities.v0, 0.0);
+
+    EXPECT_TRUE(std::isnan(hestonMonteCarloSensitivities(100.0, 100.0, 1.0, 0.03, params, static_cast<OptionType>(7),
+                                                         10, 10, generator).delta));
+}
+
+TEST(pricingCoreTest, HestonAdjointAtPerfectCorrelation)
+{
+    // sqrt(1 - rho^2) has no derivative at |rho| = 1: only the rho sensitivity is NaN.
+    for (double rho : {1.0, -1.0})
+    {
+        const hestonParameters params = {0.04, 2.0, 0.04, 0.3, rho};
+        const hestonSensitivities sensitivities = hestonMonteCarloSensitivities(100.0, 100.0, 1.0, 0.05, params, CALL,
+                                                                                500, 20, 3u);
+        EXPECT_TRUE(std::isnan(sensitivities.rho)) << rho;
+        EXPECT_TRUE(std::isfinite(sensitivities.price) && std::isfinite(sensitivities.v0)) << rho;
+        EXPECT_TRUE(std::isfinite(sensitivities.sigma) && std::isfinite(sensitivities.kappa)) << rho;
+    }
+}
+
+TEST(pricingCoreTest, HestonMonteCarloIndependentOfThreadCount)
+{
+    const hestonParameters params = {0.04, 2.0, 0.04, 0.3, -0.7};
+    const int simulations = 5 * hestonPathsPerStream + 13;
+    auto price = [&](unsigned threadCount) {
+        std::mt19937 generator(3);
+        return hestonMonteCarloPrice(100.0, 95.0, 1.0, 0.05, params, CALL, simulations, 20, generator,
+                                     CDF_POLYNOMIAL, threadCount);
+    };
+    auto sensitivities = [&](unsigned threadCount) {
+        std::mt19937 generator(3);
+        return hestonMonteCarloSensitivities(100.0, 95.0, 1.0, 0.05, params, CALL, simulations, 20, generator,
+                                             threadCount);
+    };
+
+    const double serial = price(1);
+    const hestonSensitivities serialSensitivities = sensitivities(1);
+    EXPECT_NEAR(serialSensitivities.price, serial, 1e-12);
+    for (unsigned threadCount : {2u, 3u, 8u, 0u})
+    {
+        EXPECT_EQ(price(threadCount), serial) << threadCount;
+        const hestonSensitivities parallel = sensitivities(threadCount);
+        EXPECT_EQ(parallel.price, serialSensitivities.price) << threadCount;
+        EXPECT_EQ(parallel.v0, serialSensitivities.v0) << threadCount;
+        EXPECT_EQ(parallel.rho, serialSensitivities.rho) << threadCount;
+    }
+
+    // Another generator state gives other paths.
+    std::mt19937 generator(4);
+    EXPECT_NE(hestonMonteCarloPrice(100.0, 95.0, 1.0, 0.05, params, CALL, simulations, 20, generator), serial);
+    EXPECT_TRUE(std::isnan(hestonMonteCarloPrice(100.0, 95.0, 1.0, 0.05, params, CALL, 0, 20, generator)));
+}
+
+TEST(pricingCoreTest, HestonCounterBasedMonteCarloIsReproducible)
+{
+    const hestonParameters params = {0.04, 2.0, 0.04, 0.3, -0.7};
+    const int simulations = 4 * hestonPathsPerStream + 100;
+    const double serial = hestonMonteCarloPrice(100.0, 95.0, 1.0, 0.05, params, PUT, simulations, 20, 99u,
+                                                CDF_POLYNOMIAL, 1);
+    const hestonSensitivities serialSensitivities = hestonMonteCarloSensitivities(100.0, 95.0, 1.0, 0.05, params, PUT,
+                                                                                  simulations, 20, 99u, 1);
+    EXPECT_NEAR(serialSensitivities.price, serial, 1e-12);
+    for (unsigned threadCount : {2u, 5u, 0u})
+    {
+        EXPECT_EQ(hestonMonteCarloPrice(100.0, 95.0, 1.0, 0.05, params, PUT, simulations, 20, 99u, CDF_POLYNOMIAL,
+                                        threadCount), serial) << threadCount;
+        const hestonSensitivities parallel = hestonMonteCarloSensitivities(100.0, 95.0, 1.0, 0.05, params, PUT,
+                                                                           simulations, 20, 99u, threadCount);
+        EXPECT_EQ(parallel.price, serialSensitivities.price) << threadCount;
+        EXPECT_EQ(parallel.sigma, serialSensitivities.sigma) << threadCount;
+    }
+
+    // Step i of path 0 uses the normal pair of counter (0, i).
+    double Vt = params.v0;
+    const double dt = 1.0 / 20;
+    for (int i = 0; i < 20; ++i)
+    {
+        const std::array<double, 2> normals = philoxNormalPair(99u, 0, i);
+        const double Z2 = params.rho * normals[0] + std::sqrt(1.0 - params.rho * params.rho) * normals[1];
+        Vt += params.kappa * (params.theta - Vt) * dt + params.sigma * std::sqrt(Vt * dt) * Z2;
+        Vt = std::max(0.0, Vt);
+    }
+    EXPECT_NEAR(hestonMonteCarloPrice(100.0, 95.0, 1.0, 0.05, params, PUT, 1, 20, 99u),
+                blackScholesPrice(100.0, 95.0, 1.0, 0.05, std::sqrt(Vt), PUT), 1e-12);
+    EXPECT_NE(hestonMonteCarloPrice(100.0, 95.0, 1.0, 0.05, params, PUT, simulations, 20, 100u), serial);
+}
+
+TEST(pricingCoreTest, HestonTerminalVariancePrice)
+{
+    // The density integrates to one: a call struck at zero is worth the spot, and put-call parity holds.
+    const hestonParameters params = {0.04, 1.5, 0.04, 0.9, -0.7};
+    EXPECT_NEAR(hestonTerminalVariancePrice(100.0, 1e-9, 1.0, 0.03, params, CALL), 100.0, 1e-4);
+    EXPECT_NEAR(hestonTerminalVariancePrice(100.0, 100.0, 1.0, 0.03, params, CALL)
+                    - hestonTerminalVariancePrice(100.0, 100.0, 1.0, 0.03, params, PUT),
+                100.0 - 100.0 * std::exp(-0.03), 1e-4);
+
+    // Without vol of vol the variance is its mean, theta + (v0 - theta) e^{-kappa T}, and nearly so with little.
+    hestonParameters deterministic = {0.09, 2.0, 0.04, 0.0, -0.7};
+    const double variance = 0.04 + 0.05 * std::exp(-2.0 * 0.5);
+    const double expected = blackScholesPrice(100.0, 95.0, 0.5, 0.03, std::sqrt(variance), PUT);
+    EXPECT_DOUBLE_EQ(hestonTerminalVariancePrice(100.0, 95.0, 0.5, 0.03, deterministic, PUT), expected);
+    deterministic.sigma = 0.01;
+    EXPECT_NEAR(hestonTerminalVariancePrice(100.0, 95.0, 0.5, 0.03, deterministic, PUT), expected, 1e-3);
+
+    deterministic.kappa = 0.0;
+    EXPECT_TRUE(std::isnan(hestonTerminalVariancePrice(100.0, 95.0, 0.5, 0.03, deterministic, PUT)));
+    EXPECT_TRUE(std::isnan(hestonTerminalVariancePrice(100.0, 95.0, 0.5, 0.03, params, static_cast<OptionType>(7))));
+}
+
+TEST(pricingCoreTest, HestonQuadraticExponentialBias)
+{
+    // Far from the Feller condition, where full-truncation Euler is still biased with many steps.
+    const hestonParameters params = {0.04, 1.5, 0.04, 0.9, -0.7};
+    const double reference = hestonTerminalVariancePrice(100.0, 100.0, 1.0, 0.03, params, CALL);
+    const double qe = hestonMonteCarloPrice(100.0, 100.0, 1.0, 0.03, params, CALL, 100000, 20, 1u, CDF_POLYNOMIAL, 0,
+                                            HESTON_QE);
+    const double euler = hestonMonteCarloPrice(100.0, 100.0, 1.0, 0.03, params, CALL, 100000, 20, 1u);
+    EXPECT_NEAR(qe, reference, 0.06);
+    EXPECT_GT(euler - reference, 1.0);
+
+    std::mt19937 generator(9);
+    EXPECT_NEAR(hestonMonteCarloPrice(100.0, 100.0, 1.0, 0.03, params, CALL, 20000, 20, generator, CDF_POLYNOMIAL, 0,
+                                      HESTON_QE), reference, 0.15);
+
+    // Without vol of vol every step lands on the conditional mean, so one step is exact.
+    const hestonParameters deterministic = {0.09, 2.0, 0.04, 0.0, -0.7};
+    EXPECT_NEAR(hestonSimulateVariance(deterministic, 1.0, 1, generator, HESTON_QE), 0.04 + 0.05 * std::exp(-2.0),
+                1e-15);
+}
+
+TEST(pricingCoreTest, NormalCDFFromPDFMatchesNormalCDF)
+{
+    for (double d = -8.0; d <= 8.0; d += 0.25)
+    {
+        EXPECT_EQ(normalCDFFromPDF(d, normalPDF(d)), normalCDF(d)) << d;
+    }
+}
+
+TEST(pricingCoreTest, FusedGreeksMatchFiniteDifferences)
+{
+    const double S = 100.0, K = 95.0, T = 0.75, r = 0.03, vol = 0.25;
+    const double h = 1e-4;
+
+    for (OptionType type : {CALL, PUT})
+    {
+        blackScholesGreeks greeks = blackScholesPriceAndGreeks(S, K, T, r, vol, type);
+        auto price = [&](double s, double t, double rate, double v) { return blackScholesPrice(s, K, t, rate, v, type); };
+
+        EXPECT_DOUBLE_EQ(greeks.price, price(S, T, r, vol));
+        // The analytic Greeks differentiate the exact N(x); the finite differences see the 7.5e-8
+        // error of the polynomial approximation, amplified by 1 / h.
+        const double tolerance = 5e-5;
+        EXPECT_NEAR(greeks.delta, (price(S + h, T, r, vol) - price(S - h, T, r, vol)) / (2 * h), tolerance);
+        EXPECT_NEAR(greeks.gamma, (price(S + h, T, r, vol) - 2 * price(S, T, r, vol) + price(S - h, T, r, vol)) / (h * h), 1e-2);
+        EXPECT_NEAR(greeks.vega, (price(S, T, r, vol + h) - price(S, T, r, vol - h)) / (2 * h), tolerance * greeks.vega);
+        EXPECT_NEAR(greeks.theta, -(price(S, T + h, r, vol) - price(S, T - h, r, vol)) / (2 * h), tolerance * std::abs(greeks.theta));
+        EXPECT_NEAR(greeks.rho, (price(S, T, r + h, vol) - price(S, T, r - h, vol)) / (2 * h), tolerance * std::abs(greeks.rho));
+    }
+}
+
+TEST(pricingCoreTest, FusedGreeksPutCallRelations)
+{
+    blackScholesGreeks call = blackScholesPriceAndGreeks(100.0, 105.0, 1.0, 0.05, 0.2, CALL);
+    blackScholesGreeks put = blackScholesPriceAndGreeks(100.0, 105.0, 1.0, 0.05, 0.2, PUT);
+
+    EXPECT_NEAR(call.delta - put.delta, 1.0, 1e-7);
+    EXPECT_DOUBLE_EQ(call.gamma, put.gamma);
+    EXPECT_DOUBLE_EQ(call.vega, put.vega);
+    EXPECT_NEAR(call.rho - put.rho, 105.0 * std::exp(-0.05), 1e-6);
+}
+
+TEST(pricingCoreTest, TypedPriceMatchesRuntimeType)
+{
+    EXPECT_EQ(blackScholesPrice<CALL>(100.0, 95.0, 0.5, 0.03, 0.25), blackScholesPrice(100.0, 95.0, 0.5, 0.03, 0.25, CALL));
+    EXPECT_EQ(blackScholesPrice<PUT>(100.0, 95.0, 0.5, 0.03, 0.25), blackScholesPrice(100.0, 95.0, 0.5, 0.03, 0.25, PUT));
+    EXPECT_TRUE(std::isnan(blackScholesPrice(100.0, 95.0, 0.5, 0.03, 0.25, static_cast<OptionType>(7))));
+}
+
+TEST(pricingCoreTest, GreekMaskComputesOnlySelectedResults)
+{
+    blackScholesGreeks all = blackScholesPriceAndGreeks<PUT>(100.0, 95.0, 0.5, 0.03, 0.25);
+    blackScholesGreeks some = blackScholesPriceAndGreeks<PUT, GREEK_DELTA | GREEK_RHO>(100.0, 95.0, 0.5, 0.03, 0.25);
+
+    EXPECT_TRUE(std::isnan(some.price));
+    EXPECT_EQ(some.delta, all.delta);
+    EXPECT_TRUE(std::isnan(some.gamma));
+    EXPECT_TRUE(std::isnan(some.vega));
+    EXPECT_TRUE(std::isnan(some.theta));
+    EXPECT_EQ(some.rho, all.rho);
+
+    blackScholesGreeks vegaOnly = blackScholesPriceAndGreeks<CALL, GREEK_VEGA>(100.0, 95.0, 0.5, 0.03, 0.25);
+    EXPECT_EQ(vegaOnly.vega, all.vega);
+}
+
+namespace
+{
+    // A reference grid of at-the-money call prices over expiries, built by the compiler.
+    constexpr auto atmCallGrid = constexprMath::tabulate<41>(0.05, 2.05, [](double T) {
+        return blackScholesPrice<CALL>(100.0, 100.0, T, 0.03, 0.2);
+    });
+}
+
+static_assert(constexprMath::abs(normalCDF(0.0) - 0.5) < 1e-8);
+static_assert(normalCDF(10.0) > normalCDF(1.0) && normalCDF(-10.0) < normalCDF(-1.0));
+static_assert(constexprMath::abs(blackScholesPrice(100.0, 105.0, 1.0, 0.05, 0.2, CALL)
+                                 - blackScholesPrice(100.0, 105.0, 1.0, 0.05, 0.2, PUT)
+                                 - (100.0 - 105.0 * constexprMath::exp(-0.05))) < 1e-6);
+static_assert(blackScholesPriceAndGreeks<CALL, GREEK_DELTA>(100.0, 100.0, 1.0, 0.05, 0.2).delta > 0.5);
+
+TEST(pricingCoreTest, CompileTimeGridMatchesRuntime)
+{
+    for (size_t i = 0; i < atmCallGrid.size(); ++i)
+    {
+        const double T = 0.05 + 0.05 * i;
+        const double runtime = blackScholesPrice(100.0, 100.0, T, 0.03, 0.2, CALL);
+        EXPECT_NEAR(atmCallGrid[i], runtime, 1e-13 * runtime) << T;
+    }
+}
+
+TEST(pricingCoreTest, CompileTimeIntermediates)
+{
+    constexpr blackScholesTerms terms = blackScholesIntermediates(16.2, 13.3, 18.0, 6.2, 0.45);
+    blackScholesTerms runtime = blackScholesIntermediates(16.2, 13.3, 18.0, 6.2, 0.45);
+
+    EXPECT_NEAR(terms.d1, runtime.d1, 1e-14 * std::abs(runtime.d1));
+    EXPECT_NEAR(terms.d2, runtime.d2, 1e-14 * std::abs(runtime.d2));
+    EXPECT_NEAR(terms.K, runtime.K, 1e-15);
+}
@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+#include "../include/randomNormals.h"
+#include "../include/philox.h"
+#include <cmath>
+#include <vector>
+
+TEST(randomNormalsTest, BufferFollowsStreamDrawOrder)
+{
+    // More than one internal chunk, and an odd count.
+    const std::size_t count = 1001;
+    std::vector<double> output(count + 1, -100.0);
+    philoxNormals(5, 9, 3, count, output.data());
+
+    philoxNormalStream stream(5, 9);
+    for (int skipped = 0; skipped < 6; ++skipped)
+    {
+        stream();
+    }
+    for (std::size_t j = 0; j < count; ++j)
+    {
+        const double expected = stream();
+        EXPECT_NEAR(output[j], expected, 1e-14 * std::max(1.0, std::abs(expected))) << j;
+    }
+    EXPECT_EQ(output[count], -100.0);
+}
+
+TEST(randomNormalsTest, PairsOfAnyRangeAreTheSame)
+{
+    std::vector<double> first(600), second(600), partFirst(100), partSecond(100);
+    philoxNormalPairs(77, 1, 0, first.size(), first.data(), second.data());
+    philoxNormalPairs(77, 1, 250, partFirst.size(), partFirst.data(), partSecond.data());
+    for (std::size_t k = 0; k < partFirst.size(); ++k)
+    {
+        EXPECT_EQ(partFirst[k], first[250 + k]);
+        EXPECT_EQ(partSecond[k], second[250 + k]);
+    }
+}
+
+TEST(randomNormalsTest, Moments)
+{
+    const std::size_t count = 400000;
+    std::vector<double> normals(count);
+    philoxNormals(123, 0, 0, count, normals.data());
+    double sum = 0.0, squares = 0.0, fourth = 0.0, tail = 0.0;
+    for (double z : normals)
+    {
+        sum += z;
+        squares += z * z;
+        fourth += z * z * z * z;
+        tail += z > 1.959963984540054 ? 1.0 : 0.0;
+    }
+    // Within about four standard errors.
+    EXPECT_NEAR(sum / count, 0.0, 0.0065);
+    EXPECT_NEAR(squares / count, 1.0, 0.01);
+    EXPECT_NEAR(fourth / count, 3.0, 0.07);
+    EXPECT_NEAR(tail / count, 0.025, 0.001);
+}
@@ -0,0 +1,370 @@
+#include "gtest/gtest.h"
+#include "../include/simdMath.h"
+#include "../include/cpuDispatch.h"
+#include "../include/blackScholesModel.h"
+#include "../include/pricingCore.h"
+#include "../include/philox.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+class simdMathTest : public testing::TestWithParam<SimdLevel>
+{
+    protected:
+        void SetUp() override
+        {
+            kernels = simdKernelsFor(GetParam());
+            if (kernels == nullptr)
+            {
+                GTEST_SKIP() << simdLevelName(GetParam()) << " is not supported on this CPU";
+            }
+        }
+
+        const simdKernelTable* kernels = nullptr;
+};
+
+TEST_P(simdMathTest, ExpMatchesStd)
+{
+    std::vector<double> x;
+    for (double v = -745.0; v <= 709.0; v += 0.37)
+    {
+        x.push_back(v);
+    }
+    std::vector<double> result(x.size());
+    kernels->exp(x.data(), result.data(), x.size());
+
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        double expected = std::exp(x[i]);
+        if (expected < std::numeric_limits<double>::min())
+        {
+            EXPECT_NEAR(result[i], expected, 4 * std::numeric_limits<double>::denorm_min()) << x[i];
+        }
+        else
+        {
+            EXPECT_NEAR(result[i] / expected, 1.0, 4e-16) << x[i];
+        }
+    }
+}
+
+TEST_P(simdMathTest, ExpSpecialValues)
+{
+    std::vector<double> x = {0.0, 800.0, -800.0, std::numeric_limits<double>::infinity(),
+                             -std::numeric_limits<double>::infinity(), NAN};
+    std::vector<double> result(x.size());
+    kernels->exp(x.data(), result.data(), x.size());
+
+    EXPECT_EQ(result[0], 1.0);
+    EXPECT_TRUE(std::isinf(result[1]));
+    EXPECT_EQ(result[2], 0.0);
+    EXPECT_TRUE(std::isinf(result[3]));
+    EXPECT_EQ(result[4], 0.0);
+    EXPECT_TRUE(std::isnan(result[5]));
+}
+
+TEST_P(simdMathTest, LogMatchesStd)
+{
+    std::vector<double> x;
+    for (double v = 1e-310; v < 1e300; v *= 1.37)
+    {
+        x.push_back(v);
+    }
+    for (double v = 0.5; v < 2.0; v += 1e-3)
+    {
+        x.push_back(v);
+    }
+    std::vector<double> result(x.size());
+    kernels->log(x.data(), result.data(), x.size());
+
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        EXPECT_NEAR(result[i], std::log(x[i]), 2.3e-16 * std::max(1.0, std::abs(std::log(x[i])))) << x[i];
+    }
+}
+
+TEST_P(simdMathTest, LogSpecialValues)
+{
+    std::vector<double> x = {1.0, 0.0, -1.0, std::numeric_limits<double>::infinity(), NAN};
+    std::vector<double> result(x.size());
+    kernels->log(x.data(), result.data(), x.size());
+
+    EXPECT_EQ(result[0], 0.0);
+    EXPECT_TRUE(std::isinf(result[1]) && result[1] < 0.0);
+    EXPECT_TRUE(std::isnan(result[2]));
+    EXPECT_TRUE(std::isinf(result[3]) && result[3] > 0.0);
+    EXPECT_TRUE(std::isnan(result[4]));
+}
+
+TEST_P(simdMathTest, NormalCDFWithinDocumentedError)
+{
+    blackScholesModel model;
+    std::vector<double> x;
+    for (double v = -40.0; v <= 40.0; v += 0.013)
+    {
+        x.push_back(v);
+    }
+    x.push_back(NAN);
+    std::vector<double> result(x.size());
+    kernels->normalCDF(x.data(), result.data(), x.size());
+
+    for (size_t i = 0; i + 1 < x.size(); ++i)
+    {
+        EXPECT_NEAR(result[i], 0.5 * std::erfc(-x[i] / std::sqrt(2.0)), 7.5e-8) << x[i];
+        EXPECT_NEAR(result[i], model.normalCDF(x[i]), 1e-15) << x[i];
+    }
+    EXPECT_TRUE(std::isnan(result.back()));
+}
+
+TEST_P(simdMathTest, BlackScholesPriceMatchesModel)
+{
+    // Odd count so every level exercises its partial tail block.
+    std::vector<double> S = {16.2, 5.6, 100.0, 50.0, 100.0, 80.0, 120.0, 100.0, 100.0, 60.0, 100.0};
+    std::vector<double> K = {13.3, 4.2, 100.0, 45.0, 100.0, 100.0, 100.0, 90.0, 110.0, 65.0, 100.0};
+    std::vector<double> T = {18.0, 45.3, 1.0, 0.0822, 0.25, 0.5, 2.0, 1.5, 0.1, 3.0, -1.0};
+    std::vector<double> r = {6.2, 3.14, 0.05, 0.05, 0.01, 0.02, 0.03, 0.0, 0.04, 0.05, 0.05};
+    std::vector<double> vol = {0.45, 0.27, 0.2, 0.2, 0.3, 0.4, 0.15, 0.25, 1.5, 0.35, 0.2};
+    std::vector<OptionType> type = {PUT, CALL, PUT, CALL, CALL, PUT, CALL, PUT, CALL, PUT, CALL};
+
+    std::vector<double> prices(S.size());
+    kernels->blackScholesPrice(S.size(), S.data(), K.data(), T.data(), r.data(), vol.data(), type.data(), prices.data());
+
+    for (size_t i = 0; i < S.size(); ++i)
+    {
+        blackScholesModel model(S[i], K[i], T[i], r[i], vol[i], type[i]);
+        double expected = model.calculateOptionPrice();
+        if (isnan(expected))
+        {
+            EXPECT_TRUE(isnan(prices[i])) << i;
+        }
+        else
+        {
+            EXPECT_NEAR(prices[i], expected, 1e-12 * std::max(1.0, expected)) << i;
+        }
+    }
+}
+
+TEST_P(simdMathTest, BlackScholesGreeksMatchPricingCore)
+{
+    std::vector<double> S = {16.2, 5.6, 100.0, 50.0, 100.0, 80.0, 120.0, 100.0, 100.0, 60.0, 100.0};
+    std::vector<double> K = {13.3, 4.2, 100.0, 45.0, 100.0, 100.0, 100.0, 90.0, 110.0, 65.0, 100.0};
+    std::vector<double> T = {18.0, 45.3, 1.0, 0.0822, 0.25, 0.5, 2.0, 1.5, 0.1, 3.0, -1.0};
+    std::vector<double> r = {6.2, 3.14, 0.05, 0.05, 0.01, 0.02, 0.03, 0.0, 0.04, 0.05, 0.05};
+    std::vector<double> vol = {0.45, 0.27, 0.2, 0.2, 0.3, 0.4, 0.15, 0.25, 0.5, 0.35, 0.2};
+    std::vector<OptionType> type = {PUT, CALL, PUT, CALL, CALL, PUT, CALL, PUT, CALL, PUT, CALL};
+
+    const size_t n = S.size();
+    std::vector<double> price(n), delta(n), gamma(n), vega(n), theta(n), rho(n);
+    kernels->blackScholesGreeks(n, S.data(), K.data(), T.data(), r.data(), vol.data(), type.data(), price.data(),
+                                delta.data(), gamma.data(), vega.data(), theta.data(), rho.data());
+
+    for (size_t i = 0; i + 1 < n; ++i)
+    {
+        blackScholesGreeks expected = blackScholesPriceAndGreeks(S[i], K[i], T[i], r[i], vol[i], type[i]);
+        EXPECT_NEAR(price[i], expected.price, 1e-12 * std::max(1.0, std::abs(expected.price))) << i;
+        EXPECT_NEAR(delta[i], expected.delta, 1e-12) << i;
+        EXPECT_NEAR(gamma[i], expected.gamma, 1e-12 * std::max(1.0, expected.gamma)) << i;
+        EXPECT_NEAR(vega[i], expected.vega, 1e-12 * std::max(1.0, expected.vega)) << i;
+        EXPECT_NEAR(theta[i], expected.theta, 1e-12 * std::max(1.0, std::abs(expected.theta))) << i;
+        EXPECT_NEAR(rho[i], expected.rho, 1e-12 * std::max(1.0, std::abs(expected.rho))) << i;
+    }
+    for (double* column : {price.data(), delta.data(), gamma.data(), vega.data(), theta.data(), rho.data()})
+    {
+        EXPECT_TRUE(std::isnan(column[n - 1]));
+    }
+}
+
+TEST_P(simdMathTest, TypedKernelsMatchMixedKernels)
+{
+    std::vector<double> S = {16.2, 5.6, 100.0, 50.0, 100.0, 80.0, 120.0, 100.0, 100.0, 60.0, 100.0};
+    std::vector<double> K = {13.3, 4.2, 100.0, 45.0, 100.0, 100.0, 100.0, 90.0, 110.0, 65.0, 100.0};
+    std::vector<double> T = {18.0, 45.3, 1.0, 0.0822, 0.25, 0.5, 2.0, 1.5, 0.1, 3.0, -1.0};
+    std::vector<double> r = {6.2, 3.14, 0.05, 0.05, 0.01, 0.02, 0.03, 0.0, 0.04, 0.05, 0.05};
+    std::vector<double> vol = {0.45, 0.27, 0.2, 0.2, 0.3, 0.4, 0.15, 0.25, 0.5, 0.35, 0.2};
+    const size_t n = S.size();
+
+    for (OptionType type : {CALL, PUT})
+    {
+        std::vector<OptionType> types(n, type);
+        std::vector<double> mixed(n), typed(n);
+        kernels->blackScholesPrice(n, S.data(), K.data(), T.data(), r.data(), vol.data(), types.data(), mixed.data());
+        kernels->blackScholesPriceOf[type](n, S.data(), K.data(), T.data(), r.data(), vol.data(), typed.data());
+
+        std::vector<double> price(n), delta(n), gamma(n), vega(n), theta(n), rho(n);
+        std::vector<double> price2(n), delta2(n), gamma2(n), vega2(n), theta2(n), rho2(n);
+        kernels->blackScholesGreeks(n, S.data(), K.data(), T.data(), r.data(), vol.data(), types.data(), price.data(),
+                                    delta.data(), gamma.data(), vega.data(), theta.data(), rho.data());
+        kernels->blackScholesGreeksOf[type](n, S.data(), K.data(), T.data(), r.data(), vol.data(), price2.data(),
+                                            delta2.data(), gamma2.data(), vega2.data(), theta2.data(), rho2.data());
+
+        for (size_t i = 0; i + 1 < n; ++i)
+        {
+            EXPECT_NEAR(typed[i], mixed[i], 1e-13 * std::max(1.0, mixed[i])) << i;
+            EXPECT_NEAR(price2[i], price[i], 1e-13 * std::max(1.0, price[i])) << i;
+            EXPECT_DOUBLE_EQ(delta2[i], delta[i]) << i;
+            EXPECT_DOUBLE_EQ(gamma2[i], gamma[i]) << i;
+            EXPECT_DOUBLE_EQ(vega2[i], vega[i]) << i;
+            EXPECT_NEAR(theta2[i], theta[i], 1e-13 * std::max(1.0, std::abs(theta[i]))) << i;
+            EXPECT_NEAR(rho2[i], rho[i], 1e-13 * std::max(1.0, std::abs(rho[i]))) << i;
+        }
+        EXPECT_TRUE(std::isnan(typed[n - 1]));
+        EXPECT_TRUE(std::isnan(delta2[n - 1]));
+    }
+}
+
+TEST_P(simdMathTest, FloatKernelsMatchDouble)
+{
+    std::vector<float> x;
+    for (float v = -80.0f; v <= 80.0f; v += 0.0625f)
+    {
+        x.push_back(v);
+    }
+    std::vector<float> expResult(x.size()), cdfResult(x.size());
+    kernels->expFloat(x.data(), expResult.data(), x.size());
+    kernels->normalCDFFloat(x.data(), cdfResult.data(), x.size());
+    for (size_t i = 0; i < x.size(); ++i)
+    {
+        const double expected = std::exp(static_cast<double>(x[i]));
+        EXPECT_NEAR(expResult[i] / expected, 1.0, 2.5e-7) << x[i];
+        EXPECT_NEAR(cdfResult[i], normalCDF(x[i]), 2.5e-7) << x[i];
+    }
+
+    std::vector<float> y;
+    for (float v = 1e-30f; v < 1e30f; v *= 1.37f)
+    {
+        y.push_back(v);
+    }
+    std::vector<float> logResult(y.size());
+    kernels->logFloat(y.data(), logResult.data(), y.size());
+    for (size_t i = 0; i < y.size(); ++i)
+    {
+        const double expected = std::log(static_cast<double>(y[i]));
+        EXPECT_NEAR(logResult[i], expected, 2.5e-7 * std::max(1.0, std::abs(expected))) << y[i];
+    }
+}
+
+TEST_P(simdMathTest, FloatBlackScholesWithinItsErrorEstimate)
+{
+    std::vector<float> S = {16.2f, 5.6f, 100.0f, 50.0f, 100.0f, 80.0f, 120.0f, 100.0f, 100.0f, 60.0f, 100.0f};
+    std::vector<float> K = {13.3f, 4.2f, 100.0f, 45.0f, 100.0f, 100.0f, 100.0f, 90.0f, 110.0f, 65.0f, 100.0f};
+    std::vector<float> T = {18.0f, 45.3f, 1.0f, 0.0822f, 0.25f, 0.5f, 2.0f, 1.5f, 0.1f, 3.0f, -1.0f};
+    std::vector<float> r = {6.2f, 3.14f, 0.05f, 0.05f, 0.01f, 0.02f, 0.03f, 0.0f, 0.04f, 0.05f, 0.05f};
+    std::vector<float> vol = {0.45f, 0.27f, 0.2f, 0.2f, 0.3f, 0.4f, 0.15f, 0.25f, 0.5f, 0.35f, 0.2f};
+    std::vector<OptionType> type = {PUT, CALL, PUT, CALL, CALL, PUT, CALL, PUT, CALL, PUT, CALL};
+    const size_t n = S.size();
+
+    std::vector<float> price(n), relativeError(n);
+    kernels->blackScholesPriceFloat(n, S.data(), K.data(), T.data(), r.data(), vol.data(), type.data(),
+                                    price.data(), relativeError.data());
+
+    for (size_t i = 0; i + 1 < n; ++i)
+    {
+        const double expected = blackScholesPrice(S[i], K[i], T[i], r[i], vol[i], type[i]);
+        if (expected == 0.0)
+        {
+            // Underflows in both precisions; the estimate is infinite.
+            EXPECT_EQ(price[i], 0.0f) << i;
+            continue;
+        }
+        EXPECT_LE(std::abs(price[i] - expected), relativeError[i] * std::abs(expected)) << i;
+    }
+    EXPECT_TRUE(std::isnan(price[n - 1]));
+    EXPECT_TRUE(std::isnan(relativeError[n - 1]));
+}
+
+TEST_P(simdMathTest, PhiloxNormalPairsMatchScalarBoxMuller)
+{
+    // Several blocks and a partial one, at a counter that carries into the high word; 203 random angles
+    // cover every quarter turn of the sine and cosine.
+    const std::size_t count = 203;
+    const std::uint64_t index = 0xFFFFFFFFull - 100;
+    std::vector<double> first(count), second(count);
+    kernels->philoxNormalPairs(2024, 17, index, count, first.data(), second.data());
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        const std::array<double, 2> expected = philoxNormalPair(2024, 17, index + k);
+        EXPECT_NEAR(first[k], expected[0], 1e-14 * std::max(1.0, std::abs(expected[0]))) << k;
+        EXPECT_NEAR(second[k], expected[1], 1e-14 * std::max(1.0, std::abs(expected[1]))) << k;
+    }
+}
+
+TEST_P(simdMathTest, HestonEulerVarianceMatchesScalarSteps)
+{
+    // A partial block, with paths whose counters carry into the high word, and a v0 the first step truncates.
+    const std::size_t count = 21;
+    const std::uint64_t firstPath = 0xFFFFFFFFull - 10;
+    const int steps = 40;
+    const double v0 = -0.01, kappa = 1.5, theta = 0.05, sigma = 0.6, rho = -0.8, dt = 0.025;
+    std::vector<double> variance(count + 1, -1.0);
+    kernels->hestonEulerVariance(7, firstPath, count, v0, kappa, theta, sigma, rho, dt, steps, variance.data());
+
+    int truncated = 0;
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        double Vt = v0;
+        for (int i = 0; i < steps; ++i)
+        {
+            const std::array<double, 2> normals = philoxNormalPair(7, firstPath + k, i);
+            const double Z2 = rho * normals[0] + std::sqrt(1.0 - rho * rho) * normals[1];
+            const double positive = std::max(0.0, Vt);
+            Vt = std::max(0.0, Vt + kappa * (theta - positive) * dt + sigma * std::sqrt(positive * dt) * Z2);
+            truncated += Vt == 0.0;
+        }
+        EXPECT_NEAR(variance[k], Vt, 1e-13) << k;
+    }
+    EXPECT_GT(truncated, 0);
+    EXPECT_EQ(variance[count], -1.0);
+}
+
+TEST_P(simdMathTest, HestonQEVarianceMatchesScalarSteps)
+{
+    // Vol of vol high enough that both the quadratic and the exponential branch are taken, and some zeros.
+    const std::size_t count = 21;
+    const std::uint64_t firstPath = 1000;
+    const int steps = 20;
+    const double v0 = 0.04, kappa = 1.5, theta = 0.04, sigma = 0.9, rho = -0.7, dt = 0.05;
+    const double decay = std::exp(-kappa * dt);
+    const double mean = theta * (1.0 - decay);
+    const double varianceSlope = sigma * sigma * decay * (1.0 - decay) / kappa;
+    const double varianceConstant = 0.5 * theta * sigma * sigma * (1.0 - decay) * (1.0 - decay) / kappa;
+    std::vector<double> variance(count + 1, -1.0);
+    kernels->hestonQEVariance(7, firstPath, count, v0, decay, mean, varianceSlope, varianceConstant, rho, steps,
+                              variance.data());
+
+    int quadratic = 0, exponential = 0, zero = 0;
+    for (std::size_t k = 0; k < count; ++k)
+    {
+        double Vt = v0;
+        for (int i = 0; i < steps; ++i)
+        {
+            const std::array<double, 2> normals = philoxNormalPair(7, firstPath + k, i);
+            const double z = rho * normals[0] + std::sqrt(1.0 - rho * rho) * normals[1];
+            const double m = mean + decay * Vt;
+            const double psi = (varianceSlope * Vt + varianceConstant) / (m * m);
+            if (psi <= 1.5)
+            {
+                const double b2 = 2.0 / psi - 1.0 + std::sqrt(2.0 / psi * (2.0 / psi - 1.0));
+                Vt = m / (1.0 + b2) * (std::sqrt(b2) + z) * (std::sqrt(b2) + z);
+                ++quadratic;
+            }
+            else
+            {
+                const double p = (psi - 1.0) / (psi + 1.0);
+                const double tail = normalCDF(-z);
+                Vt = tail >= 1.0 - p ? 0.0 : std::log((1.0 - p) / tail) * m / (1.0 - p);
+                ++exponential;
+                zero += Vt == 0.0;
+            }
+        }
+        EXPECT_NEAR(variance[k], Vt, 1e-12 * std::max(1.0, Vt)) << k;
+    }
+    EXPECT_GT(quadratic, 0);
+    EXPECT_GT(exponential, 0);
+    EXPECT_GT(zero, 0);
+    EXPECT_EQ(variance[count], -1.0);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllLevels, simdMathTest, testing::Values(SCALAR, SSE42, AVX2, AVX512),
+                         [](const testing::TestParamInfo<SimdLevel>& info) { return std::string(simdLevelName(info.param)); });
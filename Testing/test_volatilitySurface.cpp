@@ -0,0 +1,206 @@
+#include "gtest/gtest.h"
+#include "../include/volatilitySurface.h"
+#include "../include/batchPricing.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <vector>
+
+namespace
+{
+    /// @brief Quotes of a known SVI smile at strikes spaced by step in log-moneyness.
+    void sviQuotes(const sviParameters& parameters, double timeToExperation, std::vector<double>& logMoneyness,
+                   std::vector<double>& volatility, double step = 0.05)
+    {
+        logMoneyness.clear();
+        volatility.clear();
+        for (double k = -0.5; k <= 0.5; k += step)
+        {
+            logMoneyness.push_back(k);
+            volatility.push_back(std::sqrt(parameters.totalVariance(k) / timeToExperation));
+        }
+    }
+
+    sviParameters exampleSmile()
+    {
+        sviParameters parameters;
+        parameters.a = 0.02;
+        parameters.b = 0.12;
+        parameters.rho = -0.4;
+        parameters.m = 0.05;
+        parameters.sigma = 0.15;
+        return parameters;
+    }
+}
+
+TEST(volatilitySurfaceTest, FitRecoversSviParameters)
+{
+    const sviParameters expected = exampleSmile();
+    std::vector<double> logMoneyness, volatility;
+    sviQuotes(expected, 0.5, logMoneyness, volatility);
+
+    volatilitySurface surface(100.0, 0.0);
+    EXPECT_TRUE(surface.setSliceQuotes(0.5, logMoneyness, volatility));
+    EXPECT_EQ(surface.refit(), 1u);
+
+    const volatilitySlice& slice = surface.slices().front();
+    EXPECT_FALSE(slice.stale);
+    EXPECT_LT(slice.rootMeanSquareError, 1e-6);
+    EXPECT_NEAR(slice.parameters.a, expected.a, 1e-4);
+    EXPECT_NEAR(slice.parameters.b, expected.b, 1e-4);
+    EXPECT_NEAR(slice.parameters.rho, expected.rho, 1e-3);
+    EXPECT_NEAR(slice.parameters.m, expected.m, 1e-3);
+    EXPECT_NEAR(slice.parameters.sigma, expected.sigma, 1e-3);
+}
+
+TEST(volatilitySurfaceTest, InterpolatesTotalVarianceInTime)
+{
+    sviParameters shortSmile = exampleSmile();
+    sviParameters longSmile = exampleSmile();
+    longSmile.a = 0.08;
+    std::vector<double> logMoneyness, volatility;
+
+    volatilitySurface surface(100.0, 0.03);
+    sviQuotes(shortSmile, 0.25, logMoneyness, volatility);
+    surface.setSliceQuotes(0.25, logMoneyness, volatility);
+    sviQuotes(longSmile, 1.0, logMoneyness, volatility);
+    surface.setSliceQuotes(1.0, logMoneyness, volatility);
+    EXPECT_EQ(surface.refit(), 2u);
+
+    for (double k : {-0.3, 0.0, 0.2})
+    {
+        EXPECT_NEAR(surface.totalVariance(k, 0.25), shortSmile.totalVariance(k), 1e-6);
+        EXPECT_NEAR(surface.totalVariance(k, 1.0), longSmile.totalVariance(k), 1e-6);
+        EXPECT_NEAR(surface.totalVariance(k, 0.625), 0.5 * (shortSmile.totalVariance(k) + longSmile.totalVariance(k)), 1e-6);
+        // Constant volatility outside the slices.
+        EXPECT_NEAR(surface.totalVariance(k, 0.1), shortSmile.totalVariance(k) * 0.4, 1e-6);
+        EXPECT_NEAR(surface.totalVariance(k, 2.0), longSmile.totalVariance(k) * 2.0, 1e-6);
+    }
+
+    // Strikes are measured against the reference forward S e^{rT}.
+    const double strike = 100.0 * std::exp(0.03 * 0.25 + 0.1);
+    EXPECT_NEAR(surface.volatility(strike, 0.25), std::sqrt(shortSmile.totalVariance(0.1) / 0.25), 1e-6);
+}
+
+TEST(volatilitySurfaceTest, RefitsOnlyChangedSlices)
+{
+    std::vector<double> logMoneyness, volatility;
+    volatilitySurface surface(100.0, 0.0);
+    for (double timeToExperation : {0.1, 0.5, 1.0})
+    {
+        sviQuotes(exampleSmile(), timeToExperation, logMoneyness, volatility);
+        surface.setSliceQuotes(timeToExperation, logMoneyness, volatility);
+    }
+    EXPECT_EQ(surface.refit(), 3u);
+    EXPECT_EQ(surface.refit(), 0u);
+
+    sviQuotes(exampleSmile(), 0.5, logMoneyness, volatility);
+    EXPECT_FALSE(surface.setSliceQuotes(0.5, logMoneyness, volatility));
+    EXPECT_EQ(surface.refit(), 0u);
+
+    sviParameters moved = exampleSmile();
+    moved.a = 0.025;
+    sviQuotes(moved, 0.5, logMoneyness, volatility);
+    EXPECT_TRUE(surface.setSliceQuotes(0.5, logMoneyness, volatility));
+    EXPECT_EQ(surface.refit(), 1u);
+    EXPECT_NEAR(surface.slices()[1].parameters.a, 0.025, 1e-4);
+    EXPECT_LT(surface.slices()[1].rootMeanSquareError, 1e-6);
+
+    EXPECT_TRUE(surface.removeSlice(0.1));
+    EXPECT_FALSE(surface.removeSlice(0.1));
+    EXPECT_EQ(surface.slices().size(), 2u);
+}
+
+TEST(volatilitySurfaceTest, FitsCSVDataAndPricesBatches)
+{
+    const std::string filename = "volatilitySurfaceTest.csv";
+    {
+        std::ofstream file(filename);
+        file << "Expiration,StockPrice,StrikePrice,Call\n";
+        for (int expiration : {30, 90})
+        {
+            sviParameters smile = exampleSmile();
+            const double timeToExperation = expiration / 365.0;
+            smile.a = 0.1 * timeToExperation;
+            for (int strike = 80; strike <= 120; strike += 5)
+            {
+                const double k = std::log(strike / 100.0);
+                optionBatch one;
+                one.underlyingPrice = {100.0};
+                one.strikePrice = {static_cast<double>(strike)};
+                one.timeToExperation = {timeToExperation};
+                one.riskFreeRate = {0.0};
+                one.volatility = {std::sqrt(smile.totalVariance(k) / timeToExperation)};
+                one.optionType = {CALL};
+                std::vector<double> price;
+                blackScholesBatchPrice(one, price);
+                file << expiration << ",100.00," << strike << "," << price[0] << "\n";
+            }
+        }
+    }
+    std::vector<CSVData> data = CSVDataReader(filename);
+    std::remove(filename.c_str());
+    ASSERT_EQ(data.size(), 18u);
+
+    volatilitySurface surface;
+    EXPECT_EQ(updateVolatilitySurface(surface, data, 0.0), 2u);
+    ASSERT_EQ(surface.slices().size(), 2u);
+    EXPECT_NEAR(surface.getUnderlyingPrice(), 100.0, 1e-12);
+    EXPECT_EQ(updateVolatilitySurface(surface, data, 0.0), 0u);
+
+    // Prices rounded to 6 digits and the 7.5e-8 error of the batch normal CDF limit the fit.
+    optionBatch batch;
+    for (const CSVData& row : data)
+    {
+        batch.underlyingPrice.push_back(row.getStockPrice());
+        batch.strikePrice.push_back(row.getStrikePrice());
+        batch.timeToExperation.push_back(row.getExpiration() / 365.0);
+        batch.riskFreeRate.push_back(0.0);
+        batch.volatility.push_back(NAN);
+        batch.optionType.push_back(CALL);
+    }
+    std::vector<double> prices;
+    blackScholesBatchPrice(batch, surface, prices);
+    ASSERT_EQ(prices.size(), data.size());
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        EXPECT_NEAR(prices[i], data[i].getCallPrice(), 1e-3) << i;
+    }
+
+    std::vector<double> volatility(batch.size());
+    surface.volatilityBatch(batch.size(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                            batch.timeToExperation.data(), batch.riskFreeRate.data(), volatility.data());
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        EXPECT_NEAR(volatility[i], surface.volatility(batch.strikePrice[i], batch.timeToExperation[i]), 1e-12);
+    }
+}
+
+TEST(volatilitySurfaceTest, InvalidInputsAreNaN)
+{
+    volatilitySurface empty(100.0, 0.0);
+    EXPECT_TRUE(std::isnan(empty.volatility(100.0, 1.0)));
+
+    std::vector<double> logMoneyness, volatility;
+    sviQuotes(exampleSmile(), 1.0, logMoneyness, volatility);
+    volatility[2] = NAN;
+    volatility[3] = -0.1;
+    volatilitySurface surface(100.0, 0.0);
+    surface.setSliceQuotes(1.0, logMoneyness, volatility);
+    EXPECT_EQ(surface.slices().front().logMoneyness.size(), logMoneyness.size() - 2);
+    surface.refit();
+    EXPECT_TRUE(std::isnan(surface.volatility(-5.0, 1.0)));
+    EXPECT_TRUE(std::isnan(surface.volatility(100.0, 0.0)));
+    EXPECT_TRUE(std::isnan(surface.volatility(100.0, NAN)));
+    EXPECT_GT(surface.volatility(100.0, 1.0), 0.0);
+
+    const double spot[3] = {100.0, 100.0, 100.0}, strike[3] = {100.0, -5.0, 100.0}, time[3] = {1.0, 1.0, 0.0};
+    const double rate[3] = {0.0, 0.0, 0.0};
+    double batchVolatility[3];
+    empty.volatilityBatch(1, spot, strike, time, rate, batchVolatility);
+    EXPECT_TRUE(std::isnan(batchVolatility[0]));
+    surface.volatilityBatch(3, spot, strike, time, rate, batchVolatility);
+    EXPECT_DOUBLE_EQ(batchVolatility[0], surface.volatility(100.0, 1.0));
+    EXPECT_TRUE(std::isnan(batchVolatility[1]));
+    EXPECT_TRUE(std::isnan(batchVolatility[2]));
+}
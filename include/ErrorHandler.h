@@ -1,20 +1,500 @@
 #ifndef ERROR_HANDLER_H
 #define ERROR_HANDLER_H
 
-#include <string>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <source_location>
+#include <string>
+#include <thread>
+#include <vector>
 
+/**
+ * @class ErrorHandler
+ * @brief Appends error messages to error.log from any thread without blocking the caller.
+ *
+ * logError copies the message into a preallocated ring buffer of `capacity` slots and returns; a
+ * background thread drains the buffer and writes whatever has accumulated with one write to a file it
+ * keeps open. Producers never lock: a slot is claimed with one compare-and-swap on the enqueue position
+ * (a bounded multi-producer queue with per-slot sequence numbers, drained by the single writer), so
+ * lines from different threads never interleave. Memory is fixed at capacity * messageSize bytes:
+ * longer messages are truncated, and when the buffer is full the message is dropped and counted. The
+ * writer reports drops in the log itself.
+ *
+ * Every call is also counted against its call site (file, line and function of the logError call).
+ * The counters live in one fixed-size table per thread, so counting is O(1), allocates nothing and only
+ * locks the calling thread's own table, which nothing else contends for until siteSummary() merges the
+ * tables on demand. Only the first `burst` messages of a site
+ * (per thread) reach the log, then one in every `every`, tagged with how many were suppressed in
+ * between (setRateLimit). At exit a summary line per site (count, first and last message) is written;
+ * then new messages are written synchronously, the messages already queued are drained with the drop
+ * count, and the writer stops. flush() waits until everything logged so far is on disk.
+ */
 class ErrorHandler {
 public:
-    static void logError(const std::string& errorMessage) {
-        std::ofstream errorLog("error.log", std::ios::app);
-        if (errorLog.is_open()) {
-            errorLog << errorMessage << std::endl;
-            errorLog.close();
+    static constexpr std::size_t capacity = 1024;       // slots, a power of two
+    static constexpr std::size_t messageSize = 256;     // bytes per slot, including the newline
+    static constexpr std::size_t sitesPerThread = 64;   // call sites counted per thread, later ones are not limited
+    static constexpr std::size_t sampleSize = 128;      // bytes kept of the first and last message of a site
+    static constexpr std::uint64_t noLimit = std::numeric_limits<std::uint64_t>::max();
+
+    /**
+     * @struct errorSite
+     * @brief The merged counters of one logError call site.
+     */
+    struct errorSite {
+        std::string file;
+        std::uint32_t line = 0;
+        std::string function;
+        std::uint64_t count = 0;        // calls from this site
+        std::uint64_t logged = 0;       // calls that reached the log
+        std::string firstMessage;       // truncated to sampleSize - 1 characters
+        std::string lastMessage;
+    };
+
+    /**
+     * @brief Counts the message against its call site and, unless rate-limited, queues it for error.log.
+     * @param errorMessage The message, truncated to messageSize - 1 characters.
+     * @param site The call site, filled in by the compiler.
+     */
+    static void logError(const std::string& errorMessage,
+                         const std::source_location& site = std::source_location::current()) {
+        const std::uint64_t suppressed = localSites().count(errorMessage, site);
+        if (suppressed == noLimit) {
+            return;
+        }
+        if (suppressed == 0) {
+            backend().push(errorMessage);
         } else {
-            std::cerr << "Failed to open error.log for writing." << std::endl;
+            backend().push(errorMessage + " [" + std::to_string(suppressed) + " similar messages suppressed]");
+        }
+    }
+
+    /**
+     * @brief Sets how many messages of one call site reach the log.
+     *
+     * The first burst messages of a site are logged, then every every-th one; every = 0 logs none after
+     * the burst. setRateLimit(noLimit, 1) logs everything. The default is (100, 10000).
+     *
+     * @param burst Messages logged before limiting starts.
+     * @param every Interval of the messages logged after the burst.
+     */
+    static void setRateLimit(std::uint64_t burst, std::uint64_t every) {
+        rateLimit().burst.store(burst, std::memory_order_relaxed);
+        rateLimit().every.store(every, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Merges the per-thread counters of every call site.
+     * @return One entry per call site, most frequent first.
+     */
+    static std::vector<errorSite> siteSummary() {
+        return siteRegistry().merge();
+    }
+
+    /**
+     * @brief Writes the counters of every call site to error.log: a line with the counts, then the first
+     *        and the last message.
+     */
+    static void logSummary() {
+        for (const errorSite& site : siteSummary()) {
+            backend().push("ErrorHandler summary: " + site.file + ":" + std::to_string(site.line) + " ("
+                           + site.function + "): " + std::to_string(site.count) + " errors, "
+                           + std::to_string(site.logged) + " logged");
+            backend().push("    first: " + site.firstMessage);
+            backend().push("    last: " + site.lastMessage);
+        }
+    }
+
+    /**
+     * @brief Blocks until every message queued before the call has been written.
+     */
+    static void flush() {
+        backend().flush();
+    }
+
+    /**
+     * @brief Gets the number of messages dropped because the buffer was full.
+     * @return The number of dropped messages since the program started.
+     */
+    static std::uint64_t droppedCount() {
+        return backend().dropped();
+    }
+
+    /**
+     * @brief Gets the number of messages written to error.log by the background writer.
+     * @return The number of written messages since the program started.
+     */
+    static std::uint64_t writtenCount() {
+        return backend().written();
+    }
+
+private:
+    static_assert((capacity & (capacity - 1)) == 0, "capacity must be a power of two");
+
+    class asyncLog {
+    public:
+        asyncLog() {
+            for (std::size_t i = 0; i < capacity; ++i) {
+                _slots[i].sequence.store(i, std::memory_order_relaxed);
+            }
+            _writer = std::thread([this]() { run(); });
+        }
+
+        void push(const std::string& message) {
+            // Announce the push before checking for shutdown: shutdown sets _rejecting and then waits for
+            // _activePushes to reach zero, so a push either writes synchronously or is published before the
+            // final drain. Both sides are sequentially consistent for this handshake.
+            _activePushes.fetch_add(1);
+            if (_rejecting.load()) {
+                _activePushes.fetch_sub(1, std::memory_order_release);
+                writeSynchronously(message);
+                return;
+            }
+            enqueue(message);
+            _activePushes.fetch_sub(1, std::memory_order_release);
+        }
+
+        void flush() {
+            const std::size_t target = _enqueuePosition.load(std::memory_order_acquire);
+            std::size_t written = _writtenPosition.load(std::memory_order_acquire);
+            while (written < target && !_stopped.load(std::memory_order_acquire)) {
+                _writtenPosition.wait(written, std::memory_order_acquire);
+                written = _writtenPosition.load(std::memory_order_acquire);
+            }
+        }
+
+        std::uint64_t dropped() const {
+            return _dropped.load(std::memory_order_relaxed);
+        }
+
+        std::uint64_t written() const {
+            return _writtenPosition.load(std::memory_order_relaxed);
+        }
+
+        /// @brief switches logError to synchronous writes, waits for the pushes already under way, stops
+        ///        the writer and writes whatever it left in the buffer.
+        void shutdown() {
+            _rejecting.store(true);
+            while (_activePushes.load() != 0) {
+                std::this_thread::yield();
+            }
+
+            _stopping.store(true, std::memory_order_release);
+            _published.fetch_add(1, std::memory_order_release);
+            _published.notify_one();
+            if (_writer.joinable()) {
+                _writer.join();
+            }
+
+            // The writer is gone, so this thread is the only consumer; every claimed slot is published.
+            std::string batch;
+            drainInto(batch);
+            if (!batch.empty()) {
+                write(batch);
+            }
+            _writtenPosition.store(_dequeuePosition, std::memory_order_release);
+            _stopped.store(true, std::memory_order_release);
+            _writtenPosition.notify_all();
+        }
+
+    private:
+        struct slot {
+            std::atomic<std::size_t> sequence{0};
+            std::uint16_t length = 0;
+            std::array<char, messageSize> text{};
+        };
+
+        /// @brief claims a slot and publishes message in it, or counts it as dropped if the buffer is full.
+        void enqueue(const std::string& message) {
+            std::size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+            slot* target = nullptr;
+            while (true) {
+                target = &_slots[position & (capacity - 1)];
+                const std::size_t sequence = target->sequence.load(std::memory_order_acquire);
+                const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+                if (difference == 0) {
+                    if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (difference < 0) {
+                    // The writer has not released this slot yet: the buffer is full.
+                    _dropped.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                } else {
+                    position = _enqueuePosition.load(std::memory_order_relaxed);
+                }
+            }
+
+            const std::size_t length = std::min(message.size(), messageSize - 1);
+            std::memcpy(target->text.data(), message.data(), length);
+            target->text[length] = '\n';
+            target->length = static_cast<std::uint16_t>(length + 1);
+            target->sequence.store(position + 1, std::memory_order_release);
+
+            _published.fetch_add(1, std::memory_order_release);
+            _published.notify_one();
         }
+
+        /// @brief appends every published message to batch, then the count of messages dropped since the
+        ///        last report. Called by one consumer at a time.
+        /// @return The number of messages taken from the buffer.
+        std::size_t drainInto(std::string& batch) {
+            std::size_t drained = 0;
+            while (true) {
+                slot& next = _slots[_dequeuePosition & (capacity - 1)];
+                if (next.sequence.load(std::memory_order_acquire) != _dequeuePosition + 1) {
+                    break;
+                }
+                batch.append(next.text.data(), next.length);
+                next.sequence.store(_dequeuePosition + capacity, std::memory_order_release);
+                ++_dequeuePosition;
+                ++drained;
+            }
+
+            const std::uint64_t dropped = _dropped.load(std::memory_order_relaxed);
+            if (dropped != _reportedDropped) {
+                batch += "ErrorHandler: " + std::to_string(dropped - _reportedDropped)
+                       + " messages dropped, log buffer full\n";
+                _reportedDropped = dropped;
+            }
+            return drained;
+        }
+
+        /// @brief the writer thread: drains everything published, writes it in one go, then sleeps until
+        ///        the next message. Exits once stopping is set and the buffer is empty.
+        void run() {
+            std::string batch;
+            batch.reserve(capacity * messageSize);
+            while (true) {
+                const std::uint64_t seen = _published.load(std::memory_order_acquire);
+                const bool stopping = _stopping.load(std::memory_order_acquire);
+
+                batch.clear();
+                const std::size_t drained = drainInto(batch);
+
+                if (!batch.empty()) {
+                    write(batch);
+                }
+                if (drained != 0) {
+                    _writtenPosition.store(_dequeuePosition, std::memory_order_release);
+                    _writtenPosition.notify_all();
+                    continue;
+                }
+                if (stopping) {
+                    return;
+                }
+                _published.wait(seen, std::memory_order_acquire);
+            }
+        }
+
+        void write(const std::string& batch) {
+            if (!_file.is_open()) {
+                _file.open("error.log", std::ios::app);
+            }
+            if (_file.is_open()) {
+                _file.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+                _file.flush();
+            } else {
+                std::cerr << "Failed to open error.log for writing." << std::endl;
+            }
+        }
+
+        static void writeSynchronously(const std::string& message) {
+            std::ofstream errorLog("error.log", std::ios::app);
+            if (errorLog.is_open()) {
+                errorLog << message << std::endl;
+                errorLog.close();
+            } else {
+                std::cerr << "Failed to open error.log for writing." << std::endl;
+            }
+        }
+
+        std::array<slot, capacity> _slots;
+        alignas(64) std::atomic<std::size_t> _enqueuePosition{0};
+        alignas(64) std::atomic<std::uint64_t> _published{0};
+        alignas(64) std::atomic<std::uint64_t> _dropped{0};
+        alignas(64) std::atomic<std::size_t> _writtenPosition{0};
+        alignas(64) std::atomic<std::size_t> _activePushes{0};
+        std::atomic<bool> _rejecting{false};
+        std::atomic<bool> _stopping{false};
+        std::atomic<bool> _stopped{false};
+
+        // Used by the writer thread only, then by shutdown once it has been joined.
+        std::size_t _dequeuePosition = 0;
+        std::uint64_t _reportedDropped = 0;
+        std::ofstream _file;
+        std::thread _writer;
+    };
+
+    struct rateLimitSettings {
+        std::atomic<std::uint64_t> burst{100};
+        std::atomic<std::uint64_t> every{10000};
+    };
+
+    static rateLimitSettings& rateLimit() {
+        static rateLimitSettings settings;
+        return settings;
+    }
+
+    /// @brief copies at most sampleSize - 1 characters of message, without allocating.
+    static void sample(std::array<char, sampleSize>& to, std::uint16_t& length, const std::string& message) {
+        length = static_cast<std::uint16_t>(std::min(message.size(), sampleSize - 1));
+        std::memcpy(to.data(), message.data(), length);
+    }
+
+    /// @brief the call-site counters of one thread: an open-addressing table on the line and column of
+    ///        the call, guarded by a mutex that only siteSummary() ever contends for.
+    class siteTable {
+    public:
+        /// @brief counts one call. Returns 0 if the message should be logged as is, noLimit if it should
+        ///        be suppressed, otherwise the number of messages suppressed since the site last logged.
+        std::uint64_t count(const std::string& message, const std::source_location& site) {
+            std::lock_guard<std::mutex> guard(_lock);
+            entry* found = find(site);
+            if (found == nullptr) {
+                return 0;
+            }
+
+            const std::uint64_t n = ++found->count;
+            if (n == 1) {
+                sample(found->first, found->firstLength, message);
+            }
+            sample(found->last, found->lastLength, message);
+
+            const std::uint64_t burst = rateLimit().burst.load(std::memory_order_relaxed);
+            const std::uint64_t every = rateLimit().every.load(std::memory_order_relaxed);
+            if (n > burst && (every == 0 || (n - burst) % every != 0)) {
+                return noLimit;
+            }
+            const std::uint64_t suppressed = n - found->lastLogged - 1;
+            found->lastLogged = n;
+            ++found->logged;
+            return suppressed;
+        }
+
+        /// @brief adds this thread's counters to sites.
+        void mergeInto(std::vector<errorSite>& sites) {
+            std::lock_guard<std::mutex> guard(_lock);
+            for (const entry& used : _entries) {
+                if (used.file == nullptr) {
+                    continue;
+                }
+                auto same = std::find_if(sites.begin(), sites.end(), [&](const errorSite& site) {
+                    return site.line == used.line && site.file == used.file && site.function == used.function;
+                });
+                if (same == sites.end()) {
+                    errorSite site;
+                    site.file = used.file;
+                    site.line = used.line;
+                    site.function = used.function;
+                    site.firstMessage.assign(used.first.data(), used.firstLength);
+                    same = sites.insert(sites.end(), std::move(site));
+                }
+                same->count += used.count;
+                same->logged += used.logged;
+                same->lastMessage.assign(used.last.data(), used.lastLength);
+            }
+        }
+
+    private:
+        struct entry {
+            const char* file = nullptr;
+            const char* function = nullptr;
+            std::uint32_t line = 0;
+            std::uint32_t column = 0;
+            std::uint64_t count = 0;
+            std::uint64_t logged = 0;
+            std::uint64_t lastLogged = 0;
+            std::uint16_t firstLength = 0;
+            std::uint16_t lastLength = 0;
+            std::array<char, sampleSize> first{};
+            std::array<char, sampleSize> last{};
+        };
+
+        /// @brief the entry of site, claiming a free one on first use; nullptr if the table is full.
+        entry* find(const std::source_location& site) {
+            std::size_t index = (site.line() * 31u + site.column()) & (sitesPerThread - 1);
+            for (std::size_t probe = 0; probe < sitesPerThread; ++probe, index = (index + 1) & (sitesPerThread - 1)) {
+                entry& candidate = _entries[index];
+                if (candidate.file == nullptr) {
+                    candidate.file = site.file_name();
+                    candidate.function = site.function_name();
+                    candidate.line = site.line();
+                    candidate.column = site.column();
+                    return &candidate;
+                }
+                // The same header can give each translation unit its own copy of the file name.
+                if (candidate.line == site.line() && candidate.column == site.column()
+                    && (candidate.file == site.file_name() || std::strcmp(candidate.file, site.file_name()) == 0)) {
+                    return &candidate;
+                }
+            }
+            return nullptr;
+        }
+
+        std::mutex _lock;
+        std::array<entry, sitesPerThread> _entries{};
+    };
+
+    static_assert((sitesPerThread & (sitesPerThread - 1)) == 0, "sitesPerThread must be a power of two");
+
+    /// @brief every thread's siteTable. Tables outlive their threads so their counts stay in the summary.
+    class siteTables {
+    public:
+        siteTable* add() {
+            std::lock_guard<std::mutex> guard(_lock);
+            _tables.push_back(std::make_unique<siteTable>());
+            return _tables.back().get();
+        }
+
+        std::vector<errorSite> merge() {
+            std::vector<errorSite> sites;
+            std::lock_guard<std::mutex> guard(_lock);
+            for (const std::unique_ptr<siteTable>& table : _tables) {
+                table->mergeInto(sites);
+            }
+            std::stable_sort(sites.begin(), sites.end(),
+                             [](const errorSite& a, const errorSite& b) { return a.count > b.count; });
+            return sites;
+        }
+
+    private:
+        std::mutex _lock;
+        std::vector<std::unique_ptr<siteTable>> _tables;
+    };
+
+    static siteTables& siteRegistry() {
+        static siteTables* registry = new siteTables();
+        return *registry;
+    }
+
+    static siteTable& localSites() {
+        thread_local siteTable* table = siteRegistry().add();
+        return *table;
+    }
+
+    /// @brief the process-wide log. Never destroyed, so logError stays usable from static destructors;
+    ///        an exit handler writes the site summary, drains the log and stops the writer.
+    static asyncLog& backend() {
+        static asyncLog* log = []() {
+            asyncLog* created = new asyncLog();
+            std::atexit([]() {
+                logSummary();
+                backend().shutdown();
+            });
+            return created;
+        }();
+        return *log;
     }
 };
 
@@ -0,0 +1,374 @@
+#ifndef BATCHPRICING_H
+#define BATCHPRICING_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "optionType.h"
+#include "optionStatus.h"
+#include "normalCDFTable.h"
+#include "greekMask.h"
+
+/**
+ * @struct optionBatch
+ * @brief Structure-of-arrays container for a batch of European options.
+ *
+ * Element i of every column describes option i. The columns are kept contiguous so
+ * they can be handed straight to the batch pricing functions below.
+ */
+struct optionBatch
+{
+    std::vector<double> underlyingPrice;
+    std::vector<double> strikePrice;
+    std::vector<double> timeToExperation;
+    std::vector<double> riskFreeRate;
+    std::vector<double> volatility;
+    std::vector<OptionType> optionType;
+
+    /**
+     * @brief Resizes every column of the batch.
+     * @param count The new number of options.
+     */
+    void resize(std::size_t count);
+
+    /**
+     * @brief Gets the number of options in the batch.
+     * @return The number of options.
+     */
+    std::size_t size() const { return underlyingPrice.size(); }
+};
+
+/**
+ * @struct optionBatchFloat
+ * @brief Single-precision structure-of-arrays batch, for screening runs that tolerate ~1e-5 relative error.
+ *
+ * Half the memory traffic of optionBatch, and the kernels process twice as many options per instruction.
+ */
+struct optionBatchFloat
+{
+    std::vector<float> underlyingPrice;
+    std::vector<float> strikePrice;
+    std::vector<float> timeToExperation;
+    std::vector<float> riskFreeRate;
+    std::vector<float> volatility;
+    std::vector<OptionType> optionType;
+
+    /**
+     * @brief Resizes every column of the batch.
+     * @param count The new number of options.
+     */
+    void resize(std::size_t count);
+
+    /**
+     * @brief Gets the number of options in the batch.
+     * @return The number of options.
+     */
+    std::size_t size() const { return underlyingPrice.size(); }
+};
+
+/**
+ * @struct mixedPrecisionStats
+ * @brief What blackScholesBatchPriceMixed did with a batch.
+ */
+struct mixedPrecisionStats
+{
+    std::size_t count = 0;          // options priced
+    std::size_t reevaluated = 0;    // options re-priced in double, including invalid ones
+};
+
+/**
+ * @struct greeksBatch
+ * @brief Structure-of-arrays output of the fused price and Greeks batch functions.
+ *
+ * Vega and rho are per unit of volatility and rate, theta is per year (see blackScholesPriceAndGreeks
+ * in pricingCore.h).
+ */
+struct greeksBatch
+{
+    std::vector<double> price;
+    std::vector<double> delta;
+    std::vector<double> gamma;
+    std::vector<double> vega;
+    std::vector<double> theta;
+    std::vector<double> rho;
+
+    /**
+     * @brief Resizes every column of the batch.
+     * @param count The new number of options.
+     */
+    void resize(std::size_t count);
+
+    /**
+     * @brief Gets the number of options in the batch.
+     * @return The number of options.
+     */
+    std::size_t size() const { return price.size(); }
+};
+
+/**
+ * @struct selectedGreeksBatch
+ * @brief Structure-of-arrays output of the runtime-mask batch Greeks: one column per GreekMask bit.
+ *
+ * Only the columns of the selected bits are sized to the batch; the others stay empty.
+ */
+struct selectedGreeksBatch
+{
+    unsigned greeks = 0;
+    std::array<std::vector<double>, GREEK_COUNT> columns;  // columns[greekIndex(bit)]
+
+    /**
+     * @brief Sizes the columns of the selected results to count and empties the others.
+     * @param count The new number of options.
+     * @param selected The GreekMask bits of the results to hold.
+     */
+    void resize(std::size_t count, unsigned selected);
+
+    /**
+     * @brief Gets the column of one result.
+     * @param greek One GreekMask bit.
+     * @return The column, empty if greek is not selected.
+     */
+    std::vector<double>& operator[](GreekMask greek) { return columns[greekIndex(greek)]; }
+    const std::vector<double>& operator[](GreekMask greek) const { return columns[greekIndex(greek)]; }
+};
+
+/**
+ * @struct batchStatus
+ * @brief Per-option validation result of a batch, filled by validateBatch and the status overloads below.
+ *
+ * status[i] holds the OptionStatus bits of option i. invalidCount and fields summarize the whole batch,
+ * so a caller can check one integer instead of scanning the array.
+ */
+struct batchStatus
+{
+    std::vector<std::uint8_t> status;
+    std::size_t invalidCount = 0;   // options with at least one invalid input
+    std::uint8_t fields = 0;        // OR of every status[i]
+
+    /**
+     * @brief Gets the number of options in the batch.
+     * @return The number of options.
+     */
+    std::size_t size() const { return status.size(); }
+};
+
+/**
+ * @brief Reorders a batch so that all calls come before all puts.
+ *
+ * The batch functions below then price each type with one kernel specialized on it. Worth doing once
+ * for a batch that is priced repeatedly, e.g. a chain under changing volatilities.
+ *
+ * @param batch The batch to reorder, stable within each type.
+ * @param originalIndex Output: originalIndex[i] is the position option i had before the call.
+ * @return The number of calls, i.e. the index of the first put.
+ */
+std::size_t partitionByOptionType(optionBatch& batch, std::vector<std::size_t>& originalIndex);
+
+/**
+ * @brief Prices a batch of European options with the Black-Scholes formula.
+ *
+ * Runs on the best vectorized kernel for this CPU (see cpuDispatch.h). Runs of 64 or more consecutive
+ * calls or puts go to kernels specialized on the option type, which need no per-option sign; see
+ * partitionByOptionType. Unlike blackScholesModel no object is created per option and nothing throws:
+ * an option whose inputs would be rejected by the blackScholesModel setters (NaN inputs, volatility
+ * outside (0, 1), negative time to expiration) or whose type is neither CALL nor PUT is priced as NaN.
+ *
+ * With cdfMethod = CDF_TABLE, N(x) comes from the interpolation table of normalCDFTable.h instead of the
+ * Abramowitz-Stegun polynomial: max error 1.4e-9 instead of 7.5e-8 per N(x), so prices move by up to
+ * about 7.5e-8 (S + K). Whether it is also faster depends on the CPU's gather throughput; see
+ * benchmarkNormalCDF.
+ *
+ * @param count Number of options in the batch.
+ * @param underlyingPrice Underlying prices, count elements.
+ * @param strikePrice Strike prices, count elements.
+ * @param timeToExperation Times to expiration in years, count elements.
+ * @param riskFreeRate Risk-free rates, count elements.
+ * @param volatility Volatilities, count elements.
+ * @param optionType Option types, count elements.
+ * @param optionPrice Output prices, count elements.
+ * @param cdfMethod How N(x) is evaluated.
+ */
+void blackScholesBatchPrice(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                            const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                            const OptionType* optionType, double* optionPrice,
+                            NormalCDFMethod cdfMethod = CDF_POLYNOMIAL);
+
+/**
+ * @brief Prices every option of an optionBatch with the Black-Scholes formula.
+ * @param batch The options to price.
+ * @param optionPrice Output prices, resized to batch.size().
+ * @param cdfMethod How N(x) is evaluated.
+ */
+void blackScholesBatchPrice(const optionBatch& batch, std::vector<double>& optionPrice,
+                            NormalCDFMethod cdfMethod = CDF_POLYNOMIAL);
+
+/**
+ * @brief Computes the Black-Scholes price and first-order Greeks of a batch of European options in one pass.
+ *
+ * d1, d2, the normal density and the discount factor are evaluated once per option and shared by all six
+ * results. Invalid options get NaN in every output, as in blackScholesBatchPrice.
+ *
+ * @param count Number of options in the batch.
+ * @param underlyingPrice Underlying prices, count elements.
+ * @param strikePrice Strike prices, count elements.
+ * @param timeToExperation Times to expiration in years, count elements.
+ * @param riskFreeRate Risk-free rates, count elements.
+ * @param volatility Volatilities, count elements.
+ * @param optionType Option types, count elements.
+ * @param optionPrice Output prices, count elements.
+ * @param delta Output deltas, count elements.
+ * @param gamma Output gammas, count elements.
+ * @param vega Output vegas, count elements.
+ * @param theta Output thetas, count elements.
+ * @param rho Output rhos, count elements.
+ */
+void blackScholesBatchGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                             const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                             const OptionType* optionType, double* optionPrice, double* delta, double* gamma,
+                             double* vega, double* theta, double* rho);
+
+/**
+ * @brief Computes the price and first-order Greeks of every option of an optionBatch.
+ * @param batch The options to evaluate.
+ * @param greeks Output columns, resized to batch.size().
+ */
+void blackScholesBatchGreeks(const optionBatch& batch, greeksBatch& greeks);
+
+/**
+ * @brief Computes the results selected by a runtime GreekMask for a batch of European options.
+ *
+ * Writes only the selected columns and skips the terms none of them needs: delta alone costs one normal
+ * CDF and no exponential, where blackScholesBatchGreeks evaluates everything. Besides the price and the
+ * first-order Greeks of blackScholesBatchGreeks, greeks may select the adjusted deltas and adjusted prices
+ * of optionGreeksModel, computed from the batch Greeks with the formulas of the model, e.g.
+ * gammaAdjustedDelta = delta + gamma / 2 and optionPriceGamma = gammaAdjustedDelta S - K e^{-rT}. The
+ * volatility implied by the option's own price is its volatility, so the IV adjusted delta equals delta.
+ * Invalid options get NaN in every selected output, as in blackScholesBatchPrice.
+ *
+ * @param count Number of options in the batch.
+ * @param underlyingPrice Underlying prices, count elements.
+ * @param strikePrice Strike prices, count elements.
+ * @param timeToExperation Times to expiration in years, count elements.
+ * @param riskFreeRate Risk-free rates, count elements.
+ * @param volatility Volatilities, count elements.
+ * @param optionType Option types, count elements.
+ * @param greeks The GreekMask bits of the results to compute.
+ * @param output GREEK_COUNT columns; output[greekIndex(b)] receives count results of bit b if b is selected,
+ *               and may be null otherwise.
+ */
+void blackScholesBatchGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                             const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                             const OptionType* optionType, unsigned greeks, double* const* output);
+
+/**
+ * @brief Computes the results selected by a runtime GreekMask for every option of an optionBatch.
+ * @param batch The options to evaluate.
+ * @param greeks The GreekMask bits of the results to compute.
+ * @param output Output columns, resized by selectedGreeksBatch::resize(batch.size(), greeks).
+ */
+void blackScholesBatchGreeks(const optionBatch& batch, unsigned greeks, selectedGreeksBatch& output);
+
+/**
+ * @brief Computes the OptionStatus bits of every option of a batch (see optionStatus.h).
+ *
+ * One branch-free pass over the columns: nothing throws and nothing is logged.
+ *
+ * @param count Number of options in the batch.
+ * @param underlyingPrice Underlying prices, count elements.
+ * @param strikePrice Strike prices, count elements.
+ * @param timeToExperation Times to expiration in years, count elements.
+ * @param riskFreeRate Risk-free rates, count elements.
+ * @param volatility Volatilities, count elements.
+ * @param optionType Option types, count elements.
+ * @param status Output status bits, count elements.
+ * @return The number of invalid options.
+ */
+std::size_t validateBatch(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                          const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                          const OptionType* optionType, std::uint8_t* status);
+
+/**
+ * @brief Computes the OptionStatus bits of every option of an optionBatch.
+ * @param batch The options to check.
+ * @param status Output, resized to batch.size().
+ */
+void validateBatch(const optionBatch& batch, batchStatus& status);
+
+/**
+ * @brief Describes the invalid options of a batch in one line: how many, per field, and the first indices.
+ * @param status A status filled by validateBatch.
+ * @param maxIndices How many invalid option indices to list.
+ * @return The description, empty if every option is valid.
+ */
+std::string describeBatchStatus(const batchStatus& status, std::size_t maxIndices = 8);
+
+/**
+ * @brief Prices every option of an optionBatch in no-throw mode, reporting invalid inputs per option.
+ *
+ * As the overload without status, plus one validateBatch pass. Every option with a nonzero status is
+ * priced as NaN, including those the kernels alone would price (e.g. a non-positive underlying price).
+ * If any option is invalid, one line from describeBatchStatus is passed to ErrorHandler::logError for
+ * the whole batch, however many options are affected.
+ *
+ * @param batch The options to price.
+ * @param optionPrice Output prices, resized to batch.size().
+ * @param status Output status, resized to batch.size().
+ * @param cdfMethod How N(x) is evaluated.
+ */
+void blackScholesBatchPrice(const optionBatch& batch, std::vector<double>& optionPrice, batchStatus& status,
+                            NormalCDFMethod cdfMethod = CDF_POLYNOMIAL);
+
+/**
+ * @brief Computes the price and first-order Greeks of every option of an optionBatch in no-throw mode,
+ *        reporting invalid inputs per option.
+ *
+ * Invalid options get NaN in every output; logging is once per batch, as in the blackScholesBatchPrice
+ * status overload.
+ *
+ * @param batch The options to evaluate.
+ * @param greeks Output columns, resized to batch.size().
+ * @param status Output status, resized to batch.size().
+ */
+void blackScholesBatchGreeks(const optionBatch& batch, greeksBatch& greeks, batchStatus& status);
+
+/**
+ * @brief Prices a batch of European options with the Black-Scholes formula in single precision.
+ *
+ * Same behaviour as the double overload, on the float kernels. Well-conditioned options are within
+ * ~1e-6 relative of the double price; pass relativeError to get the per-option estimate used by
+ * blackScholesBatchPriceMixed.
+ *
+ * @param relativeError Output error estimates, count elements, or nullptr.
+ */
+void blackScholesBatchPrice(std::size_t count, const float* underlyingPrice, const float* strikePrice,
+                            const float* timeToExperation, const float* riskFreeRate, const float* volatility,
+                            const OptionType* optionType, float* optionPrice, float* relativeError = nullptr);
+
+/**
+ * @brief Prices every option of an optionBatchFloat in single precision.
+ * @param batch The options to price.
+ * @param optionPrice Output prices, resized to batch.size().
+ */
+void blackScholesBatchPrice(const optionBatchFloat& batch, std::vector<float>& optionPrice);
+
+/**
+ * @brief Prices a double batch in single precision, re-pricing in double the options whose float result
+ *        may be off by more than tolerance.
+ *
+ * The batch is converted to float in cache-sized chunks and priced on the float kernels. Options whose
+ * estimated relative error exceeds tolerance are re-priced on the double kernels from the original
+ * inputs. These are typically deep in- or out-of-the-money options and very short expiries. So every
+ * result is within about tolerance of blackScholesBatchPrice, and invalid options are NaN as there.
+ *
+ * @param batch The options to price.
+ * @param optionPrice Output prices, resized to batch.size().
+ * @param tolerance Largest accepted estimated relative error of a float price.
+ * @param stats If not null, receives the number of options priced and re-evaluated.
+ */
+void blackScholesBatchPriceMixed(const optionBatch& batch, std::vector<double>& optionPrice, double tolerance = 1e-5,
+                                 mixedPrecisionStats* stats = nullptr);
+
+#endif // BATCHPRICING_H
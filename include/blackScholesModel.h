@@ -3,6 +3,7 @@
 
 #include<iostream>
 #include "optionType.h"
+#include "pricingCore.h"
 
 using namespace std;
 
@@ -16,6 +17,9 @@ using namespace std;
  *
  * @note This class is designed to be used with European options only.
  *
+ * @note The calculations delegate to the stateless functions in pricingCore.h. Once constructed, the
+ * const members only read the model, so one instance can be shared by several threads.
+ *
  * @enum OptionType
  * @brief Enum to represent the type of option.
  * @var OptionType::CALL
@@ -39,10 +43,15 @@ using namespace std;
  *                                double riskFreeRate, double volatility, OptionType optionType)
  * Parameterized constructor to initialize the model with given parameters and option type.
  *
- * @fn double calculateOptionPrice()
+ * @fn double calculateOptionPrice() const
  * @brief Calculates the price of the option using the Black-Scholes formula.
  * @return The calculated option price.
  *
+ * @fn blackScholesSensitivities calculateSensitivities() const
+ * @brief Calculates the price with its first and second-order sensitivities (delta, gamma, vega, theta,
+ *        rho, vanna, volga, charm) from one dual-number evaluation of the pricing formula.
+ * @return The price and sensitivities, all NaN if an input is NaN.
+ *
  * @fn double normalCDF(double d) const
  * @brief Calculates the cumulative distribution function of the standard normal distribution.
  * @param d The value to calculate the CDF for.
@@ -72,15 +81,15 @@ using namespace std;
  * @brief Sets the type of the option (CALL or PUT).
  * @param option The option type.
  *
- * @fn void setD1(const double& value) const
+ * @fn void setD1(const double& value)
  * @brief Sets the value of d1.
  * @param value The value of d1.
  *
- * @fn void setD2(const double& value) const
+ * @fn void setD2(const double& value)
  * @brief Sets the value of d2.
  * @param value The value of d2.
  *
- * @fn void setK(const double& value) const
+ * @fn void setK(const double& value)
  * @brief Sets the value of K.
  * @param value The value of K.
  *
@@ -122,10 +131,9 @@ using namespace std;
  */
 class blackScholesModel
 {
-    mutable double _d1;
-    mutable double _d2;
-    mutable double _d;
-    mutable double _K;
+    double _d1;
+    double _d2;
+    double _K;
 
 
     void calculateD1();
@@ -149,7 +157,9 @@ class blackScholesModel
                       double riskFreeRate, double volatility, OptionType optionType);
 
 
-        double calculateOptionPrice();
+        double calculateOptionPrice() const;
+
+        blackScholesSensitivities calculateSensitivities() const;
 
         const double normalCDF(const double& d) const;
 
@@ -166,11 +176,11 @@ class blackScholesModel
 
         void setOptionType(const OptionType& option);
 
-        void setD1(const double& value) const;
+        void setD1(const double& value);
 
-        void setD2(const double& value) const;
+        void setD2(const double& value);
 
-        void setK(const double& value) const;
+        void setK(const double& value);
 
 
         const double& getUnderlyingPrice() const;
@@ -197,7 +207,7 @@ class blackScholesModel
         double _timeToExperation;
         double _riskFreeRate;
         double _volatility;      //  One varaible that cannot be predicted, future market risk
-        OptionType _optionType;
+        OptionType _optionType = CALL;  //  The constructors without a type price calls
         
 };  //  BlackScholesModel Class 
 
@@ -0,0 +1,110 @@
+#ifndef CHAINPRICING_H
+#define CHAINPRICING_H
+
+#include <cstddef>
+#include <vector>
+
+#include "optionType.h"
+#include "batchPricing.h"
+
+/**
+ * @struct optionChain
+ * @brief The strikes of one expiry: one underlying price, time to expiration and rate, and per-strike
+ *        strike, volatility and type columns.
+ *
+ * ln(S), sqrt(T) and e^{-rT} are the same for every strike, so the chain functions below compute them
+ * once per chain, where blackScholesModel and the batch functions compute them once per option.
+ */
+struct optionChain
+{
+    double underlyingPrice = 0.0;
+    double timeToExperation = 0.0;
+    double riskFreeRate = 0.0;
+    std::vector<double> strikePrice;
+    std::vector<double> volatility;
+    std::vector<OptionType> optionType;
+
+    /**
+     * @brief Resizes every per-strike column of the chain.
+     * @param count The new number of strikes.
+     */
+    void resize(std::size_t count);
+
+    /**
+     * @brief Gets the number of strikes in the chain.
+     * @return The number of strikes.
+     */
+    std::size_t size() const { return strikePrice.size(); }
+};
+
+/**
+ * @brief Splits a batch into chains of options with the same underlying price, time to expiration and rate.
+ *
+ * Chains are in the order their first option appears in the batch, and options keep their batch order
+ * within a chain. Rows of Test_Data.csv with the same expiration and spot end up in one chain.
+ *
+ * @param batch The options to group.
+ * @param originalIndex Output: the batch index of every option, chain after chain, in chain order.
+ * @return The chains.
+ */
+std::vector<optionChain> groupIntoChains(const optionBatch& batch, std::vector<std::size_t>& originalIndex);
+
+/**
+ * @brief Prices the strikes of one expiry with the Black-Scholes formula.
+ *
+ * Runs on the vectorized kernels selected by cpuDispatch. Per strike only ln(K), phi(d1) and the normal
+ * CDFs are evaluated; results are within a few ulp of blackScholesBatchPrice (ln(S) - ln(K) replaces
+ * ln(S / K)). Invalid options are priced as NaN, as in blackScholesBatchPrice.
+ *
+ * @param underlyingPrice The underlying price shared by the chain.
+ * @param timeToExperation The time to expiration in years shared by the chain.
+ * @param riskFreeRate The risk-free rate shared by the chain.
+ * @param count Number of strikes.
+ * @param strikePrice Strike prices, count elements.
+ * @param volatility Volatilities, count elements.
+ * @param optionType Option types, count elements.
+ * @param optionPrice Output prices, count elements.
+ */
+void blackScholesChainPrice(double underlyingPrice, double timeToExperation, double riskFreeRate, std::size_t count,
+                            const double* strikePrice, const double* volatility, const OptionType* optionType,
+                            double* optionPrice);
+
+/**
+ * @brief Prices every strike of an optionChain.
+ * @param chain The chain to price.
+ * @param optionPrice Output prices, resized to chain.size().
+ */
+void blackScholesChainPrice(const optionChain& chain, std::vector<double>& optionPrice);
+
+/**
+ * @brief Computes the price and first-order Greeks of the strikes of one expiry in one pass.
+ *
+ * As blackScholesBatchGreeks, with the expiry-level terms computed once for the chain.
+ *
+ * @param underlyingPrice The underlying price shared by the chain.
+ * @param timeToExperation The time to expiration in years shared by the chain.
+ * @param riskFreeRate The risk-free rate shared by the chain.
+ * @param count Number of strikes.
+ * @param strikePrice Strike prices, count elements.
+ * @param volatility Volatilities, count elements.
+ * @param optionType Option types, count elements.
+ * @param optionPrice Output prices, count elements.
+ * @param delta Output deltas, count elements.
+ * @param gamma Output gammas, count elements.
+ * @param vega Output vegas, count elements.
+ * @param theta Output thetas, count elements.
+ * @param rho Output rhos, count elements.
+ */
+void blackScholesChainGreeks(double underlyingPrice, double timeToExperation, double riskFreeRate, std::size_t count,
+                             const double* strikePrice, const double* volatility, const OptionType* optionType,
+                             double* optionPrice, double* delta, double* gamma, double* vega, double* theta,
+                             double* rho);
+
+/**
+ * @brief Computes the price and first-order Greeks of every strike of an optionChain.
+ * @param chain The chain to evaluate.
+ * @param greeks Output columns, resized to chain.size().
+ */
+void blackScholesChainGreeks(const optionChain& chain, greeksBatch& greeks);
+
+#endif // CHAINPRICING_H
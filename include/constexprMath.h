@@ -0,0 +1,264 @@
+#ifndef CONSTEXPRMATH_H
+#define CONSTEXPRMATH_H
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+/**
+ * @file constexprMath.h
+ * @brief exp, log, sqrt, erfc and abs usable in constant expressions.
+ *
+ * The <cmath> functions are not constexpr in C++23 on every compiler, so each function here has its own
+ * implementation for constant evaluation and calls std:: otherwise (`if consteval`); runtime results are
+ * exactly those of <cmath>. At compile time exp and log are within 2 ulp and sqrt within 1 ulp of <cmath>,
+ * with the same results for NaN, infinities, zeros and negative arguments.
+ */
+namespace constexprMath
+{
+    namespace detail
+    {
+        // ln(2) split so that n * ln2High is exact for |n| < 2^20 (same split as simdKernels.h).
+        inline constexpr double ln2High = 6.93147180369123816490e-01;
+        inline constexpr double ln2Low = 1.90821492927058770002e-10;
+
+        inline constexpr std::uint64_t exponentMask = 0x7ff0000000000000ull;
+        inline constexpr std::uint64_t mantissaMask = 0x000fffffffffffffull;
+
+        /// @brief 2^k for a normal exponent, -1022 <= k <= 1023.
+        constexpr double pow2(int k)
+        {
+            return std::bit_cast<double>(static_cast<std::uint64_t>(k + 1023) << 52);
+        }
+
+        /// @brief x 2^n for -1075 <= n <= 1024, in two steps so the result can overflow or be subnormal.
+        constexpr double scale(double x, int n)
+        {
+            if (n > 1023)
+            {
+                return x * pow2(1023) * pow2(n - 1023);
+            }
+            if (n < -1022)
+            {
+                return x * pow2(n + 54) * pow2(-54);
+            }
+            return x * pow2(n);
+        }
+
+        constexpr bool isnan(double x)
+        {
+            return x != x;
+        }
+    }
+
+    constexpr double abs(double x)
+    {
+        if consteval
+        {
+            return x < 0.0 ? -x : (x == 0.0 ? 0.0 : x);
+        }
+        else
+        {
+            return std::abs(x);
+        }
+    }
+
+    /// @brief e^x by range reduction x = n ln2 + r, |r| <= ln2 / 2, and a degree-13 Taylor polynomial.
+    constexpr double exp(double x)
+    {
+        if consteval
+        {
+            if (detail::isnan(x))
+            {
+                return x;
+            }
+            if (x > 709.782712893384)
+            {
+                return std::numeric_limits<double>::infinity();
+            }
+            if (x < -745.1332191019412)
+            {
+                return 0.0;
+            }
+
+            const double nf = x * std::numbers::log2e;
+            const int n = static_cast<int>(nf < 0.0 ? nf - 0.5 : nf + 0.5);
+            const double r = (x - n * detail::ln2High) - n * detail::ln2Low;
+
+            // 1 + r (1 + r/2 (1 + r/3 (... (1 + r/13))))
+            double p = 1.0;
+            for (int k = 13; k >= 1; --k)
+            {
+                p = 1.0 + p * r / k;
+            }
+
+            return detail::scale(p, n);
+        }
+        else
+        {
+            return std::exp(x);
+        }
+    }
+
+    /// @brief ln(x) from x = m 2^e, m in [sqrt(2)/2, sqrt(2)), and the atanh series of (m - 1) / (m + 1).
+    constexpr double log(double x)
+    {
+        if consteval
+        {
+            if (detail::isnan(x) || x == std::numeric_limits<double>::infinity())
+            {
+                return x;
+            }
+            if (x < 0.0)
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            if (x == 0.0)
+            {
+                return -std::numeric_limits<double>::infinity();
+            }
+
+            int e = 0;
+            if (x < std::numeric_limits<double>::min())
+            {
+                x *= detail::pow2(54);
+                e = -54;
+            }
+            const std::uint64_t bits = std::bit_cast<std::uint64_t>(x);
+            e += static_cast<int>((bits & detail::exponentMask) >> 52) - 1023;
+            double m = std::bit_cast<double>((bits & detail::mantissaMask) | (std::uint64_t{1023} << 52));
+            if (m > std::numbers::sqrt2)
+            {
+                m *= 0.5;
+                e += 1;
+            }
+
+            const double s = (m - 1.0) / (m + 1.0);
+            const double z = s * s;
+            double p = 1.0 / 23.0;
+            for (int k = 21; k >= 3; k -= 2)
+            {
+                p = p * z + 1.0 / k;
+            }
+            const double logm = 2.0 * s + 2.0 * s * z * p;
+
+            return e * detail::ln2High + (e * detail::ln2Low + logm);
+        }
+        else
+        {
+            return std::log(x);
+        }
+    }
+
+    /// @brief sqrt(x) by Newton's method from an exponent-halving first guess.
+    constexpr double sqrt(double x)
+    {
+        if consteval
+        {
+            if (detail::isnan(x) || x == 0.0 || x == std::numeric_limits<double>::infinity())
+            {
+                return x;
+            }
+            if (x < 0.0)
+            {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+
+            double factor = 1.0;
+            if (x < std::numeric_limits<double>::min())
+            {
+                x *= detail::pow2(108);
+                factor = detail::pow2(-54);
+            }
+
+            double y = std::bit_cast<double>((std::bit_cast<std::uint64_t>(x) >> 1) + 0x1ff8000000000000ull);
+            for (int i = 0; i < 6; ++i)
+            {
+                y = 0.5 * (y + x / y);
+            }
+            // Newton converges from above; step down once more if the previous value was the closer one.
+            const double below = std::bit_cast<double>(std::bit_cast<std::uint64_t>(y) - 1);
+            if (abs(below * below - x) < abs(y * y - x))
+            {
+                y = below;
+            }
+
+            return y * factor;
+        }
+        else
+        {
+            return std::sqrt(x);
+        }
+    }
+
+    /// @brief erfc(x) from the series erf(x) = 2/sqrt(pi) e^{-x^2} sum (2x^2)^n x / (1 3 ... (2n+1)) for
+    /// |x| < 3 and from the continued fraction of erfc beyond. Within 1e-15 absolute of std::erfc and, for
+    /// x >= 3, within 1e-13 relative (the rounding of x^2 in e^{-x^2}).
+    constexpr double erfc(double x)
+    {
+        if consteval
+        {
+            if (detail::isnan(x))
+            {
+                return x;
+            }
+            if (x < 0.0)
+            {
+                return 2.0 - erfc(-x);
+            }
+            if (x < 3.0)
+            {
+                // All terms positive, so no cancellation; they peak below e^9.
+                double term = x;
+                double sum = x;
+                for (int n = 1; term > 1e-17 * sum; ++n)
+                {
+                    term *= 2.0 * x * x / (2 * n + 1);
+                    sum += term;
+                }
+                return 1.0 - 2.0 * std::numbers::inv_sqrtpi * exp(-x * x) * sum;
+            }
+            if (x > 27.3)
+            {
+                return 0.0;
+            }
+
+            // erfc(x) = e^{-x^2} / sqrt(pi) / (x + (1/2) / (x + 1 / (x + (3/2) / (x + ...)))), evaluated backwards.
+            double fraction = x;
+            for (int k = 80; k >= 1; --k)
+            {
+                fraction = x + 0.5 * k / fraction;
+            }
+            return exp(-x * x) * std::numbers::inv_sqrtpi / fraction;
+        }
+        else
+        {
+            return std::erfc(x);
+        }
+    }
+
+    /**
+     * @brief Tabulates f at N equally spaced points of [lower, upper], both ends included.
+     *
+     * With a constexpr f and a constexpr result variable the table is computed by the compiler and stored
+     * in the binary, e.g. `constexpr auto table = tabulate<257>(-8.0, 8.0, [](double x) { return normalCDF(x); });`.
+     */
+    template <std::size_t N, class F>
+    constexpr std::array<double, N> tabulate(double lower, double upper, F&& f)
+    {
+        static_assert(N >= 2, "a table needs at least both end points");
+        std::array<double, N> table{};
+        const double step = (upper - lower) / static_cast<double>(N - 1);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            table[i] = f(i + 1 == N ? upper : lower + step * static_cast<double>(i));
+        }
+        return table;
+    }
+}
+
+#endif // CONSTEXPRMATH_H
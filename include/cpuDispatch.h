@@ -0,0 +1,180 @@
+#ifndef CPUDISPATCH_H
+#define CPUDISPATCH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "optionType.h"
+
+/**
+ * @file cpuDispatch.h
+ * @brief Runtime selection of the vectorized kernels in simdMath.h.
+ *
+ * The best level supported by the CPU is picked the first time the kernels are requested. Setting the
+ * environment variable FINANCE_SIMD_LEVEL to scalar, sse42, avx2 or avx512 before startup, or calling
+ * setSimdLevel(), forces a lower level, e.g. to test or benchmark one variant on a machine that
+ * supports a better one.
+ */
+
+/**
+ * @enum SimdLevel
+ * @brief Instruction set levels, ordered from least to most capable.
+ */
+enum SimdLevel {
+    SCALAR,
+    SSE42,
+    AVX2,
+    AVX512
+};
+
+/**
+ * @struct simdKernelTable
+ * @brief One implementation of every dispatched kernel, all from the same SimdLevel.
+ */
+struct simdKernelTable
+{
+    SimdLevel level;
+
+    void (*normalCDF)(const double* x, double* result, std::size_t count);
+
+    void (*exp)(const double* x, double* result, std::size_t count);
+
+    void (*log)(const double* x, double* result, std::size_t count);
+
+    void (*blackScholesPrice)(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                              const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                              const OptionType* optionType, double* optionPrice);
+
+    void (*blackScholesGreeks)(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                               const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                               const OptionType* optionType, double* optionPrice, double* delta, double* gamma,
+                               double* vega, double* theta, double* rho);
+
+    // Homogeneous batches, indexed by OptionType.
+    void (*blackScholesPriceOf[2])(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                   const double* timeToExperation, const double* riskFreeRate,
+                                   const double* volatility, double* optionPrice);
+
+    void (*blackScholesGreeksOf[2])(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                    const double* timeToExperation, const double* riskFreeRate,
+                                    const double* volatility, double* optionPrice, double* delta, double* gamma,
+                                    double* vega, double* theta, double* rho);
+
+    // Single precision.
+    void (*normalCDFFloat)(const float* x, float* result, std::size_t count);
+
+    void (*expFloat)(const float* x, float* result, std::size_t count);
+
+    void (*logFloat)(const float* x, float* result, std::size_t count);
+
+    void (*blackScholesPriceFloat)(std::size_t count, const float* underlyingPrice, const float* strikePrice,
+                                   const float* timeToExperation, const float* riskFreeRate,
+                                   const float* volatility, const OptionType* optionType, float* optionPrice,
+                                   float* relativeError);
+
+    // N(x) from the interpolation table in normalCDFTable.h.
+    void (*normalCDFTabulated)(const double* x, double* result, std::size_t count);
+
+    void (*blackScholesPriceTabulated)(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                       const double* timeToExperation, const double* riskFreeRate,
+                                       const double* volatility, const OptionType* optionType, double* optionPrice);
+
+    void (*blackScholesPriceTabulatedOf[2])(std::size_t count, const double* underlyingPrice,
+                                            const double* strikePrice, const double* timeToExperation,
+                                            const double* riskFreeRate, const double* volatility,
+                                            double* optionPrice);
+
+    // The strikes of one expiry, sharing ln(S), sqrt(T) and e^{-rT}.
+    void (*blackScholesChainPrice)(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                   std::size_t count, const double* strikePrice, const double* volatility,
+                                   const OptionType* optionType, double* optionPrice);
+
+    void (*blackScholesChainGreeks)(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                    std::size_t count, const double* strikePrice, const double* volatility,
+                                    const OptionType* optionType, double* optionPrice, double* delta,
+                                    double* gamma, double* vega, double* theta, double* rho);
+    void (*impliedVolatility)(std::size_t count, const double* optionPrice, const double* underlyingPrice,
+                              const double* strikePrice, const double* timeToExperation, const double* riskFreeRate,
+                              const OptionType* optionType, double* volatility, std::uint8_t* iterations);
+    void (*impliedVolatilityChain)(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                   std::size_t count, const double* optionPrice, const double* strikePrice,
+                                   const OptionType* optionType, const double* previousVolatility,
+                                   double* volatility, std::uint8_t* iterations);
+    void (*sviVolatility)(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                          const double* timeToExperation, const double* riskFreeRate, std::size_t sliceCount,
+                          const double* sliceTable, double* volatility);
+    void (*blackScholesSelectedGreeks)(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                       const double* timeToExperation, const double* riskFreeRate,
+                                       const double* volatility, const OptionType* optionType, unsigned greeks,
+                                       double* const* output);
+    void (*philoxNormalPairs)(std::uint64_t seed, std::uint64_t stream, std::uint64_t index, std::size_t count,
+                              double* first, double* second);
+    void (*hestonEulerVariance)(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0,
+                                double kappa, double theta, double sigma, double rho, double dt, int numTimeSteps,
+                                double* variance);
+    void (*hestonQEVariance)(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0, double decay,
+                             double mean, double varianceSlope, double varianceConstant, double rho, int numTimeSteps,
+                             double* variance);
+};
+
+/**
+ * @brief Gets the most capable level supported by this CPU and build.
+ * @return The detected level.
+ */
+SimdLevel detectSimdLevel();
+
+/**
+ * @brief Checks whether a level can run on this CPU and was built into this binary.
+ * @param level The level to check.
+ * @return True if the level's kernels can be called.
+ */
+bool isSimdLevelSupported(SimdLevel level);
+
+/**
+ * @brief Gets the level whose kernels simdKernels() currently returns.
+ * @return The active level.
+ */
+SimdLevel activeSimdLevel();
+
+/**
+ * @brief Forces the kernels returned by simdKernels() to a given level.
+ * @param level The level to use.
+ * @return False, leaving the active level unchanged, if the level is not supported.
+ */
+bool setSimdLevel(SimdLevel level);
+
+/**
+ * @brief Returns to the level chosen at startup (detected, or FINANCE_SIMD_LEVEL if set).
+ */
+void resetSimdLevel();
+
+/**
+ * @brief Gets the kernels of the active level.
+ * @return The active kernel table.
+ */
+const simdKernelTable& simdKernels();
+
+/**
+ * @brief Gets the kernels of a given level.
+ * @param level The level.
+ * @return The kernel table, or nullptr if the level is not supported.
+ */
+const simdKernelTable* simdKernelsFor(SimdLevel level);
+
+/**
+ * @brief Gets the lowercase name of a level, as accepted by FINANCE_SIMD_LEVEL.
+ * @param level The level.
+ * @return The level name.
+ */
+const char* simdLevelName(SimdLevel level);
+
+/**
+ * @brief Parses a level name (scalar, sse42, avx2 or avx512).
+ * @param name The name to parse.
+ * @param level Receives the level if the name is valid.
+ * @return True if the name is valid.
+ */
+bool parseSimdLevel(const std::string& name, SimdLevel& level);
+
+#endif // CPUDISPATCH_H
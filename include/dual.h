@@ -0,0 +1,254 @@
+#ifndef DUAL_H
+#define DUAL_H
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+#include "constexprMath.h"
+
+/**
+ * @file dual.h
+ * @brief Forward-mode automatic differentiation: a value carried with its derivatives along N inputs.
+ *
+ * dual<T, N> holds f and the N partial derivatives df/dx_i of whatever was computed from inputs seeded by
+ * dualVariable. Every operation applies the chain rule to all N tangents, so one evaluation of a formula
+ * written for a generic scalar gives the whole gradient. The tangents are one contiguous array and every
+ * operation is a loop over it, which the compiler vectorizes.
+ *
+ * T may itself be a dual: in secondOrderDual<N> = dual<dual<double, N>, N> the tangents of the tangents are
+ * the second derivatives d^2f / dx_i dx_j (see secondOrderVariable). When only some rows of the Hessian
+ * are wanted, secondOrderDual<N, M> carries M of them. Derivatives are those of the formula as evaluated,
+ * exact up to rounding: no step size is involved.
+ *
+ * Comparisons look at the value only, so branches (abs, the sign tests of normalCDF) follow the point of
+ * evaluation. Everything is constexpr, as in pricingCore.h.
+ */
+
+template <class T, std::size_t N>
+struct dual;
+
+/// @brief true for dual<T, N> of any T and N.
+template <class T>
+inline constexpr bool isDual = false;
+
+template <class T, std::size_t N>
+inline constexpr bool isDual<dual<T, N>> = true;
+
+/// @brief The scalars the generic pricing functions accept: double and duals of it, at any depth.
+template <class T>
+concept pricingScalar = std::is_same_v<T, double> || isDual<T>;
+
+/**
+ * @brief Gets the plain value of a scalar, through any number of dual levels.
+ */
+constexpr double primal(double x)
+{
+    return x;
+}
+
+template <class T, std::size_t N>
+constexpr double primal(const dual<T, N>& x)
+{
+    return primal(x.value);
+}
+
+template <class T, std::size_t N>
+struct dual
+{
+    T value;
+    std::array<T, N> tangent;   // d value / d input i
+
+    constexpr dual() : value(), tangent() {}
+
+    /// @brief A constant: every tangent is zero.
+    constexpr dual(double constant) : value(constant), tangent() {}
+
+    /// @brief A constant of the inner type, for nested duals.
+    constexpr dual(const T& constant) requires (!std::is_same_v<T, double>) : value(constant), tangent() {}
+
+    /**
+     * @brief Applies the chain rule of a function of one argument.
+     * @param x The argument.
+     * @param value f(x.value).
+     * @param derivative f'(x.value).
+     * @return f(x) with tangents f'(x) x.tangent.
+     */
+    static constexpr dual chain(const dual& x, const T& value, const T& derivative)
+    {
+        dual result(value);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            result.tangent[i] = derivative * x.tangent[i];
+        }
+        return result;
+    }
+
+    friend constexpr dual operator-(const dual& a)
+    {
+        dual result(-a.value);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            result.tangent[i] = -a.tangent[i];
+        }
+        return result;
+    }
+
+    friend constexpr dual operator+(const dual& a, const dual& b)
+    {
+        dual result(a.value + b.value);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            result.tangent[i] = a.tangent[i] + b.tangent[i];
+        }
+        return result;
+    }
+
+    friend constexpr dual operator-(const dual& a, const dual& b)
+    {
+        dual result(a.value - b.value);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            result.tangent[i] = a.tangent[i] - b.tangent[i];
+        }
+        return result;
+    }
+
+    friend constexpr dual operator*(const dual& a, const dual& b)
+    {
+        dual result(a.value * b.value);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            result.tangent[i] = a.tangent[i] * b.value + a.value * b.tangent[i];
+        }
+        return result;
+    }
+
+    friend constexpr dual operator/(const dual& a, const dual& b)
+    {
+        // One division for all the tangents.
+        const T reciprocal = 1.0 / b.value;
+        const T quotient = a.value * reciprocal;
+        dual result(quotient);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            result.tangent[i] = (a.tangent[i] - quotient * b.tangent[i]) * reciprocal;
+        }
+        return result;
+    }
+
+    // With a plain number only the tangents of the dual operand are touched.
+    friend constexpr dual operator+(const dual& a, double b)
+    {
+        dual result = a;
+        result.value = a.value + b;
+        return result;
+    }
+
+    friend constexpr dual operator+(double a, const dual& b) { return b + a; }
+
+    friend constexpr dual operator-(const dual& a, double b) { return a + (-b); }
+
+    friend constexpr dual operator-(double a, const dual& b) { return -b + a; }
+
+    friend constexpr dual operator*(const dual& a, double b)
+    {
+        dual result(a.value * b);
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            result.tangent[i] = a.tangent[i] * b;
+        }
+        return result;
+    }
+
+    friend constexpr dual operator*(double a, const dual& b) { return b * a; }
+
+    friend constexpr dual operator/(const dual& a, double b) { return a * (1.0 / b); }
+
+    friend constexpr dual operator/(double a, const dual& b)
+    {
+        const T reciprocal = 1.0 / b.value;
+        return chain(b, a * reciprocal, -a * reciprocal * reciprocal);
+    }
+
+    friend constexpr bool operator<(const dual& a, const dual& b) { return primal(a) < primal(b); }
+    friend constexpr bool operator>(const dual& a, const dual& b) { return primal(a) > primal(b); }
+    friend constexpr bool operator<=(const dual& a, const dual& b) { return primal(a) <= primal(b); }
+    friend constexpr bool operator>=(const dual& a, const dual& b) { return primal(a) >= primal(b); }
+    friend constexpr bool operator==(const dual& a, const dual& b) { return primal(a) == primal(b); }
+
+    // Found by argument-dependent lookup, next to the constexprMath functions of the same names.
+    friend constexpr dual exp(const dual& x)
+    {
+        using constexprMath::exp;
+        const T e = exp(x.value);
+        return chain(x, e, e);
+    }
+
+    friend constexpr dual log(const dual& x)
+    {
+        using constexprMath::log;
+        return chain(x, log(x.value), 1.0 / x.value);
+    }
+
+    friend constexpr dual sqrt(const dual& x)
+    {
+        using constexprMath::sqrt;
+        const T root = sqrt(x.value);
+        return chain(x, root, 0.5 / root);
+    }
+
+    friend constexpr dual abs(const dual& x)
+    {
+        return primal(x) < 0.0 ? -x : x;
+    }
+};
+
+/**
+ * @brief Seeds input i: the value x with tangent 1 along i and 0 along the others.
+ * @param x The value of the input.
+ * @param i Which of the N inputs it is.
+ * @return The seeded input.
+ */
+template <std::size_t N>
+constexpr dual<double, N> dualVariable(double x, std::size_t i)
+{
+    dual<double, N> result(x);
+    result.tangent[i] = 1.0;
+    return result;
+}
+
+/// @brief Carries the first derivatives along N inputs and the second derivatives along M of them times
+/// all N: 1 + N + M (N + 1) doubles.
+template <std::size_t N, std::size_t M = N>
+using secondOrderDual = dual<dual<double, N>, M>;
+
+/**
+ * @brief Seeds input i for second derivatives: f(x).value.tangent[i] is df/dx_i and, for the inputs seeded
+ *        with an outer index j < M, f(x).tangent[j].tangent[i] is d^2f / dx_j dx_i.
+ * @param x The value of the input.
+ * @param i Which of the N inputs it is.
+ * @param j Which of the M inputs of the second derivatives it is, M or more if none.
+ * @return The seeded input.
+ */
+template <std::size_t N, std::size_t M = N>
+constexpr secondOrderDual<N, M> secondOrderVariable(double x, std::size_t i, std::size_t j)
+{
+    secondOrderDual<N, M> result(dualVariable<N>(x, i));
+    if (j < M)
+    {
+        result.tangent[j] = dual<double, N>(1.0);
+    }
+    return result;
+}
+
+/**
+ * @brief Seeds input i for all second derivatives, d^2f / dx_j dx_i = f(x).tangent[j].tangent[i].
+ */
+template <std::size_t N>
+constexpr secondOrderDual<N> secondOrderVariable(double x, std::size_t i)
+{
+    return secondOrderVariable<N, N>(x, i, i);
+}
+
+#endif // DUAL_H
@@ -0,0 +1,50 @@
+#ifndef GREEKMASK_H
+#define GREEKMASK_H
+
+#include <bit>
+
+/**
+ * @enum GreekMask
+ * @brief Bits selecting which results a specialized pricing kernel computes.
+ *
+ * Used as a template argument, e.g. blackScholesPriceAndGreeks<CALL, GREEK_PRICE | GREEK_DELTA>, so the
+ * unused parts of the evaluation are removed at compile time. The template kernels read only the bits of
+ * GREEK_ALL.
+ *
+ * The batch Greeks function with a runtime mask (batchPricing.h) also takes the adjusted deltas and
+ * adjusted prices of optionGreeksModel, evaluated with the same formulas from the first-order Greeks.
+ */
+enum GreekMask : unsigned {
+    GREEK_PRICE = 1u << 0,
+    GREEK_DELTA = 1u << 1,
+    GREEK_GAMMA = 1u << 2,
+    GREEK_VEGA = 1u << 3,
+    GREEK_THETA = 1u << 4,
+    GREEK_RHO = 1u << 5,
+    GREEK_IV_ADJUSTED_DELTA = 1u << 6,
+    GREEK_GAMMA_ADJUSTED_DELTA = 1u << 7,
+    GREEK_VEGA_ADJUSTED_DELTA = 1u << 8,
+    GREEK_THETA_ADJUSTED_DELTA = 1u << 9,
+    GREEK_GAMMA_VEGA_ADJUSTED_DELTA = 1u << 10,
+    GREEK_PRICE_IV = 1u << 11,
+    GREEK_PRICE_GAMMA = 1u << 12,
+    GREEK_PRICE_VEGA = 1u << 13,
+    GREEK_PRICE_THETA = 1u << 14,
+    GREEK_PRICE_GAMMA_VEGA = 1u << 15,
+    GREEK_ALL = GREEK_PRICE | GREEK_DELTA | GREEK_GAMMA | GREEK_VEGA | GREEK_THETA | GREEK_RHO,
+    GREEK_ADJUSTED_ALL = GREEK_IV_ADJUSTED_DELTA | GREEK_GAMMA_ADJUSTED_DELTA | GREEK_VEGA_ADJUSTED_DELTA
+                         | GREEK_THETA_ADJUSTED_DELTA | GREEK_GAMMA_VEGA_ADJUSTED_DELTA | GREEK_PRICE_IV
+                         | GREEK_PRICE_GAMMA | GREEK_PRICE_VEGA | GREEK_PRICE_THETA | GREEK_PRICE_GAMMA_VEGA
+};
+
+/// @brief Number of GreekMask bits, i.e. of output columns of the runtime-mask batch Greeks.
+inline constexpr unsigned GREEK_COUNT = 16;
+
+/**
+ * @brief Gets the output column of a single GreekMask bit.
+ * @param greek One bit.
+ * @return Its position, 0 for GREEK_PRICE up to GREEK_COUNT - 1.
+ */
+constexpr unsigned greekIndex(unsigned greek) { return static_cast<unsigned>(std::countr_zero(greek)); }
+
+#endif //GREEKMASK_H
@@ -3,7 +3,9 @@
 
 #include "blackScholesModel.h"
 #include "optionGreeksModel.h"
+#include "pricingCore.h"
 
+#include <cstdint>
 #include <random>
 
 class hestonModel : public blackScholesModel
@@ -15,19 +17,26 @@ class hestonModel : public blackScholesModel
 
         double calculateOptionPrice(bool useMonteCarlo, int num_simulations, int num_time_steps) const;
 
+        /**
+         * @brief Monte Carlo price with its sensitivities in S, r, v0, kappa, theta, sigma and rho, from one
+         *        simulation and its adjoint (see hestonMonteCarloSensitivities).
+         * @return The price and sensitivities, all NaN for invalid inputs.
+         */
+        hestonSensitivities calculateMonteCarloSensitivities(int num_simulations, int num_time_steps) const;
+
         double random_normal(std::mt19937& generator) const;
 
         double simulateVariance(std::mt19937& generator, int num_time_steps) const;
 
-        void setV0(const double& value) const;
+        void setV0(const double& value);
 
-        void setKappa(const double& value) const;
+        void setKappa(const double& value);
 
-        void setTheta(const double& value) const;
+        void setTheta(const double& value);
 
-        void setSigma(const double& value) const;
+        void setSigma(const double& value);
 
-        void setRho(const double& value) const;
+        void setRho(const double& value);
 
         const double& getV0() const;
 
@@ -39,13 +48,35 @@ class hestonModel : public blackScholesModel
 
         const double& getRho() const;
 
+        hestonParameters getParameters() const;
+
+        void setNormalCDFMethod(NormalCDFMethod method);
+
+        NormalCDFMethod getNormalCDFMethod() const;
+
+        void setThreadCount(unsigned threadCount);
+
+        unsigned getThreadCount() const;
+
+        void setSeed(std::uint64_t seed);
+
+        std::uint64_t getSeed() const;
+
+        void setDiscretization(HestonDiscretization discretization);
+
+        HestonDiscretization getDiscretization() const;
+
     
         private:
-            mutable double _v0;     // initial volatility
-            mutable double _kappa;  // rate at which v_t reverts to theta
-            mutable double _theta;  // long variance / long-run average variance of the price
-            mutable double _sigma;  // volatility of volatility
-            mutable double _rho;    // correlation of the two wiener processes
+            double _v0;     // initial volatility
+            double _kappa;  // rate at which v_t reverts to theta
+            double _theta;  // long variance / long-run average variance of the price
+            double _sigma;  // volatility of volatility
+            double _rho;    // correlation of the two wiener processes
+            NormalCDFMethod _normalCDFMethod = CDF_POLYNOMIAL;  // N(x) in the Monte Carlo Black-Scholes prices
+            unsigned _threadCount = 0;  // Monte Carlo worker threads, 0 for one per hardware thread
+            std::uint64_t _seed = 0;    // key of the counter-based Monte Carlo normals
+            HestonDiscretization _discretization = HESTON_EULER;  // Monte Carlo variance step
 
 };
 
@@ -0,0 +1,193 @@
+#ifndef IMPLIEDVOLATILITYCACHE_H
+#define IMPLIEDVOLATILITYCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "optionType.h"
+
+/**
+ * @file impliedVolatilityCache.h
+ * @brief A bounded, thread-safe cache of implied volatilities keyed by quantized quotes.
+ *
+ * A quote is reduced to the integers round(price / priceTick), round(spot / spotTick), ..., plus its type,
+ * so republished quotes and quotes that differ by less than a tick share an entry. Each entry holds the
+ * volatility of the first quote that created it; with the default ticks that is within about 1e-8 / vega
+ * of the volatility of any other quote of the entry.
+ *
+ * Entries are spread over shards by the hash of their key, each shard an open-addressing table with its own
+ * mutex, so threads working on different quotes rarely wait for each other. Every shard holds at most
+ * capacity / shards entries, evicts by the configured policy when it is full and, once full, reuses the
+ * evicted entry: a lookup never allocates. A hit costs about as much as a hash and one or two cache misses,
+ * a miss the solve plus that.
+ */
+
+/**
+ * @enum cacheEviction
+ * @brief The entry a full shard gives up for a new one.
+ */
+enum cacheEviction
+{
+    LEAST_RECENTLY_USED,    // the entry least recently looked up or inserted
+    FIRST_IN_FIRST_OUT      // the oldest entry, however often it is hit
+};
+
+/**
+ * @struct quoteQuantization
+ * @brief The tick of every quote field: quotes that round to the same multiples share a cache entry.
+ */
+struct quoteQuantization
+{
+    double priceTick = 1e-8;
+    double underlyingTick = 1e-8;
+    double strikeTick = 1e-8;
+    double timeTick = 1e-8;     // years, about 0.3 seconds
+    double rateTick = 1e-10;
+};
+
+/**
+ * @struct impliedVolatilityCacheStats
+ * @brief Counters of a cache since it was created or its statistics were last reset.
+ */
+struct impliedVolatilityCacheStats
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::uint64_t uncacheable = 0;  // quotes with a field that is not finite or too large for its tick
+    std::size_t size = 0;           // entries held
+
+    /**
+     * @brief Gets the fraction of lookups answered from the cache.
+     * @return hits / (hits + misses), 0 before the first lookup.
+     */
+    double hitRate() const { return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / (hits + misses); }
+};
+
+/**
+ * @class impliedVolatilityCache
+ * @brief Implied volatilities of quantized quotes, computed by impliedVolatility on a miss.
+ */
+class impliedVolatilityCache
+{
+    public:
+        /**
+         * @brief Creates an empty cache.
+         * @param capacity Maximum number of entries, rounded up to a multiple of shards; 0 disables caching.
+         * @param eviction The entry a full shard evicts.
+         * @param quantization The ticks of the quote fields.
+         * @param shards Number of independently locked shards.
+         */
+        explicit impliedVolatilityCache(std::size_t capacity = 1 << 16, cacheEviction eviction = LEAST_RECENTLY_USED,
+                                        const quoteQuantization& quantization = quoteQuantization(),
+                                        std::size_t shards = 16);
+
+        /**
+         * @brief Gets the implied volatility of a quote, from the cache or by solving and caching it.
+         *
+         * Prices outside the no-arbitrage bounds are cached as NaN like any other result.
+         *
+         * @param optionPrice The option price.
+         * @param underlyingPrice The price of the underlying asset.
+         * @param strikePrice The strike price of the option.
+         * @param timeToExperation Time to expiration in years.
+         * @param riskFreeRate The risk-free interest rate.
+         * @param optionType CALL or PUT.
+         * @return The implied volatility, as impliedVolatility returns it.
+         */
+        double impliedVolatility(double optionPrice, double underlyingPrice, double strikePrice,
+                                 double timeToExperation, double riskFreeRate, OptionType optionType);
+
+        /**
+         * @brief Changes the capacity, eviction policy and ticks, and empties the cache.
+         *
+         * Not safe while other threads use the cache; statistics are kept.
+         *
+         * @param capacity Maximum number of entries; 0 disables caching.
+         * @param eviction The entry a full shard evicts.
+         * @param quantization The ticks of the quote fields.
+         */
+        void configure(std::size_t capacity, cacheEviction eviction, const quoteQuantization& quantization);
+
+        /**
+         * @brief Removes every entry; statistics are kept.
+         */
+        void clear();
+
+        /**
+         * @brief Sums the counters of every shard.
+         * @return The statistics.
+         */
+        impliedVolatilityCacheStats statistics() const;
+
+        /**
+         * @brief Sets every counter of statistics() except size to zero.
+         */
+        void resetStatistics();
+
+        /**
+         * @brief Gets the maximum number of entries.
+         * @return The capacity, a multiple of the number of shards.
+         */
+        std::size_t capacity() const { return _shardCapacity * _shardCount; }
+
+    private:
+        struct quoteKey
+        {
+            std::int64_t price;
+            std::int64_t underlying;
+            std::int64_t strike;
+            std::int64_t time;
+            std::int64_t rate;
+            OptionType type;
+
+            bool operator==(const quoteKey& other) const = default;
+        };
+
+        static constexpr std::uint32_t none = 0xFFFFFFFFu;
+
+        struct entry
+        {
+            quoteKey key;
+            std::uint64_t hash;
+            double volatility;
+            std::uint32_t newer;
+            std::uint32_t older;
+        };
+
+        // Linear probing over a pool of entries threaded on a list from the newest (or most recently used)
+        // entry to the one evicted next.
+        struct shard
+        {
+            mutable std::mutex lock;
+            std::vector<entry> entries;             // grows to the shard capacity, then entries are reused
+            std::vector<std::uint32_t> index;       // entry + 1 per bucket, 0 if empty; at least twice the capacity
+            std::uint32_t newest = none;
+            std::uint32_t oldest = none;
+            std::uint64_t hits = 0;
+            std::uint64_t misses = 0;
+            std::uint64_t evictions = 0;
+            std::uint64_t uncacheable = 0;
+
+            std::size_t find(const quoteKey& key, std::uint64_t hash) const;
+            void erase(std::size_t bucket);
+            void unlink(std::uint32_t e);
+            void pushNewest(std::uint32_t e);
+            void reset(std::size_t capacity);
+        };
+
+        static std::uint64_t hashKey(const quoteKey& key);
+        bool quantize(double optionPrice, double underlyingPrice, double strikePrice, double timeToExperation,
+                      double riskFreeRate, OptionType optionType, quoteKey& key) const;
+
+        std::size_t _shardCount;
+        std::size_t _shardCapacity;
+        cacheEviction _eviction;
+        quoteQuantization _quantization;
+        std::unique_ptr<shard[]> _shards;
+};
+
+#endif // IMPLIEDVOLATILITYCACHE_H
@@ -0,0 +1,110 @@
+#ifndef NORMALCDFTABLE_H
+#define NORMALCDFTABLE_H
+
+#include <array>
+#include <cstddef>
+#include <numbers>
+
+#include "constexprMath.h"
+
+/**
+ * @file normalCDFTable.h
+ * @brief N(x) from a precomputed table with cubic Hermite interpolation.
+ *
+ * [-8, 8] is split into 512 intervals of width h = 1/32. On each interval N is replaced by the cubic
+ * that matches N and its derivative phi at both ends. The coefficients are computed by the compiler
+ * (constexprMath::erfc) and take 16 KB, so the table stays in L1 while a batch or a Monte Carlo loop
+ * uses it. One evaluation costs an index computation, one cache line and three fused multiply-adds,
+ * where the Abramowitz-Stegun polynomial costs an exp, a division and five multiply-adds.
+ *
+ * Error bound: the Hermite remainder is at most h^4 / 384 max|N''''| = h^4 / 384 * 0.5506 = 1.37e-9 on
+ * every interval. Outside [-8, 8] the result is clamped to the end values, which adds at most
+ * N(-8) = 6.2e-16. The maximum absolute error against 0.5 * erfc(-x / sqrt(2)) is therefore 1.4e-9
+ * (normalCDFTable::errorBound), against 7.5e-8 for the polynomial. The error is absolute: deep in the
+ * lower tail the relative error is not small.
+ */
+
+/**
+ * @enum NormalCDFMethod
+ * @brief How a pricing function evaluates N(x).
+ */
+enum NormalCDFMethod
+{
+    CDF_POLYNOMIAL, // Abramowitz-Stegun 26.2.17, max absolute error 7.5e-8 (the default everywhere)
+    CDF_TABLE       // normalCDFTabulated, max absolute error 1.4e-9
+};
+
+namespace normalCDFTable
+{
+    inline constexpr double lower = -8.0;
+    inline constexpr double upper = 8.0;
+    inline constexpr std::size_t intervals = 512;
+    inline constexpr double step = (upper - lower) / intervals;
+    inline constexpr double inverseStep = intervals / (upper - lower);
+    inline constexpr double errorBound = 1.4e-9;
+
+    namespace detail
+    {
+        constexpr double exactCDF(double x)
+        {
+            return 0.5 * constexprMath::erfc(-x / std::numbers::sqrt2);
+        }
+
+        constexpr double exactPDF(double x)
+        {
+            return std::numbers::inv_sqrtpi / std::numbers::sqrt2 * constexprMath::exp(-0.5 * x * x);
+        }
+
+        /// @brief c0..c3 of every interval, so that N(x_i + u h) = c0 + u (c1 + u (c2 + u c3)), 0 <= u <= 1.
+        constexpr std::array<double, 4 * intervals> hermiteCoefficients()
+        {
+            constexpr auto value = constexprMath::tabulate<intervals + 1>(lower, upper, exactCDF);
+            constexpr auto slope = constexprMath::tabulate<intervals + 1>(lower, upper, exactPDF);
+
+            std::array<double, 4 * intervals> coefficients{};
+            for (std::size_t i = 0; i < intervals; ++i)
+            {
+                const double p0 = value[i];
+                const double p1 = value[i + 1];
+                const double m0 = step * slope[i];
+                const double m1 = step * slope[i + 1];
+                coefficients[4 * i] = p0;
+                coefficients[4 * i + 1] = m0;
+                coefficients[4 * i + 2] = 3.0 * (p1 - p0) - 2.0 * m0 - m1;
+                coefficients[4 * i + 3] = 2.0 * (p0 - p1) + m0 + m1;
+            }
+            return coefficients;
+        }
+    }
+
+    /// The four coefficients of interval i are at 4 i .. 4 i + 3, in one 32-byte aligned group.
+    alignas(64) inline constexpr std::array<double, 4 * intervals> coefficients = detail::hermiteCoefficients();
+}
+
+/**
+ * @brief N(x) by table lookup and cubic interpolation, max absolute error 1.4e-9.
+ * @param x The value to calculate the CDF for.
+ * @return The CDF value, NaN if x is NaN.
+ */
+constexpr double normalCDFTabulated(double x)
+{
+    if (x != x)
+    {
+        return x;
+    }
+
+    const double clamped = x < normalCDFTable::lower ? normalCDFTable::lower
+                         : (x > normalCDFTable::upper ? normalCDFTable::upper : x);
+    const double t = (clamped - normalCDFTable::lower) * normalCDFTable::inverseStep;
+    std::size_t i = static_cast<std::size_t>(t);
+    if (i >= normalCDFTable::intervals)
+    {
+        i = normalCDFTable::intervals - 1;
+    }
+    const double u = t - static_cast<double>(i);
+
+    const double* c = normalCDFTable::coefficients.data() + 4 * i;
+    return c[0] + u * (c[1] + u * (c[2] + u * c[3]));
+}
+
+#endif // NORMALCDFTABLE_H
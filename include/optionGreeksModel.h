@@ -3,6 +3,7 @@
 
 #include "blackScholesModel.h"
 #include "optionGreeks.h"
+#include "impliedVolatilityCache.h"
 
 /**
  * @class optionGreeksModel
@@ -128,16 +129,34 @@ class optionGreeksModel : public virtual blackScholesModel, public optionGreeks
 
 
         /**
-         * @brief Calculates the implied volatility.
-         * @return The calculated implied volatility.
+         * @brief Calculates the implied volatility of the model's own Black-Scholes price.
+         * @return The calculated implied volatility: the model volatility, up to the error of normalCDF in the price.
          */
         double calculateImpliedVolatility() const;
 
+        /**
+         * @brief Calculates the volatility at which the Black-Scholes price of this option equals a market price.
+         * @param marketPrice The observed option price.
+         * @return The implied volatility (see impliedVolatility.h), NaN if the price is outside the no-arbitrage bounds.
+         */
+        double calculateImpliedVolatility(double marketPrice) const;
+
+        /**
+         * @brief Gets the cache every model's calculateImpliedVolatility goes through.
+         *
+         * Shared by all models and threads, so a quote republished unchanged is solved once. Use
+         * configure() to resize it or change its eviction policy and ticks, capacity 0 to turn it off,
+         * and statistics() for its hit rate.
+         *
+         * @return The process-wide implied volatility cache.
+         */
+        static impliedVolatilityCache& impliedVolatilityQuoteCache();
+
         
         /**
          * @brief Calculates the option price based on implied volatility.
          */
-        void calculateOptionPriceIV() const;
+        void calculateOptionPriceIV();
 
         /**
          * @brief Calculates the option price gamma.
@@ -188,7 +207,7 @@ class optionGreeksModel : public virtual blackScholesModel, public optionGreeks
          * @brief Calculates d1 used in various option pricing models.
          * @param impliedVolatility The implied volatility to be used in the calculation.
          */
-        void calculateD1(double impliedVolatility) const;
+        void calculateD1(double impliedVolatility);
 
     private:
         mutable double _ivAdjustedDelta;
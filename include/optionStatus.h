@@ -0,0 +1,44 @@
+#ifndef OPTIONSTATUS_H
+#define OPTIONSTATUS_H
+
+#include <cstdint>
+
+#include "optionType.h"
+
+/**
+ * @enum OptionStatus
+ * @brief Bits marking which inputs of an option are invalid; OPTION_VALID (0) if none is.
+ *
+ * The rules are those of the blackScholesModel setters and the batch kernels, plus the inputs the
+ * formula cannot take at all: NaN anywhere, underlying or strike price not positive, negative time to
+ * expiration, volatility outside (0, 1) and an option type that is neither CALL nor PUT.
+ */
+enum OptionStatus : std::uint8_t {
+    OPTION_VALID = 0,
+    INVALID_UNDERLYING_PRICE = 1u << 0,
+    INVALID_STRIKE_PRICE = 1u << 1,
+    INVALID_TIME_TO_EXPERATION = 1u << 2,
+    INVALID_RISK_FREE_RATE = 1u << 3,
+    INVALID_VOLATILITY = 1u << 4,
+    INVALID_OPTION_TYPE = 1u << 5
+};
+
+/**
+ * @brief The OptionStatus bits of one option, without branches.
+ *
+ * Every comparison is written so that NaN fails it, and the results are combined arithmetically, so a
+ * loop over a batch compiles to vector compares and needs no exception handling or early exit.
+ */
+constexpr std::uint8_t optionInputStatus(double underlyingPrice, double strikePrice, double timeToExperation,
+                                         double riskFreeRate, double volatility, OptionType optionType)
+{
+    return static_cast<std::uint8_t>(
+        !(underlyingPrice > 0.0) * INVALID_UNDERLYING_PRICE
+        | !(strikePrice > 0.0) * INVALID_STRIKE_PRICE
+        | !(timeToExperation >= 0.0) * INVALID_TIME_TO_EXPERATION
+        | (riskFreeRate != riskFreeRate) * INVALID_RISK_FREE_RATE
+        | !((volatility > 0.0) & (volatility < 1.0)) * INVALID_VOLATILITY
+        | ((optionType != CALL) & (optionType != PUT)) * INVALID_OPTION_TYPE);
+}
+
+#endif //OPTIONSTATUS_H
@@ -0,0 +1,104 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+/**
+ * @file philox.h
+ * @brief The Philox4x32-10 counter-based generator (Salmon et al., "Parallel random numbers: as easy as
+ *        1, 2, 3", SC 2011) and the normals drawn from it.
+ *
+ * philox4x32 is a keyed bijection of a 128-bit counter: the numbers of a counter depend on the key and the
+ * counter only, not on what was drawn before. Monte Carlo paths keyed by (seed, path, draw) therefore get
+ * the same numbers whichever thread simulates them and in whatever order, without seeding or skipping
+ * ahead a stateful generator.
+ */
+
+/**
+ * @brief Ten Philox rounds of a counter under a key.
+ * @param counter The 128-bit counter.
+ * @param key The 64-bit key.
+ * @return Four uniformly distributed 32-bit numbers.
+ */
+constexpr std::array<std::uint32_t, 4> philox4x32(std::array<std::uint32_t, 4> counter, std::array<std::uint32_t, 2> key)
+{
+    constexpr std::uint64_t multiplier0 = 0xD2511F53u;
+    constexpr std::uint64_t multiplier1 = 0xCD9E8D57u;
+    constexpr std::uint32_t weyl0 = 0x9E3779B9u;
+    constexpr std::uint32_t weyl1 = 0xBB67AE85u;
+
+    for (int round = 0; round < 10; ++round)
+    {
+        const std::uint64_t product0 = multiplier0 * counter[0];
+        const std::uint64_t product1 = multiplier1 * counter[2];
+        counter = {static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<std::uint32_t>(product1),
+                   static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<std::uint32_t>(product0)};
+        key[0] += weyl0;
+        key[1] += weyl1;
+    }
+    return counter;
+}
+
+/**
+ * @brief Maps 64 random bits to a double uniform in (0, 1): the top 52 bits on the 2^-52 grid shifted by
+ *        half a step, which is exact, so neither 0 nor 1 can come out.
+ */
+constexpr double philoxUniform(std::uint32_t high, std::uint32_t low)
+{
+    // 1 + bits 2^-52 is built by setting the exponent, which vectorizes where a 64-bit conversion does not.
+    const std::uint64_t bits = (static_cast<std::uint64_t>(high) << 32 | low) >> 12;
+    return (std::bit_cast<double>(bits | 0x3FF0000000000000ull) - 1.0) + 0x1.0p-53;
+}
+
+/**
+ * @brief Two independent standard normals from one Philox counter, by the Box-Muller transform.
+ * @param seed The key.
+ * @param stream The high 64 bits of the counter, e.g. a path index.
+ * @param index The low 64 bits of the counter, e.g. a time step.
+ * @return The pair of normals of (seed, stream, index).
+ */
+inline std::array<double, 2> philoxNormalPair(std::uint64_t seed, std::uint64_t stream, std::uint64_t index)
+{
+    const std::array<std::uint32_t, 4> bits = philox4x32(
+        {static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(index >> 32),
+         static_cast<std::uint32_t>(stream), static_cast<std::uint32_t>(stream >> 32)},
+        {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)});
+    const double radius = std::sqrt(-2.0 * std::log(philoxUniform(bits[0], bits[1])));
+    const double angle = 2.0 * std::numbers::pi * philoxUniform(bits[2], bits[3]);
+    return {radius * std::cos(angle), radius * std::sin(angle)};
+}
+
+/**
+ * @class philoxNormalStream
+ * @brief The standard normals of one stream of a seed, in order: draws 2k and 2k + 1 are the pair of
+ *        counter (stream, k).
+ */
+class philoxNormalStream
+{
+    public:
+        constexpr philoxNormalStream(std::uint64_t seed, std::uint64_t stream) : _seed(seed), _stream(stream) {}
+
+        /**
+         * @brief Draws the next normal of the stream.
+         */
+        double operator()()
+        {
+            if ((_draw & 1) == 0)
+            {
+                _pair = philoxNormalPair(_seed, _stream, _draw >> 1);
+            }
+            return _pair[_draw++ & 1];
+        }
+
+    private:
+        std::uint64_t _seed;
+        std::uint64_t _stream;
+        std::uint64_t _draw = 0;
+        std::array<double, 2> _pair = {0.0, 0.0};
+};
+
+#endif // PHILOX_H
@@ -0,0 +1,43 @@
+#ifndef RANDOMNORMALS_H
+#define RANDOMNORMALS_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @file randomNormals.h
+ * @brief Buffers of standard normals from the Philox counters of philox.h, generated by the vectorized kernel
+ *        of the detected instruction set.
+ *
+ * Pair k of a stream is the Box-Muller transform of the four 32-bit numbers of counter (stream, k), so any
+ * part of any stream can be generated on its own, by any thread, in any order. The values equal those of
+ * philoxNormalPair up to the rounding of the log, sine and cosine kernels (a few ulp), and are the same on
+ * every call at the same dispatch level. For the Monte Carlo engines a stream is a path and a pair is the two
+ * normals of one time step.
+ */
+
+/**
+ * @brief Generates the normal pairs of consecutive counters of one stream.
+ * @param seed The Philox key.
+ * @param stream The stream, e.g. a path index.
+ * @param index The counter of the first pair, e.g. a time step.
+ * @param count Number of pairs.
+ * @param first Output first normal of every pair, count elements.
+ * @param second Output second normal of every pair, count elements.
+ */
+void philoxNormalPairs(std::uint64_t seed, std::uint64_t stream, std::uint64_t index, std::size_t count,
+                       double* first, double* second);
+
+/**
+ * @brief Fills a buffer with the normals of one stream in draw order, as philoxNormalStream draws them:
+ *        output[j] is the (j % 2)-th normal of pair firstPair + j / 2.
+ * @param seed The Philox key.
+ * @param stream The stream.
+ * @param firstPair The counter of the first pair.
+ * @param count Number of normals; an odd count drops the second normal of the last pair.
+ * @param output Output normals, count elements.
+ */
+void philoxNormals(std::uint64_t seed, std::uint64_t stream, std::uint64_t firstPair, std::size_t count,
+                   double* output);
+
+#endif // RANDOMNORMALS_H
@@ -0,0 +1,1456 @@
+#ifndef SIMDKERNELS_H
+#define SIMDKERNELS_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+#include "simdVector.h"
+#include "optionType.h"
+#include "greekMask.h"
+#include "normalCDFTable.h"
+#include "millsRatioTable.h"
+#include "philox.h"
+
+/**
+ * @file simdKernels.h
+ * @brief Vector-width-agnostic math and pricing kernels.
+ *
+ * Every kernel is a template over one of the `vec` types from simdVector.h and is only meant to be
+ * instantiated from the per-instruction-set translation units (simdMath*.cpp). Accuracy, measured
+ * over [-40, 40] for N(x), [-745, 709] for exp and [1e-300, 1e300] for log:
+ *  - expKernel: max relative error 2 ulp against std::exp; results below ~-708.4 are subnormal.
+ *  - logKernel: max relative error 2 ulp against std::log; subnormal inputs are supported.
+ *  - normalCDFKernel: the Abramowitz-Stegun 26.2.17 polynomial used by blackScholesModel::normalCDF,
+ *    max absolute error 7.5e-8 against 0.5 * std::erfc(-x / sqrt(2)), and within 1e-15 of the
+ *    scalar blackScholesModel::normalCDF.
+ *  - normalCDFTableKernel: normalCDFTabulated from normalCDFTable.h with gathers, max absolute error 1.4e-9.
+ *  - sinCosTurnsKernel: sin and cos of 2 pi t within 1 ulp of a correctly rounded reduction.
+ *
+ * The Philox kernels also take the `vecu` type of the same instruction set, for the integer rounds.
+ *
+ * The ...F kernels at the end are the single-precision versions over the `vecf` types: expKernelF and
+ * logKernelF within 2 ulp (float) of std::exp / std::log, normalCDFKernelF within 2.5e-7 absolute of the
+ * double kernel and, unlike it, with a small relative error in the lower tail.
+ */
+namespace simd
+{
+    // ln(2) split so that n * ln2High is exact for |n| < 2^20, with or without fused multiply-add.
+    inline constexpr double ln2High = 6.93147180369123816490e-01;
+    inline constexpr double ln2Low = 1.90821492927058770002e-10;
+
+    /// @brief e^x by range reduction x = n ln2 + r, |r| <= ln2 / 2, and a degree-12 Taylor polynomial.
+    template <class V>
+    SIMD_INLINE V expKernel(V x)
+    {
+        const V xc = min(max(x, V(-746.0)), V(710.0));
+        const V n = roundNearest(xc * V(std::numbers::log2e));
+        V r = fma(n, V(-ln2High), xc);
+        r = fma(n, V(-ln2Low), r);
+
+        V p = V(1.0 / 479001600.0);
+        p = fma(p, r, V(1.0 / 39916800.0));
+        p = fma(p, r, V(1.0 / 3628800.0));
+        p = fma(p, r, V(1.0 / 362880.0));
+        p = fma(p, r, V(1.0 / 40320.0));
+        p = fma(p, r, V(1.0 / 5040.0));
+        p = fma(p, r, V(1.0 / 720.0));
+        p = fma(p, r, V(1.0 / 120.0));
+        p = fma(p, r, V(1.0 / 24.0));
+        p = fma(p, r, V(1.0 / 6.0));
+        p = fma(p, r, V(0.5));
+        p = fma(p, r, V(1.0));
+        p = fma(p, r, V(1.0));
+
+        // Split 2^n in two factors so n can reach the overflow and subnormal ranges.
+        const V half = roundNearest(n * V(0.5));
+        const V result = p * pow2n(half) * pow2n(n - half);
+
+        return select(isnan(x), x, result);
+    }
+
+    /// @brief ln(x) from x = m 2^e, m in [sqrt(2)/2, sqrt(2)), and the atanh series of (m - 1) / (m + 1).
+    template <class V>
+    SIMD_INLINE V logKernel(V x)
+    {
+        const auto subnormal = x < V(std::numeric_limits<double>::min());
+        const V scaled = select(subnormal, x * V(0x1.0p54), x);
+        V e = exponentOf(scaled) - select(subnormal, V(54.0), V(0.0));
+        V m = mantissaOf(scaled);
+
+        const auto upper = m > V(std::numbers::sqrt2);
+        m = select(upper, m * V(0.5), m);
+        e = select(upper, e + V(1.0), e);
+
+        const V s = (m - V(1.0)) / (m + V(1.0));
+        const V z = s * s;
+        V p = V(1.0 / 23.0);
+        p = fma(p, z, V(1.0 / 21.0));
+        p = fma(p, z, V(1.0 / 19.0));
+        p = fma(p, z, V(1.0 / 17.0));
+        p = fma(p, z, V(1.0 / 15.0));
+        p = fma(p, z, V(1.0 / 13.0));
+        p = fma(p, z, V(1.0 / 11.0));
+        p = fma(p, z, V(1.0 / 9.0));
+        p = fma(p, z, V(1.0 / 7.0));
+        p = fma(p, z, V(1.0 / 5.0));
+        p = fma(p, z, V(1.0 / 3.0));
+        const V logm = fma(V(2.0) * s * z, p, V(2.0) * s);
+
+        V result = fma(e, V(ln2High), fma(e, V(ln2Low), logm));
+        result = select(x == V(std::numeric_limits<double>::infinity()), x, result);
+        result = select(x == V(0.0), V(-std::numeric_limits<double>::infinity()), result);
+        result = select(x < V(0.0), V(std::numeric_limits<double>::quiet_NaN()), result);
+
+        return select(isnan(x), x, result);
+    }
+
+    /// @brief phi(d) = exp(-d^2 / 2) / sqrt(2 pi).
+    template <class V>
+    SIMD_INLINE V normalPDFKernel(V d)
+    {
+        return V(std::numbers::inv_sqrtpi / std::numbers::sqrt2) * expKernel(V(-0.5) * d * d);
+    }
+
+    /// @brief N(x) with the Abramowitz-Stegun polynomial from an already computed density phi(d).
+    template <class V>
+    SIMD_INLINE V normalCDFFromPDFKernel(V d, V density)
+    {
+        const V K = V(1.0) / fma(V(0.2316419), abs(d), V(1.0));
+
+        V poly = V(1.330274429);
+        poly = fma(poly, K, V(-1.821255978));
+        poly = fma(poly, K, V(1.781477937));
+        poly = fma(poly, K, V(-0.356563782));
+        poly = fma(poly, K, V(0.319381530));
+        poly = poly * K;
+
+        const V y = V(1.0) - density * poly;
+
+        return select(d < V(0.0), V(1.0) - y, y);
+    }
+
+    /// @brief N(x) with the Abramowitz-Stegun polynomial, branch-free.
+    template <class V>
+    SIMD_INLINE V normalCDFKernel(V d)
+    {
+        return normalCDFFromPDFKernel(d, normalPDFKernel(d));
+    }
+
+    /// @brief N(x) from normalCDFTable.h: the scalar normalCDFTabulated, one gather per coefficient.
+    template <class V>
+    SIMD_INLINE V normalCDFTableKernel(V x)
+    {
+        // min returns its second operand for a NaN x, which keeps the gather indices in range.
+        const V clamped = max(min(x, V(normalCDFTable::upper)), V(normalCDFTable::lower));
+        const V t = (clamped - V(normalCDFTable::lower)) * V(normalCDFTable::inverseStep);
+        // floor(t) up to ties, which land on a node where both neighbouring cubics agree.
+        const V i = min(roundNearest(t - V(0.5)), V(normalCDFTable::intervals - 1));
+        const V u = t - i;
+
+        const double* c = normalCDFTable::coefficients.data();
+        const V offset = V(4.0) * i;
+        V result = gather(c + 3, offset);
+        result = fma(result, u, gather(c + 2, offset));
+        result = fma(result, u, gather(c + 1, offset));
+        result = fma(result, u, gather(c, offset));
+
+        return select(x == x, result, x);
+    }
+
+    /// @brief N(x) by the method chosen at compile time.
+    template <NormalCDFMethod Method, class V>
+    SIMD_INLINE V normalCDFKernelWith(V x)
+    {
+        if constexpr (Method == CDF_TABLE)
+        {
+            return normalCDFTableKernel(x);
+        }
+        else
+        {
+            return normalCDFKernel(x);
+        }
+    }
+
+    /// @brief +1 for calls and -1 for puts, loaded for n <= V::width options; NaN for any other type, which
+    /// the kernels below turn into NaN results.
+    template <class V>
+    SIMD_INLINE V loadOptionSign(const OptionType* optionType, std::size_t n)
+    {
+        alignas(64) double sign[V::width];
+        for (std::size_t j = 0; j < V::width; ++j)
+        {
+            sign[j] = j >= n || optionType[j] == CALL ? 1.0
+                      : optionType[j] == PUT         ? -1.0
+                                                     : std::numeric_limits<double>::quiet_NaN();
+        }
+        return V::load(sign);
+    }
+
+    /// @brief The sign of a batch whose options all have type Type, +1 for calls and -1 for puts.
+    template <OptionType Type>
+    inline constexpr double typeSign = Type == CALL ? 1.0 : -1.0;
+
+    /// @brief Black-Scholes price of n <= V::width options with the given sign (+1 call, -1 put).
+    ///
+    /// Puts use price = -(S N(-d1) - K e^{-rT} N(-d2)), the same operations blackScholesModel performs.
+    /// Inputs rejected by the blackScholesModel setters give NaN. When sign is a compile-time constant,
+    /// as in the per-type arrays below, the multiplications by it fold away. Method selects how N(x) is
+    /// evaluated.
+    template <class V, NormalCDFMethod Method = CDF_POLYNOMIAL>
+    SIMD_INLINE void blackScholesPriceBlock(const double* underlyingPrice, const double* strikePrice,
+                                            const double* timeToExperation, const double* riskFreeRate,
+                                            const double* volatility, V sign, double* optionPrice, std::size_t n)
+    {
+        const V S = V::load(underlyingPrice, n);
+        const V K = V::load(strikePrice, n);
+        const V T = V::load(timeToExperation, n);
+        const V r = V::load(riskFreeRate, n);
+        const V vol = V::load(volatility, n);
+
+        const V volSqrtT = vol * sqrt(T);
+        const V d1 = fma(fma(V(0.5) * vol, vol, r), T, logKernel(S / K)) / volSqrtT;
+        const V d2 = d1 - volSqrtT;
+        const V discountedStrike = K * expKernel(-r * T);
+
+        const V price = sign * (S * normalCDFKernelWith<Method>(sign * d1)
+                                - discountedStrike * normalCDFKernelWith<Method>(sign * d2));
+        const auto valid = (vol > V(0.0)) & (vol < V(1.0)) & (T >= V(0.0)) & (sign == sign);
+
+        select(valid, price, V(std::numeric_limits<double>::quiet_NaN())).store(optionPrice, n);
+    }
+
+    /// @brief Black-Scholes price and the first-order Greeks selected by the GreekMask bits Greeks from
+    /// the terms every option needs: logMoneyness = ln(S / K), sqrtT and discount = e^{-rT}. The shared
+    /// tail of blackScholesGreeksBlock and blackScholesChainBlock. Outputs of unselected results are not
+    /// written and may be null. Inputs rejected by the blackScholesModel setters give NaN.
+    template <class V, unsigned Greeks>
+    SIMD_INLINE void blackScholesGreeksFromTerms(V S, V K, V T, V r, V vol, V logMoneyness, V sqrtT, V discount,
+                                                 V sign, double* optionPrice, double* delta, double* gamma,
+                                                 double* vega, double* theta, double* rho, std::size_t n)
+    {
+        constexpr bool needsNd1 = (Greeks & (GREEK_PRICE | GREEK_DELTA)) != 0;
+        constexpr bool needsNd2 = (Greeks & (GREEK_PRICE | GREEK_THETA | GREEK_RHO)) != 0;
+
+        const V volSqrtT = vol * sqrtT;
+        const V d1 = fma(fma(V(0.5) * vol, vol, r), T, logMoneyness) / volSqrtT;
+        const V density1 = normalPDFKernel(d1);
+        const V spotDensity = S * density1;
+
+        V Nd1 = V(0.0);
+        if constexpr (needsNd1)
+        {
+            Nd1 = normalCDFFromPDFKernel(sign * d1, density1);
+        }
+
+        // S phi(d1) = K e^{-rT} phi(d2): the second density costs a division instead of an exp.
+        V signedStrikeTerm = V(0.0);
+        if constexpr (needsNd2)
+        {
+            const V discountedStrike = K * discount;
+            const V Nd2 = normalCDFFromPDFKernel(sign * (d1 - volSqrtT), spotDensity / discountedStrike);
+            signedStrikeTerm = sign * discountedStrike * Nd2;
+        }
+
+        const auto valid = (vol > V(0.0)) & (vol < V(1.0)) & (T >= V(0.0)) & (sign == sign);
+        const V nan = V(std::numeric_limits<double>::quiet_NaN());
+
+        if constexpr ((Greeks & GREEK_PRICE) != 0)
+        {
+            select(valid, sign * S * Nd1 - signedStrikeTerm, nan).store(optionPrice, n);
+        }
+        if constexpr ((Greeks & GREEK_DELTA) != 0)
+        {
+            select(valid, sign * Nd1, nan).store(delta, n);
+        }
+        if constexpr ((Greeks & GREEK_GAMMA) != 0)
+        {
+            select(valid, density1 / (S * volSqrtT), nan).store(gamma, n);
+        }
+        if constexpr ((Greeks & GREEK_VEGA) != 0)
+        {
+            select(valid, spotDensity * sqrtT, nan).store(vega, n);
+        }
+        if constexpr ((Greeks & GREEK_THETA) != 0)
+        {
+            select(valid, -spotDensity * vol / (V(2.0) * sqrtT) - r * signedStrikeTerm, nan).store(theta, n);
+        }
+        if constexpr ((Greeks & GREEK_RHO) != 0)
+        {
+            select(valid, T * signedStrikeTerm, nan).store(rho, n);
+        }
+    }
+
+    /// @brief Black-Scholes price and the first-order Greeks selected by the GreekMask bits Greeks of
+    /// n <= V::width options with the given sign, the vector form of blackScholesPriceAndGreeks in
+    /// pricingCore.h. Outputs of unselected results are not written and may be null. Inputs rejected by
+    /// the blackScholesModel setters give NaN.
+    template <class V, unsigned Greeks>
+    SIMD_INLINE void blackScholesGreeksBlock(const double* underlyingPrice, const double* strikePrice,
+                                             const double* timeToExperation, const double* riskFreeRate,
+                                             const double* volatility, V sign, double* optionPrice, double* delta,
+                                             double* gamma, double* vega, double* theta, double* rho, std::size_t n)
+    {
+        const V S = V::load(underlyingPrice, n);
+        const V K = V::load(strikePrice, n);
+        const V T = V::load(timeToExperation, n);
+        const V r = V::load(riskFreeRate, n);
+        const V vol = V::load(volatility, n);
+
+        V discount = V(0.0);
+        if constexpr ((Greeks & (GREEK_PRICE | GREEK_THETA | GREEK_RHO)) != 0)
+        {
+            discount = expKernel(-r * T);
+        }
+        blackScholesGreeksFromTerms<V, Greeks>(S, K, T, r, vol, logKernel(S / K), sqrt(T), discount, sign,
+                                               optionPrice, delta, gamma, vega, theta, rho, n);
+    }
+
+    /**
+     * @brief The terms of one expiry shared by every strike of an option chain, computed once per chain.
+     */
+    template <class V>
+    struct expiryTerms
+    {
+        V S;
+        V T;
+        V r;
+        V logS;
+        V sqrtT;
+        V discount;     // e^{-rT}
+
+        expiryTerms(double underlyingPrice, double timeToExperation, double riskFreeRate)
+            : S(underlyingPrice), T(timeToExperation), r(riskFreeRate), logS(std::log(underlyingPrice)),
+              sqrtT(std::sqrt(timeToExperation)), discount(std::exp(-riskFreeRate * timeToExperation))
+        {
+        }
+    };
+
+    /// @brief Black-Scholes price and selected Greeks of n <= V::width strikes of one expiry. Per strike
+    /// only ln(K), phi(d1) and the normal CDFs are evaluated; S, sqrt(T) and e^{-rT} come from the chain.
+    template <class V, unsigned Greeks>
+    SIMD_INLINE void blackScholesChainBlock(const expiryTerms<V>& expiry, const double* strikePrice,
+                                            const double* volatility, V sign, double* optionPrice, double* delta,
+                                            double* gamma, double* vega, double* theta, double* rho, std::size_t n)
+    {
+        const V K = V::load(strikePrice, n);
+        const V vol = V::load(volatility, n);
+
+        blackScholesGreeksFromTerms<V, Greeks>(expiry.S, K, expiry.T, expiry.r, vol, expiry.logS - logKernel(K),
+                                               expiry.sqrtT, expiry.discount, sign, optionPrice, delta, gamma, vega,
+                                               theta, rho, n);
+    }
+
+    /// @brief Applies block(i, n) to consecutive blocks of V::width elements, the last one partial.
+    template <class V, class Block>
+    SIMD_INLINE void forEachBlock(std::size_t count, Block&& block)
+    {
+        for (std::size_t i = 0; i < count; i += V::width)
+        {
+            const std::size_t remaining = count - i;
+            block(i, remaining < V::width ? remaining : V::width);
+        }
+    }
+
+    template <class V>
+    SIMD_INLINE void normalCDFArray(const double* x, double* result, std::size_t count)
+    {
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) { normalCDFKernel(V::load(x + i, n)).store(result + i, n); });
+    }
+
+    template <class V>
+    SIMD_INLINE void normalCDFTableArray(const double* x, double* result, std::size_t count)
+    {
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) { normalCDFTableKernel(V::load(x + i, n)).store(result + i, n); });
+    }
+
+    template <class V>
+    SIMD_INLINE void expArray(const double* x, double* result, std::size_t count)
+    {
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) { expKernel(V::load(x + i, n)).store(result + i, n); });
+    }
+
+    template <class V>
+    SIMD_INLINE void logArray(const double* x, double* result, std::size_t count)
+    {
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) { logKernel(V::load(x + i, n)).store(result + i, n); });
+    }
+
+    /// @brief Prices a batch of mixed option types, the sign loaded per option.
+    template <class V, NormalCDFMethod Method = CDF_POLYNOMIAL>
+    SIMD_INLINE void blackScholesPriceArray(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                            const double* timeToExperation, const double* riskFreeRate,
+                                            const double* volatility, const OptionType* optionType, double* optionPrice)
+    {
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            blackScholesPriceBlock<V, Method>(underlyingPrice + i, strikePrice + i, timeToExperation + i,
+                                              riskFreeRate + i, volatility + i, loadOptionSign<V>(optionType + i, n),
+                                              optionPrice + i, n);
+        });
+    }
+
+    /// @brief Prices a batch whose options all have type Type.
+    template <class V, OptionType Type, NormalCDFMethod Method = CDF_POLYNOMIAL>
+    SIMD_INLINE void blackScholesPriceArrayOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                              const double* timeToExperation, const double* riskFreeRate,
+                                              const double* volatility, double* optionPrice)
+    {
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            blackScholesPriceBlock<V, Method>(underlyingPrice + i, strikePrice + i, timeToExperation + i,
+                                              riskFreeRate + i, volatility + i, V(typeSign<Type>), optionPrice + i, n);
+        });
+    }
+
+    /// @brief Price and all first-order Greeks of a batch of mixed option types.
+    template <class V>
+    SIMD_INLINE void blackScholesGreeksArray(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                             const double* timeToExperation, const double* riskFreeRate,
+                                             const double* volatility, const OptionType* optionType,
+                                             double* optionPrice, double* delta, double* gamma, double* vega,
+                                             double* theta, double* rho)
+    {
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            blackScholesGreeksBlock<V, GREEK_ALL>(underlyingPrice + i, strikePrice + i, timeToExperation + i,
+                                                  riskFreeRate + i, volatility + i, loadOptionSign<V>(optionType + i, n),
+                                                  optionPrice + i, delta + i, gamma + i, vega + i, theta + i, rho + i, n);
+        });
+    }
+
+    /// @brief The results selected by Greeks for a batch whose options all have type Type. Outputs of
+    /// unselected results may be null.
+    template <class V, OptionType Type, unsigned Greeks>
+    SIMD_INLINE void blackScholesGreeksArrayOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                               const double* timeToExperation, const double* riskFreeRate,
+                                               const double* volatility, double* optionPrice, double* delta,
+                                               double* gamma, double* vega, double* theta, double* rho)
+    {
+        // Offsetting a null output is undefined, so unselected outputs stay null instead of advancing.
+        const auto at = [](double* column, std::size_t i) { return column == nullptr ? nullptr : column + i; };
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            blackScholesGreeksBlock<V, Greeks>(underlyingPrice + i, strikePrice + i, timeToExperation + i,
+                                               riskFreeRate + i, volatility + i, V(typeSign<Type>), at(optionPrice, i),
+                                               at(delta, i), at(gamma, i), at(vega, i), at(theta, i), at(rho, i), n);
+        });
+    }
+
+    /// @brief Black-Scholes price and selected Greeks of count strikes of one expiry, with mixed option
+    /// types. Unselected outputs may be null.
+    template <class V, unsigned Greeks>
+    SIMD_INLINE void blackScholesChainArray(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                            std::size_t count, const double* strikePrice, const double* volatility,
+                                            const OptionType* optionType, double* optionPrice, double* delta,
+                                            double* gamma, double* vega, double* theta, double* rho)
+    {
+        const expiryTerms<V> expiry(underlyingPrice, timeToExperation, riskFreeRate);
+        const auto at = [](double* column, std::size_t i) { return column == nullptr ? nullptr : column + i; };
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            blackScholesChainBlock<V, Greeks>(expiry, strikePrice + i, volatility + i,
+                                              loadOptionSign<V>(optionType + i, n), at(optionPrice, i), at(delta, i),
+                                              at(gamma, i), at(vega, i), at(theta, i), at(rho, i), n);
+        });
+    }
+
+    // What each result of the runtime-mask Greeks needs: the adjusted deltas and prices of optionGreeksModel
+    // are built from delta and the other first-order Greeks, so those are computed once for all of them.
+    inline constexpr unsigned greeksNeedingDelta = GREEK_DELTA | GREEK_ADJUSTED_ALL;
+    inline constexpr unsigned greeksNeedingGamma = GREEK_GAMMA | GREEK_GAMMA_ADJUSTED_DELTA
+                                                   | GREEK_GAMMA_VEGA_ADJUSTED_DELTA | GREEK_PRICE_GAMMA
+                                                   | GREEK_PRICE_GAMMA_VEGA;
+    inline constexpr unsigned greeksNeedingVega = GREEK_VEGA | GREEK_VEGA_ADJUSTED_DELTA
+                                                  | GREEK_GAMMA_VEGA_ADJUSTED_DELTA | GREEK_PRICE_VEGA
+                                                  | GREEK_PRICE_GAMMA_VEGA;
+    inline constexpr unsigned greeksNeedingTheta = GREEK_THETA | GREEK_THETA_ADJUSTED_DELTA | GREEK_PRICE_THETA;
+    inline constexpr unsigned greeksNeedingNd1 = GREEK_PRICE | greeksNeedingDelta;
+    inline constexpr unsigned greeksNeedingNd2 = GREEK_PRICE | greeksNeedingTheta | GREEK_RHO | GREEK_PRICE_IV;
+    inline constexpr unsigned greeksNeedingDiscount = greeksNeedingNd2 | GREEK_PRICE_GAMMA | GREEK_PRICE_GAMMA_VEGA;
+
+    /// @brief The results selected at run time by the GreekMask bits greeks of n <= V::width options:
+    /// output[greekIndex(bit)] + i receives the result of bit. Terms no selected result needs are skipped;
+    /// the branches are the same for every block, so they are predicted. Outputs of unselected results are
+    /// not read and may be null. Inputs rejected by the blackScholesModel setters give NaN.
+    template <class V>
+    SIMD_INLINE void blackScholesSelectedGreeksBlock(const double* underlyingPrice, const double* strikePrice,
+                                                     const double* timeToExperation, const double* riskFreeRate,
+                                                     const double* volatility, V sign, unsigned greeks,
+                                                     double* const* output, std::size_t i, std::size_t n)
+    {
+        const V S = V::load(underlyingPrice + i, n);
+        const V K = V::load(strikePrice + i, n);
+        const V T = V::load(timeToExperation + i, n);
+        const V r = V::load(riskFreeRate + i, n);
+        const V vol = V::load(volatility + i, n);
+
+        const V sqrtT = sqrt(T);
+        const V volSqrtT = vol * sqrtT;
+        const V d1 = fma(fma(V(0.5) * vol, vol, r), T, logKernel(S / K)) / volSqrtT;
+        const V density1 = normalPDFKernel(d1);
+        const V spotDensity = S * density1;
+
+        V discount(0.0), discountedStrike(0.0), Nd1(0.0), delta(0.0), signedStrikeTerm(0.0);
+        V gamma(0.0), vega(0.0), theta(0.0);
+        if ((greeks & greeksNeedingDiscount) != 0)
+        {
+            discount = expKernel(-r * T);
+            discountedStrike = K * discount;
+        }
+        if ((greeks & greeksNeedingNd1) != 0)
+        {
+            Nd1 = normalCDFFromPDFKernel(sign * d1, density1);
+            delta = sign * Nd1;
+        }
+        if ((greeks & greeksNeedingNd2) != 0)
+        {
+            const V Nd2 = normalCDFFromPDFKernel(sign * (d1 - volSqrtT), spotDensity / discountedStrike);
+            signedStrikeTerm = sign * discountedStrike * Nd2;
+        }
+        if ((greeks & greeksNeedingGamma) != 0)
+        {
+            gamma = density1 / (S * volSqrtT);
+        }
+        if ((greeks & greeksNeedingVega) != 0)
+        {
+            vega = spotDensity * sqrtT;
+        }
+        if ((greeks & greeksNeedingTheta) != 0)
+        {
+            theta = -spotDensity * vol / (V(2.0) * sqrtT) - r * signedStrikeTerm;
+        }
+
+        const auto valid = (vol > V(0.0)) & (vol < V(1.0)) & (T >= V(0.0)) & (sign == sign);
+        const V nan = V(std::numeric_limits<double>::quiet_NaN());
+        const auto store = [&](unsigned greek, V value) {
+            if ((greeks & greek) != 0)
+            {
+                select(valid, value, nan).store(output[greekIndex(greek)] + i, n);
+            }
+        };
+
+        store(GREEK_PRICE, sign * S * Nd1 - signedStrikeTerm);
+        store(GREEK_DELTA, delta);
+        store(GREEK_GAMMA, gamma);
+        store(GREEK_VEGA, vega);
+        store(GREEK_THETA, theta);
+        store(GREEK_RHO, T * signedStrikeTerm);
+        if ((greeks & GREEK_ADJUSTED_ALL) == 0)
+        {
+            return;
+        }
+
+        // The volatility implied by the option's own price is vol, so the IV adjusted delta is delta.
+        const V gammaAdjustedDelta = fma(V(0.5), gamma, delta);
+        const V thetaAdjustedDelta = delta - theta;
+        store(GREEK_IV_ADJUSTED_DELTA, delta);
+        store(GREEK_GAMMA_ADJUSTED_DELTA, gammaAdjustedDelta);
+        store(GREEK_VEGA_ADJUSTED_DELTA, delta + vega);
+        store(GREEK_THETA_ADJUSTED_DELTA, thetaAdjustedDelta);
+        store(GREEK_GAMMA_VEGA_ADJUSTED_DELTA, gammaAdjustedDelta + vega);
+        store(GREEK_PRICE_IV, sign * delta * S * Nd1 - signedStrikeTerm);
+        store(GREEK_PRICE_GAMMA, gammaAdjustedDelta * S - discountedStrike);
+        store(GREEK_PRICE_VEGA, fma(V(0.5) * vega, vega, delta * S - vega * (delta + vega)));
+        store(GREEK_PRICE_THETA, delta * S - theta * T + thetaAdjustedDelta - discountedStrike);
+        store(GREEK_PRICE_GAMMA_VEGA, fma(V(0.5) * gamma * S, S, gammaAdjustedDelta * S)
+                                          - vega * S * sqrtT * discount * V(0.01));
+    }
+
+    /// @brief The results selected at run time by greeks for a batch of mixed option types, into the
+    /// columns output[greekIndex(bit)]; unselected columns may be null.
+    template <class V>
+    SIMD_INLINE void blackScholesSelectedGreeksArray(std::size_t count, const double* underlyingPrice,
+                                                     const double* strikePrice, const double* timeToExperation,
+                                                     const double* riskFreeRate, const double* volatility,
+                                                     const OptionType* optionType, unsigned greeks,
+                                                     double* const* output)
+    {
+        if ((greeks & (GREEK_ALL | GREEK_ADJUSTED_ALL)) == 0)
+        {
+            return;
+        }
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            blackScholesSelectedGreeksBlock<V>(underlyingPrice, strikePrice, timeToExperation, riskFreeRate,
+                                               volatility, loadOptionSign<V>(optionType + i, n), greeks, output, i, n);
+        });
+    }
+
+    // Implied volatility, in the normalized variables of Jaeckel, "Let's Be Rational" (2015): x = ln(F / K),
+    // s = vol sqrt(T), h = x / s, t = s / 2 and the normalized price b = price e^{rT} / sqrt(F K). Every
+    // option is first reduced to an out-of-the-money call, x <= 0 and 0 < b < e^{x/2}.
+    inline constexpr double sqrtTwoPi = 2.50662827463100050242;
+    inline constexpr double logSqrtTwoPi = 0.91893853320467274178;
+
+    /// @brief a b - p exactly for p = a b rounded: one fma where it is fused, Dekker's product otherwise.
+    template <class V>
+    SIMD_INLINE V productError(V a, V b, V p)
+    {
+        if constexpr (V::fusedMultiplyAdd)
+        {
+            return fma(a, b, -p);
+        }
+        else
+        {
+            const V split = V(134217729.0);
+            const V aScaled = split * a;
+            const V aHigh = aScaled - (aScaled - a);
+            const V aLow = a - aHigh;
+            const V bScaled = split * b;
+            const V bHigh = bScaled - (bScaled - b);
+            const V bLow = b - bHigh;
+            return ((aHigh * bHigh - p) + aHigh * bLow + aLow * bHigh) + aLow * bLow;
+        }
+    }
+
+    /// @brief Y(z) = N(z) / phi(z) from millsRatioTable.h: the scalar millsRatio, one gather per coefficient.
+    template <class V>
+    SIMD_INLINE V millsRatioKernel(V z)
+    {
+        // Y(-|z|) from the table. max returns its second operand for a NaN z, which keeps the gather
+        // indices in range.
+        const V negative = max(-abs(z), V(millsRatioTable::lower));
+        const V i = roundNearest((negative - V(millsRatioTable::lower)) * V(millsRatioTable::inverseStep));
+        const V d = negative - fma(i, V(millsRatioTable::step), V(millsRatioTable::lower));
+
+        const double* a = millsRatioTable::coefficients.data();
+        const V offset = V(static_cast<double>(millsRatioTable::terms)) * i;
+        V y = gather(a + millsRatioTable::terms - 1, offset);
+        for (std::size_t n = millsRatioTable::terms - 1; n-- > 0;)
+        {
+            y = fma(y, d, gather(a + n, offset));
+        }
+
+        const auto below = z < V(millsRatioTable::lower);
+        if (any(below))
+        {
+            const V w = V(1.0) / (z * z);
+            V series = V(1.0);
+            for (int k = 15; k >= 1; k -= 2)
+            {
+                series = fma(V(-static_cast<double>(k)) * w, series, V(1.0));
+            }
+            y = select(below, -series / z, y);
+        }
+
+        // Y(z) = sqrt(2 pi) e^{z^2 / 2} - Y(-z), with the rounding error of z^2 put back into the exponential.
+        const auto positive = z > V(0.0);
+        if (any(positive))
+        {
+            const V zz = z * z;
+            const V exponential = expKernel(V(0.5) * zz) * fma(V(0.5), productError(z, z, zz), V(1.0));
+            y = select(positive, fma(V(sqrtTwoPi), exponential, -y), y);
+        }
+
+        return select(z == z, y, z);
+    }
+
+    /// @brief Y(h + t) - Y(h - t) = 2 (a_1 t + a_3 t^3 + ... + a_13 t^13), a_n = Y^(n)(h) / n!, for t < 1/8
+    /// where the direct difference cancels. n a_n = h a_{n-1} + a_{n-2} as in millsRatioTable.h.
+    template <class V>
+    SIMD_INLINE V millsRatioDifferenceSmallT(V h, V t)
+    {
+        V previous = millsRatioKernel(h);
+        V current = fma(h, previous, V(1.0));
+        V odd[7];
+        odd[0] = current;
+        for (int n = 2; n <= 13; ++n)
+        {
+            const V next = fma(h, current, previous) * V(1.0 / n);
+            previous = current;
+            current = next;
+            if (n % 2 == 1)
+            {
+                odd[n / 2] = current;
+            }
+        }
+
+        const V tt = t * t;
+        V sum = odd[6];
+        for (int k = 5; k >= 0; --k)
+        {
+            sum = fma(sum, tt, odd[k]);
+        }
+        return V(2.0) * t * sum;
+    }
+
+    /**
+     * @brief The normalized Black price of an out-of-the-money call in the form the solver's objective needs.
+     *
+     * For lanes not in upper, logValue = ln b(x, s) and slopeRatio = b' / b; for lanes in upper,
+     * logValue = ln(e^{x/2} - b) and slopeRatio = -(e^{x/2} - b)' / (e^{x/2} - b), where ' is d/ds. With
+     * c = e^{-(h^2 + t^2) / 2} / sqrt(2 pi) = b', b = c (Y(h + t) - Y(h - t)) and e^{x/2} - b = c (Y(-h - t) + Y(h - t)).
+     * The difference is replaced by its Taylor series for small t and by e^{x/2} - c (Y(-h - t) + Y(h - t))
+     * once h + t > 0, so no branch loses more than a few bits.
+     */
+    template <class V, class M>
+    SIMD_INLINE void normalizedBlackKernel(V x, V s, V expHalfX, M upper, V& logValue, V& slopeRatio)
+    {
+        const V h = x / s;
+        const V t = V(0.5) * s;
+        const V exponent = V(-0.5) * fma(h, h, t * t);
+        const V plus = h + t;
+
+        // A is Y(h + t) when h + t <= 0 and Y(-h - t) otherwise.
+        const V A = millsRatioKernel(-abs(plus));
+        const V B = millsRatioKernel(h - t);
+
+        const auto smallT = (!upper) & (t < V(0.125)) & (h > V(-12.0));
+        const auto aboveCenter = (!upper) & (!smallT) & (plus > V(0.0));
+
+        V differenceY = A - B;
+        if (any(smallT))
+        {
+            differenceY = select(smallT, millsRatioDifferenceSmallT(h, t), differenceY);
+        }
+
+        V sumY = A + B;
+        const auto reflect = upper & (plus < V(0.0));
+        if (any(reflect))
+        {
+            const V exponential = expKernel(V(0.5) * plus * plus);
+            sumY = select(reflect, fma(V(sqrtTwoPi), exponential, B - A), sumY);
+        }
+
+        V c = V(1.0);
+        V b = V(1.0);
+        if (any(aboveCenter))
+        {
+            c = V(1.0 / sqrtTwoPi) * expKernel(exponent);
+            b = expHalfX - c * (A + B);
+        }
+
+        const V argument = select(upper, sumY, select(aboveCenter, b, differenceY));
+        logValue = logKernel(argument) + select(aboveCenter, V(0.0), exponent - V(logSqrtTwoPi));
+        slopeRatio = select(aboveCenter, c, V(1.0)) / argument;
+    }
+
+    /// @brief N^{-1}(p) for 0 < p <= 1/2 by Acklam's rational approximation, relative error 1.2e-9.
+    template <class V>
+    SIMD_INLINE V inverseNormalCDFLowerKernel(V p)
+    {
+        const V q = p - V(0.5);
+        const V r = q * q;
+        V numerator = V(-3.969683028665376e+01);
+        numerator = fma(numerator, r, V(2.209460984245205e+02));
+        numerator = fma(numerator, r, V(-2.759285104469687e+02));
+        numerator = fma(numerator, r, V(1.383577518672690e+02));
+        numerator = fma(numerator, r, V(-3.066479806614716e+01));
+        numerator = fma(numerator, r, V(2.506628277459239e+00));
+        V denominator = V(-5.447609879822406e+01);
+        denominator = fma(denominator, r, V(1.615858368580409e+02));
+        denominator = fma(denominator, r, V(-1.556989798598866e+02));
+        denominator = fma(denominator, r, V(6.680131188771972e+01));
+        denominator = fma(denominator, r, V(-1.328068155288572e+01));
+        denominator = fma(denominator, r, V(1.0));
+        const V central = numerator * q / denominator;
+
+        const V u = sqrt(V(-2.0) * logKernel(p));
+        V tailNumerator = V(-7.784894002430293e-03);
+        tailNumerator = fma(tailNumerator, u, V(-3.223964580411365e-01));
+        tailNumerator = fma(tailNumerator, u, V(-2.400758277161838e+00));
+        tailNumerator = fma(tailNumerator, u, V(-2.549732539343734e+00));
+        tailNumerator = fma(tailNumerator, u, V(4.374664141464968e+00));
+        tailNumerator = fma(tailNumerator, u, V(2.938163982698783e+00));
+        V tailDenominator = V(7.784695709041462e-03);
+        tailDenominator = fma(tailDenominator, u, V(3.224671290700398e-01));
+        tailDenominator = fma(tailDenominator, u, V(2.445134137142996e+00));
+        tailDenominator = fma(tailDenominator, u, V(3.754408661907416e+00));
+        tailDenominator = fma(tailDenominator, u, V(1.0));
+
+        return select(p < V(0.02425), tailNumerator / tailDenominator, central);
+    }
+
+    /// Steps after which a solve stops; no option has been seen to need more than 4.
+    inline constexpr int impliedVolatilityMaxIterations = 8;
+
+    /**
+     * @brief Cold-start guess for s and the objective of every lane (upper: ln(e^{x/2} - b)).
+     *
+     * The guess depends on the region of b: below b(s_l) the larger of the asymptotic expansion of b for small
+     * s and the tangent of ln b at s_l, between b(s_l) and b(s_u) the tangent at the inflection point
+     * s_c = sqrt(2 |x|), and above it s = -2 N^{-1}((e^{x/2} - b) / (e^{x/2} + e^{-x/2})). It costs three
+     * evaluations of b, about as much as the steps that follow.
+     */
+    template <class V, class M>
+    SIMD_INLINE void impliedVolatilityColdStart(V x, V expHalfX, V beta, V logBeta, V& s, M& upper)
+    {
+        const M none = V(1.0) < V(0.0);
+
+        // b and its slope at the inflection point s_c, where h + t = 0.
+        const V sc = max(sqrt(V(-2.0) * x), V(std::numeric_limits<double>::min()));
+        const V vc = V(1.0 / sqrtTwoPi) * expHalfX;
+        V logBc, unused;
+        normalizedBlackKernel(x, sc, expHalfX, none, logBc, unused);
+        const V bc = expKernel(logBc);
+
+        // The tangent at s_c meets 0 at s_l and the upper bound at s_u.
+        const V sl = sc - bc / vc;
+        const V su = sc + (expHalfX - bc) / vc;
+        V logBl, logBu, slopeL;
+        normalizedBlackKernel(x, max(sl, V(std::numeric_limits<double>::min())), expHalfX, none, logBl, slopeL);
+        normalizedBlackKernel(x, su, expHalfX, none, logBu, unused);
+        upper = logBeta > logBu;
+        const M lowerTail = (logBeta <= logBl) & (sl > V(0.0));
+
+        s = sc + (beta - bc) / vc;
+
+        // Lower tail: b ~ c s^3 / x^2 as h -> -infinity, solved for s by three fixed-point steps from s_c, or
+        // the tangent of ln b at s_l where that is larger.
+        if (any(lowerTail))
+        {
+            V sA = sc;
+            const V logTerm = logBeta + V(logSqrtTwoPi);
+            for (int k = 0; k < 3; ++k)
+            {
+                const V exponent = V(-2.0) * (logTerm - logKernel(sA * sA * sA / (x * x)));
+                const V remainder = max(fma(V(-0.25) * sA, sA, exponent), V(1e-300));
+                sA = min(sc, -x / sqrt(remainder));
+            }
+            const V logTangent = sl + (logBeta - logBl) / slopeL;
+            s = select(lowerTail, max(sA, logTangent), s);
+        }
+        if (any(upper))
+        {
+            const V sB = V(-2.0) * inverseNormalCDFLowerKernel((expHalfX - beta) / (expHalfX + V(1.0) / expHalfX));
+            s = select(upper, max(sB, sc), s);
+        }
+        s = select(s > V(0.0), s, select(sc > V(std::numeric_limits<double>::min()), sc, V(1.0)));
+    }
+
+    /**
+     * @brief Householder steps from s until every lane is done or impliedVolatilityMaxIterations steps.
+     *
+     * Each step is a third-order Householder step on ln b - ln beta, or on ln(e^{x/2} - beta) - ln(e^{x/2} - b)
+     * in the upper lanes, where both objectives are close to linear in s. A lane is done once a step moves s
+     * by less than 2^-20 relative, after which the cubic convergence leaves an error far below double
+     * precision. steps counts the steps of every lane.
+     *
+     * @return The lanes that are done: those of done plus the ones that converged.
+     */
+    template <class V, class M>
+    SIMD_INLINE M impliedVolatilityIterate(V x, V expHalfX, V logBeta, V logUpperBeta, M upper, M done, V& s, V& steps)
+    {
+        const V xx = x * x;
+        for (int k = 0; k < impliedVolatilityMaxIterations && any(!done); ++k)
+        {
+            V logValue, slopeRatio;
+            normalizedBlackKernel(x, s, expHalfX, upper, logValue, slopeRatio);
+            const V g = select(upper, logUpperBeta - logValue, logValue - logBeta);
+
+            // b'' / b' and b''' / b', then the same ratios for the objective.
+            const V inverseS = V(1.0) / s;
+            const V h2 = fma(xx * inverseS, inverseS * inverseS, V(-0.25) * s);
+            const V h3 = h2 * h2 - V(3.0) * xx * (inverseS * inverseS) * (inverseS * inverseS) - V(0.25);
+            const V q = select(upper, -slopeRatio, slopeRatio);
+            const V h2g = h2 - q;
+            const V h3g = fma(V(2.0) * q, q, fma(V(-3.0) * h2, q, h3));
+
+            const V nu = -g / slopeRatio;
+            const V householder = fma(V(0.5) * h2g, nu, V(1.0)) / fma(nu, fma(h3g * V(1.0 / 6.0), nu, h2g), V(1.0));
+            V ds = nu * select(householder > V(0.0), householder, V(1.0));
+            ds = select(s + ds > V(0.0), ds, max(ds, V(-0.5) * s));
+
+            s = select(done, s, s + ds);
+            steps = select(done, steps, steps + V(1.0));
+            done = done | (abs(ds) <= V(0x1.0p-20) * s);
+        }
+        return done;
+    }
+
+    /**
+     * @brief Implied volatility of n <= V::width options with the given sign (+1 call, -1 put).
+     *
+     * Lanes whose seed volatility is positive and finite start from it instead of the cold-start guess, with
+     * the upper objective where beta is closer to its bound than to 0; if every valid lane is seeded the cold
+     * start is skipped, which halves the cost of a solve. A lane that has not converged after
+     * impliedVolatilityMaxIterations steps is restarted cold, so a bad seed costs steps but never accuracy.
+     * seed may be null.
+     *
+     * Prices outside (intrinsic value, upper bound), T <= 0, invalid spot or strike and a NaN sign (an option
+     * type other than CALL or PUT) give NaN; a price equal to the intrinsic value gives 0. iterations, unless null, receives the number of steps.
+     */
+    template <class V>
+    SIMD_INLINE void impliedVolatilityBlock(const double* optionPrice, const double* underlyingPrice,
+                                            const double* strikePrice, const double* timeToExperation,
+                                            const double* riskFreeRate, V sign, const double* seed,
+                                            double* volatility, std::uint8_t* iterations, std::size_t n)
+    {
+        const V price = V::load(optionPrice, n);
+        const V S = V::load(underlyingPrice, n);
+        const V K = V::load(strikePrice, n);
+        const V T = V::load(timeToExperation, n);
+        const V r = V::load(riskFreeRate, n);
+
+        // x = ln(F / K) and beta = price e^{rT} / sqrt(F K) = price e^{rT / 2} / sqrt(S K). Near the money b
+        // is sensitive to x, so the rounding error of S / K is added back: ln(S / K) = ln(q) + (S - q K) / S,
+        // where S - q K is exact from the product error of q K.
+        const V ratio = S / K;
+        const V product = ratio * K;
+        const V signedX = fma(r, T, logKernel(ratio) + ((S - product) - productError(ratio, K, product)) / S);
+        const V x = -abs(signedX);
+        const V expHalfX = expKernel(V(0.5) * x);
+        V beta = price * expKernel(V(0.5) * r * T) / sqrt(S * K);
+        // In the money: subtract the intrinsic value e^{|x|/2} - e^{-|x|/2} = 2 sinh(|x| / 2) and price the
+        // out-of-the-money option. The difference of exponentials cancels for small |x|, so the Taylor series
+        // of sinh (within 1 ulp for |x| / 2 < 1/2) is used there.
+        const V a = V(-0.5) * x;
+        const V aa = a * a;
+        V sinhSeries = V(1.0 / 6227020800.0);
+        sinhSeries = fma(sinhSeries, aa, V(1.0 / 39916800.0));
+        sinhSeries = fma(sinhSeries, aa, V(1.0 / 362880.0));
+        sinhSeries = fma(sinhSeries, aa, V(1.0 / 5040.0));
+        sinhSeries = fma(sinhSeries, aa, V(1.0 / 120.0));
+        sinhSeries = fma(sinhSeries, aa, V(1.0 / 6.0));
+        sinhSeries = fma(sinhSeries * aa, a, a);
+        const V intrinsic = select(a < V(0.5), V(2.0) * sinhSeries, V(1.0) / expHalfX - expHalfX);
+        beta = select(sign * signedX > V(0.0), beta - intrinsic, beta);
+
+        // The upper bound is checked on the price itself: after normalization rounding can let a price equal
+        // to S (calls) or K e^{-rT} (puts) through as a beta just below e^{x/2}. A NaN sign is an unknown type.
+        const V upperBound = select(sign > V(0.0), S, K * expKernel(-r * T));
+        const auto inputsValid = (S > V(0.0)) & (K > V(0.0)) & (T > V(0.0)) & (r == r) & (sign == sign);
+        const auto atIntrinsic = inputsValid & (beta == V(0.0));
+        const auto valid = inputsValid & (price < upperBound) & (beta > V(0.0)) & (beta < expHalfX);
+
+        const V logBeta = logKernel(beta);
+        const V logUpperBeta = logKernel(expHalfX - beta);
+        const V sqrtT = sqrt(T);
+
+        V s = V(1.0);
+        auto upper = V(1.0) < V(0.0);
+        auto seeded = upper;
+        if (seed != nullptr)
+        {
+            s = V::load(seed, n) * sqrtT;
+            seeded = (s > V(0.0)) & (s < V(std::numeric_limits<double>::infinity()));
+            upper = expHalfX - beta < beta;
+        }
+        if (any(valid & !seeded))
+        {
+            V coldS;
+            auto coldUpper = upper;
+            impliedVolatilityColdStart(x, expHalfX, beta, logBeta, coldS, coldUpper);
+            s = select(seeded, s, coldS);
+            upper = (seeded & upper) | ((!seeded) & coldUpper);
+        }
+
+        V steps = V(0.0);
+        const auto done = impliedVolatilityIterate(x, expHalfX, logBeta, logUpperBeta, upper, !valid, s, steps);
+        if (any(!done))
+        {
+            V coldS;
+            auto coldUpper = upper;
+            impliedVolatilityColdStart(x, expHalfX, beta, logBeta, coldS, coldUpper);
+            s = select(done, s, coldS);
+            upper = (done & upper) | ((!done) & coldUpper);
+            impliedVolatilityIterate(x, expHalfX, logBeta, logUpperBeta, upper, done, s, steps);
+        }
+
+        const V vol = select(valid, s / sqrtT, select(atIntrinsic, V(0.0), V(std::numeric_limits<double>::quiet_NaN())));
+        vol.store(volatility, n);
+        if (iterations != nullptr)
+        {
+            alignas(64) double counts[V::width];
+            steps.store(counts);
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                iterations[j] = static_cast<std::uint8_t>(counts[j]);
+            }
+        }
+    }
+
+    /// @brief Implied volatilities of a batch of mixed option types. iterations may be null.
+    template <class V>
+    SIMD_INLINE void impliedVolatilityArray(std::size_t count, const double* optionPrice, const double* underlyingPrice,
+                                            const double* strikePrice, const double* timeToExperation,
+                                            const double* riskFreeRate, const OptionType* optionType,
+                                            double* volatility, std::uint8_t* iterations)
+    {
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            impliedVolatilityBlock<V>(optionPrice + i, underlyingPrice + i, strikePrice + i, timeToExperation + i,
+                                      riskFreeRate + i, loadOptionSign<V>(optionType + i, n), nullptr, volatility + i,
+                                      iterations == nullptr ? nullptr : iterations + i, n);
+        });
+    }
+
+    /**
+     * @brief Implied volatilities of the strikes of one expiry, warm-started.
+     *
+     * A strike whose previousVolatility is positive and finite starts from it; any other strike starts from
+     * the volatility just solved for the nearest strike of the previous block, so only the first block of a
+     * chain without a previous snapshot is solved cold. Strikes in increasing order give the closest seeds.
+     * previousVolatility may be null or alias volatility; iterations may be null.
+     */
+    template <class V>
+    SIMD_INLINE void impliedVolatilityChainArray(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                                 std::size_t count, const double* optionPrice,
+                                                 const double* strikePrice, const OptionType* optionType,
+                                                 const double* previousVolatility, double* volatility,
+                                                 std::uint8_t* iterations)
+    {
+        alignas(64) double spot[V::width], expiry[V::width], rate[V::width], seed[V::width];
+        for (std::size_t j = 0; j < V::width; ++j)
+        {
+            spot[j] = underlyingPrice;
+            expiry[j] = timeToExperation;
+            rate[j] = riskFreeRate;
+        }
+
+        double neighbor = std::numeric_limits<double>::quiet_NaN();
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            for (std::size_t j = 0; j < n; ++j)
+            {
+                const double previous = previousVolatility == nullptr ? 0.0 : previousVolatility[i + j];
+                seed[j] = previous > 0.0 && previous < std::numeric_limits<double>::infinity() ? previous : neighbor;
+            }
+            impliedVolatilityBlock<V>(optionPrice + i, spot, strikePrice + i, expiry, rate,
+                                      loadOptionSign<V>(optionType + i, n), seed, volatility + i,
+                                      iterations == nullptr ? nullptr : iterations + i, n);
+            for (std::size_t j = n; j-- > 0;)
+            {
+                if (volatility[i + j] > 0.0)
+                {
+                    neighbor = volatility[i + j];
+                    break;
+                }
+            }
+        });
+    }
+
+    /**
+     * @brief Volatilities from an SVI surface (volatilitySurface.h) of sliceCount slices.
+     *
+     * sliceTable holds six columns of sliceCount doubles: expiry (increasing), a, b, rho, m and sigma^2. The
+     * slices around each T are found by counting the expiries <= T and their parameters gathered; the total
+     * variance of k = ln(K / S) - rT is linear in T between them and scales with T outside them. Options with
+     * a non-positive or NaN T or K / S, and every option of an empty surface, get NaN.
+     */
+    template <class V>
+    SIMD_INLINE void sviVolatilityArray(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                        const double* timeToExperation, const double* riskFreeRate,
+                                        std::size_t sliceCount, const double* sliceTable, double* volatility)
+    {
+        const double* expiry = sliceTable;
+        const double* column[5] = {sliceTable + sliceCount, sliceTable + 2 * sliceCount, sliceTable + 3 * sliceCount,
+                                   sliceTable + 4 * sliceCount, sliceTable + 5 * sliceCount};
+        if (sliceCount == 0)
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                volatility[i] = std::numeric_limits<double>::quiet_NaN();
+            }
+            return;
+        }
+
+        const V last(static_cast<double>(sliceCount) - 1.0);
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            const V T = V::load(timeToExperation + i, n);
+            const V ratio = V::load(strikePrice + i, n) / V::load(underlyingPrice + i, n);
+            const auto valid = (T > V(0.0)) & (ratio > V(0.0));
+            const V k = logKernel(select(valid, ratio, V(1.0))) - V::load(riskFreeRate + i, n) * T;
+
+            V above(0.0);
+            for (std::size_t s = 0; s < sliceCount; ++s)
+            {
+                above = above + select(T >= V(expiry[s]), V(1.0), V(0.0));
+            }
+            const V lower = max(above - V(1.0), V(0.0));
+            const V upper = min(above, last);
+
+            V w[2], slice[2];
+            for (int side = 0; side < 2; ++side)
+            {
+                const V index = side == 0 ? lower : upper;
+                const V x = k - gather(column[3], index);
+                const V root = sqrt(fma(x, x, gather(column[4], index)));
+                w[side] = fma(gather(column[1], index), fma(gather(column[2], index), x, root), gather(column[0], index));
+                slice[side] = gather(expiry, index);
+            }
+
+            const auto outside = lower == upper;
+            const V t = (T - slice[0]) / select(outside, V(1.0), slice[1] - slice[0]);
+            const V total = select(outside, w[0] * (T / slice[0]), fma(t, w[1] - w[0], w[0]));
+            select(valid, sqrt(total / T), V(std::numeric_limits<double>::quiet_NaN())).store(volatility + i, n);
+        });
+    }
+
+    /**
+     * @brief sin(2 pi t) and cos(2 pi t) for t in [0, 1]. 4t is split exactly into the nearest quarter turn q
+     *        and a remainder x = (4t - q) pi / 2, |x| <= pi / 4, whose Taylor polynomials of degrees 15 and 16
+     *        are within 1 ulp; q then swaps and negates them.
+     */
+    template <class V>
+    SIMD_INLINE void sinCosTurnsKernel(V turns, V& sine, V& cosine)
+    {
+        const V quarters = V(4.0) * turns;
+        const V quadrant = roundNearest(quarters);
+        const V x = (quarters - quadrant) * V(std::numbers::pi / 2);
+        const V xx = x * x;
+
+        V s = V(-1.0 / 1307674368000.0);
+        s = fma(s, xx, V(1.0 / 6227020800.0));
+        s = fma(s, xx, V(-1.0 / 39916800.0));
+        s = fma(s, xx, V(1.0 / 362880.0));
+        s = fma(s, xx, V(-1.0 / 5040.0));
+        s = fma(s, xx, V(1.0 / 120.0));
+        s = fma(s, xx, V(-1.0 / 6.0));
+        s = fma(s * xx, x, x);
+
+        V c = V(1.0 / 20922789888000.0);
+        c = fma(c, xx, V(-1.0 / 87178291200.0));
+        c = fma(c, xx, V(1.0 / 479001600.0));
+        c = fma(c, xx, V(-1.0 / 3628800.0));
+        c = fma(c, xx, V(1.0 / 40320.0));
+        c = fma(c, xx, V(-1.0 / 720.0));
+        c = fma(c, xx, V(1.0 / 24.0));
+        c = fma(c, xx, V(-0.5));
+        c = fma(c, xx, V(1.0));
+
+        // Quarter turns 1 and 3 swap sine and cosine; 1 and 2 negate the cosine, 2 and 3 the sine.
+        const auto first = quadrant == V(1.0);
+        const auto second = quadrant == V(2.0);
+        const auto third = quadrant == V(3.0);
+        const auto swap = first | third;
+        const V swappedSine = select(swap, c, s);
+        const V swappedCosine = select(swap, s, c);
+        sine = select(second | third, -swappedSine, swappedSine);
+        cosine = select(first | second, -swappedCosine, swappedCosine);
+    }
+
+    // Lane offsets 0, 1, ..., width - 1 of the counters of one vecu.
+    alignas(64) inline constexpr std::uint64_t laneIndex[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    /**
+     * @brief philox4x32 of one counter per lane. Word i of the counters is in the low 32 bits of word[i] and is
+     *        replaced by word i of the result; the high 32 bits are not read and are left undefined.
+     */
+    template <class U>
+    SIMD_INLINE void philoxKernel(U (&word)[4], std::uint32_t key0, std::uint32_t key1)
+    {
+        for (int round = 0; round < 10; ++round)
+        {
+            const U product0 = mulWide(word[0], U(0xD2511F53u));
+            const U product1 = mulWide(word[2], U(0xCD9E8D57u));
+            word[0] = shiftRight<32>(product1) ^ word[1] ^ U(key0);
+            word[2] = shiftRight<32>(product0) ^ word[3] ^ U(key1);
+            word[1] = product1;
+            word[3] = product0;
+            key0 += 0x9E3779B9u;
+            key1 += 0xBB67AE85u;
+        }
+    }
+
+    /// @brief philoxUniform of the 32-bit words in the low bits of high and low.
+    template <class V, class U>
+    SIMD_INLINE V philoxUniformKernel(U high, U low)
+    {
+        const U bits = shiftRight<12>(shiftLeft<32>(high) | (low & U(0xFFFFFFFFu)));
+        return (asDouble(bits | U(0x3FF0000000000000ull)) - V(1.0)) + V(0x1.0p-53);
+    }
+
+    /**
+     * @brief The Box-Muller pair of one Philox counter per lane, first = r cos(2 pi u2), second = r sin(2 pi u2),
+     *        r = sqrt(-2 ln u1): the numbers of philoxNormalPair up to the rounding of the log, sine and cosine.
+     * @param word The counters, as for philoxKernel; overwritten.
+     */
+    template <class V, class U>
+    SIMD_INLINE void philoxNormalPairKernel(U (&word)[4], std::uint64_t seed, V& first, V& second)
+    {
+        philoxKernel(word, static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32));
+        const V radius = sqrt(V(-2.0) * logKernel(philoxUniformKernel<V>(word[0], word[1])));
+        V sine, cosine;
+        sinCosTurnsKernel(philoxUniformKernel<V>(word[2], word[3]), sine, cosine);
+        first = radius * cosine;
+        second = radius * sine;
+    }
+
+    /// @brief Standard normal pairs from the Philox counters (stream, index + k) of seed, k < count.
+    template <class V, class U>
+    SIMD_INLINE void philoxNormalPairsArray(std::uint64_t seed, std::uint64_t stream, std::uint64_t index,
+                                            std::size_t count, double* first, double* second)
+    {
+        const U lanes = U::load(laneIndex);
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            const U counter = U(index + i) + lanes;
+            U word[4] = {counter, shiftRight<32>(counter), U(stream), U(stream >> 32)};
+            V z1, z2;
+            philoxNormalPairKernel(word, seed, z1, z2);
+            z1.store(first + i, n);
+            z2.store(second + i, n);
+        });
+    }
+
+    /**
+     * @brief Terminal variances of the Heston full-truncation Euler scheme for paths firstPath + k, k < count,
+     *        one path per lane: step i of path p draws the pair of Philox counter (p, i) of seed, as
+     *        counter-based hestonMonteCarloPrice does, and correlates it with rho.
+     *
+     * The lanes advance in lockstep, so the variances and the normals of a step never leave the registers.
+     * sqrt(v dt) Z2 is taken as one root, sqrt(-2 ln u1 v dt) (rho cos + sqrt(1 - rho^2) sin), instead of the
+     * Box-Muller radius and the root of v dt. Normals dominate the cost, so more vectors in flight do not help.
+     */
+    template <class V, class U>
+    SIMD_INLINE void hestonEulerVarianceArray(std::uint64_t seed, std::uint64_t firstPath, std::size_t count,
+                                              double v0, double kappa, double theta, double sigma, double rho,
+                                              double dt, int numTimeSteps, double* variance)
+    {
+        const std::uint32_t key0 = static_cast<std::uint32_t>(seed);
+        const std::uint32_t key1 = static_cast<std::uint32_t>(seed >> 32);
+        const V rhoComplement(std::sqrt(1.0 - rho * rho));
+        const U lanes = U::load(laneIndex);
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            const U path = U(firstPath + i) + lanes;
+            const U pathHigh = shiftRight<32>(path);
+            V Vt(v0);
+            for (int step = 0; step < numTimeSteps; ++step)
+            {
+                U word[4] = {U(static_cast<std::uint64_t>(step)), U(0), path, pathHigh};
+                philoxKernel(word, key0, key1);
+                const V logUniform = logKernel(philoxUniformKernel<V>(word[0], word[1]));
+                V sine, cosine;
+                sinCosTurnsKernel(philoxUniformKernel<V>(word[2], word[3]), sine, cosine);
+                const V direction = fma(V(rho), cosine, rhoComplement * sine);
+
+                const V positive = max(V(0.0), Vt);
+                const V diffusion = V(sigma) * sqrt(V(-2.0 * dt) * logUniform * positive) * direction;
+                Vt = max(V(0.0), Vt + fma(V(kappa * dt), V(theta) - positive, diffusion));
+            }
+            Vt.store(variance + i, n);
+        });
+    }
+
+    /**
+     * @brief Terminal variances of the Heston quadratic-exponential scheme (Andersen 2008) for paths
+     *        firstPath + k, k < count, one path per lane, with the normals of hestonEulerVarianceArray: step i
+     *        of path p uses Z2 = rho Z1 + sqrt(1 - rho^2) Z1' of Philox counter (p, i).
+     *
+     * Given v, the next variance has the conditional mean m = mean + decay v and variance
+     * s^2 = varianceSlope v + varianceConstant of the exact process. With psi = s^2 / m^2 <= 1.5 it is
+     * a (sqrt(b^2) + Z2)^2, b^2 = 2 / psi - 1 + sqrt(2 / psi (2 / psi - 1)), a = m / (1 + b^2); above, it is 0
+     * with probability p = (psi - 1) / (psi + 1) and otherwise exponential with mean m / (1 - p), by
+     * inversion of u = N(Z2). Both branches are evaluated and selected per lane.
+     */
+    template <class V, class U>
+    SIMD_INLINE void hestonQEVarianceArray(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0,
+                                           double decay, double mean, double varianceSlope, double varianceConstant,
+                                           double rho, int numTimeSteps, double* variance)
+    {
+        const V rhoComplement(std::sqrt(1.0 - rho * rho));
+        const U lanes = U::load(laneIndex);
+        forEachBlock<V>(count, [&](std::size_t i, std::size_t n) {
+            const U path = U(firstPath + i) + lanes;
+            const U pathHigh = shiftRight<32>(path);
+            V Vt(v0);
+            for (int step = 0; step < numTimeSteps; ++step)
+            {
+                U word[4] = {U(static_cast<std::uint64_t>(step)), U(0), path, pathHigh};
+                V z1, z2;
+                philoxNormalPairKernel(word, seed, z1, z2);
+                const V z = V(rho) * z1 + rhoComplement * z2;
+
+                const V m = fma(Vt, V(decay), V(mean));
+                const V psi = fma(Vt, V(varianceSlope), V(varianceConstant)) / (m * m);
+
+                const V twoOverPsi = V(2.0) / psi;
+                const V b2 = twoOverPsi - V(1.0) + sqrt(twoOverPsi * (twoOverPsi - V(1.0)));
+                const V root = sqrt(b2) + z;
+                const V quadratic = m / (V(1.0) + b2) * (root * root);
+
+                const V p = (psi - V(1.0)) / (psi + V(1.0));
+                const V tail = normalCDFKernel(-z);
+                const V exponential = select(tail >= V(1.0) - p, V(0.0), logKernel((V(1.0) - p) / tail) * m / (V(1.0) - p));
+
+                // psi = 0 (no vol of vol) leaves the mean; m = 0 only from v = 0 with theta = 0.
+                Vt = select(psi <= V(1.5), select(psi == V(0.0), m, quadratic), exponential);
+                Vt = select(m > V(0.0), Vt, V(0.0));
+            }
+            Vt.store(variance + i, n);
+        });
+    }
+
+    // Single precision. ln(2) split so that n * ln2HighF is exact for |n| < 2^15.
+    inline constexpr float ln2HighF = 0.693359375f;
+    inline constexpr float ln2LowF = -2.12194440e-4f;
+
+    /// @brief e^x in float: x = n ln2 + r, |r| <= ln2 / 2, and a degree-7 Taylor polynomial.
+    template <class VF>
+    SIMD_INLINE VF expKernelF(VF x)
+    {
+        const VF xc = min(max(x, VF(-104.0f)), VF(89.0f));
+        const VF n = roundNearest(xc * VF(std::numbers::log2e_v<float>));
+        VF r = fma(n, VF(-ln2HighF), xc);
+        r = fma(n, VF(-ln2LowF), r);
+
+        VF p = VF(1.0f / 5040.0f);
+        p = fma(p, r, VF(1.0f / 720.0f));
+        p = fma(p, r, VF(1.0f / 120.0f));
+        p = fma(p, r, VF(1.0f / 24.0f));
+        p = fma(p, r, VF(1.0f / 6.0f));
+        p = fma(p, r, VF(0.5f));
+        p = fma(p, r, VF(1.0f));
+        p = fma(p, r, VF(1.0f));
+
+        const VF half = roundNearest(n * VF(0.5f));
+        const VF result = p * pow2n(half) * pow2n(n - half);
+
+        return select(isnan(x), x, result);
+    }
+
+    /// @brief ln(x) in float from x = m 2^e and the atanh series of (m - 1) / (m + 1).
+    template <class VF>
+    SIMD_INLINE VF logKernelF(VF x)
+    {
+        const auto subnormal = x < VF(std::numeric_limits<float>::min());
+        const VF scaled = select(subnormal, x * VF(0x1.0p25f), x);
+        VF e = exponentOf(scaled) - select(subnormal, VF(25.0f), VF(0.0f));
+        VF m = mantissaOf(scaled);
+
+        const auto upper = m > VF(std::numbers::sqrt2_v<float>);
+        m = select(upper, m * VF(0.5f), m);
+        e = select(upper, e + VF(1.0f), e);
+
+        const VF s = (m - VF(1.0f)) / (m + VF(1.0f));
+        const VF z = s * s;
+        VF p = VF(1.0f / 11.0f);
+        p = fma(p, z, VF(1.0f / 9.0f));
+        p = fma(p, z, VF(1.0f / 7.0f));
+        p = fma(p, z, VF(1.0f / 5.0f));
+        p = fma(p, z, VF(1.0f / 3.0f));
+        const VF logm = fma(VF(2.0f) * s * z, p, VF(2.0f) * s);
+
+        VF result = fma(e, VF(ln2HighF), fma(e, VF(ln2LowF), logm));
+        result = select(x == VF(std::numeric_limits<float>::infinity()), x, result);
+        result = select(x == VF(0.0f), VF(-std::numeric_limits<float>::infinity()), result);
+        result = select(x < VF(0.0f), VF(std::numeric_limits<float>::quiet_NaN()), result);
+
+        return select(isnan(x), x, result);
+    }
+
+    /// @brief N(x) in float with the Abramowitz-Stegun polynomial, from an already computed phi(d).
+    template <class VF>
+    SIMD_INLINE VF normalCDFFromPDFKernelF(VF d, VF density)
+    {
+        const VF K = VF(1.0f) / fma(VF(0.2316419f), abs(d), VF(1.0f));
+
+        VF poly = VF(1.330274429f);
+        poly = fma(poly, K, VF(-1.821255978f));
+        poly = fma(poly, K, VF(1.781477937f));
+        poly = fma(poly, K, VF(-0.356563782f));
+        poly = fma(poly, K, VF(0.319381530f));
+        poly = poly * K;
+
+        // Return the tail directly for d < 0 rather than 1 - (1 - tail): in float the round trip through 1
+        // would leave an absolute error of 6e-8 on values that can be far smaller.
+        const VF tail = density * poly;
+
+        return select(d < VF(0.0f), tail, VF(1.0f) - tail);
+    }
+
+    /// @brief phi(d) in float.
+    template <class VF>
+    SIMD_INLINE VF normalPDFKernelF(VF d)
+    {
+        return VF(std::numbers::inv_sqrtpi_v<float> / std::numbers::sqrt2_v<float>) * expKernelF(VF(-0.5f) * d * d);
+    }
+
+    /// @brief N(x) in float.
+    template <class VF>
+    SIMD_INLINE VF normalCDFKernelF(VF d)
+    {
+        return normalCDFFromPDFKernelF(d, normalPDFKernelF(d));
+    }
+
+    /// @brief +1 for calls and -1 for puts as floats, loaded for n <= VF::width options; NaN for any other type.
+    template <class VF>
+    SIMD_INLINE VF loadOptionSignF(const OptionType* optionType, std::size_t n)
+    {
+        alignas(64) float sign[VF::width];
+        for (std::size_t j = 0; j < VF::width; ++j)
+        {
+            sign[j] = j >= n || optionType[j] == CALL ? 1.0f
+                      : optionType[j] == PUT         ? -1.0f
+                                                     : std::numeric_limits<float>::quiet_NaN();
+        }
+        return VF::load(sign);
+    }
+
+    /// @brief Black-Scholes price of n <= VF::width options in float, with an estimate of its relative
+    /// error against the double path.
+    ///
+    /// The estimate is 8 u (S N(d1) + K e^{-rT} N(d2) + S phi(d1) (|d1| + |d2| + vol sqrt(T))) / |price|
+    /// with u = 2^-24. The first two terms bound the rounding of the two terms of the formula, of the inputs
+    /// and the cancellation between them. The last term bounds the rounding of d1 and d2 that does not cancel
+    /// between N(d1) and N(d2). The factor 8 covers the float exp and polynomial errors; over a wide random batch
+    /// (benchmarkMixedPrecision) no error exceeded the estimate. The estimate grows without bound for deep
+    /// out-of-the-money options, very short expiries and prices that underflow in float, which are the options the
+    /// mixed-precision path re-prices in double. Invalid inputs give a NaN price and a NaN estimate.
+    template <class VF>
+    SIMD_INLINE void blackScholesPriceBlockF(const float* underlyingPrice, const float* strikePrice,
+                                             const float* timeToExperation, const float* riskFreeRate,
+                                             const float* volatility, VF sign, float* optionPrice,
+                                             float* relativeError, std::size_t n)
+    {
+        const VF S = VF::load(underlyingPrice, n);
+        const VF K = VF::load(strikePrice, n);
+        const VF T = VF::load(timeToExperation, n);
+        const VF r = VF::load(riskFreeRate, n);
+        const VF vol = VF::load(volatility, n);
+
+        const VF volSqrtT = vol * sqrt(T);
+        const VF d1 = fma(fma(VF(0.5f) * vol, vol, r), T, logKernelF(S / K)) / volSqrtT;
+        const VF d2 = d1 - volSqrtT;
+        const VF discountedStrike = K * expKernelF(-r * T);
+
+        const VF density1 = normalPDFKernelF(d1);
+        const VF Nd1 = normalCDFFromPDFKernelF(sign * d1, density1);
+        const VF Nd2 = normalCDFKernelF(sign * d2);
+        const VF price = sign * (S * Nd1 - discountedStrike * Nd2);
+
+        const auto valid = (vol > VF(0.0f)) & (vol < VF(1.0f)) & (T >= VF(0.0f));
+        const VF nan = VF(std::numeric_limits<float>::quiet_NaN());
+        select(valid, price, nan).store(optionPrice, n);
+
+        if (relativeError != nullptr)
+        {
+            const VF spread = abs(d1) + abs(d2) + volSqrtT;
+            const VF magnitude = S * Nd1 + discountedStrike * Nd2 + S * density1 * spread;
+            // The smallest normal float bounds the error of prices that underflow.
+            const VF floor = VF(std::numeric_limits<float>::min());
+            const VF estimate = fma(VF(0x1.0p-21f), magnitude, floor) / abs(price);
+            select(valid, estimate, nan).store(relativeError, n);
+        }
+    }
+
+    template <class VF>
+    SIMD_INLINE void normalCDFArrayF(const float* x, float* result, std::size_t count)
+    {
+        forEachBlock<VF>(count, [&](std::size_t i, std::size_t n) { normalCDFKernelF(VF::load(x + i, n)).store(result + i, n); });
+    }
+
+    template <class VF>
+    SIMD_INLINE void expArrayF(const float* x, float* result, std::size_t count)
+    {
+        forEachBlock<VF>(count, [&](std::size_t i, std::size_t n) { expKernelF(VF::load(x + i, n)).store(result + i, n); });
+    }
+
+    template <class VF>
+    SIMD_INLINE void logArrayF(const float* x, float* result, std::size_t count)
+    {
+        forEachBlock<VF>(count, [&](std::size_t i, std::size_t n) { logKernelF(VF::load(x + i, n)).store(result + i, n); });
+    }
+
+    /// @brief Prices a batch of mixed option types in float; relativeError may be null.
+    template <class VF>
+    SIMD_INLINE void blackScholesPriceArrayF(std::size_t count, const float* underlyingPrice, const float* strikePrice,
+                                             const float* timeToExperation, const float* riskFreeRate,
+                                             const float* volatility, const OptionType* optionType,
+                                             float* optionPrice, float* relativeError)
+    {
+        forEachBlock<VF>(count, [&](std::size_t i, std::size_t n) {
+            blackScholesPriceBlockF<VF>(underlyingPrice + i, strikePrice + i, timeToExperation + i, riskFreeRate + i,
+                                        volatility + i, loadOptionSignF<VF>(optionType + i, n), optionPrice + i,
+                                        relativeError == nullptr ? nullptr : relativeError + i, n);
+        });
+    }
+}
+
+#endif // SIMDKERNELS_H
@@ -0,0 +1,397 @@
+#ifndef SIMDMATH_H
+#define SIMDMATH_H
+
+#include <cstddef>
+#include <cstdint>
+
+#include "optionType.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SIMD_X86 1
+#endif
+
+/**
+ * @file simdMath.h
+ * @brief Array-level normal CDF, exp, log, Black-Scholes price and Greeks kernels, one namespace per instruction set.
+ *
+ * simd::scalar processes one element at a time and runs anywhere. simd::sse42 (2 doubles per instruction),
+ * simd::avx2 (4) and simd::avx512 (8) are only declared on x86-64 and must only be called on a CPU that
+ * supports them; cpuDispatch.h picks the best one at runtime. Accuracy is documented in simdKernels.h;
+ * all levels share the same kernels.
+ *
+ * The ...Of<Type> functions take batches whose options all have type Type and are instantiated for CALL and
+ * PUT; blackScholesGreeksOf computes the price and all first-order Greeks. The ...Float functions run the
+ * single-precision kernels on twice as many lanes; blackScholesPriceFloat also writes the estimated
+ * relative error of every price (see blackScholesPriceBlockF) unless relativeError is null. The ...Tabulated
+ * functions evaluate N(x) from the table in normalCDFTable.h instead of the polynomial. The ...Chain
+ * functions price the strikes of one expiry, computing ln(S), sqrt(T) and e^{-rT} once for all of them.
+ * impliedVolatility inverts Black-Scholes prices and, unless iterations is null, writes the number of
+ * Householder steps each option took; impliedVolatilityChain does the same for the strikes of one expiry,
+ * seeded from previousVolatility (may be null) and from the strikes already solved. sviVolatility evaluates
+ * the SVI surface packed in sliceTable (see sviVolatilityArray) for a batch of options.
+ * blackScholesSelectedGreeks writes only the results whose GreekMask bits are set in greeks, result b to
+ * output[greekIndex(b)]. philoxNormalPairs fills first and second with the Box-Muller normal pairs of the
+ * Philox counters (stream, index + k) of seed (see philoxNormalPairsArray). hestonEulerVariance writes the
+ * terminal variances of count Heston paths from firstPath on, simulated in lockstep (see hestonEulerVarianceArray);
+ * hestonQEVariance does the same with the quadratic-exponential scheme (see hestonQEVarianceArray).
+ *
+ * Input and output arrays may alias element for element.
+ */
+namespace simd
+{
+    namespace scalar
+    {
+        void normalCDF(const double* x, double* result, std::size_t count);
+
+        void exp(const double* x, double* result, std::size_t count);
+
+        void log(const double* x, double* result, std::size_t count);
+
+        void blackScholesPrice(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                               const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                               const OptionType* optionType, double* optionPrice);
+
+        void blackScholesGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                const OptionType* optionType, double* optionPrice, double* delta, double* gamma,
+                                double* vega, double* theta, double* rho);
+
+        template <OptionType Type>
+        void blackScholesPriceOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                 const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                 double* optionPrice);
+
+        template <OptionType Type>
+        void blackScholesGreeksOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                  const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                  double* optionPrice, double* delta, double* gamma, double* vega, double* theta,
+                                  double* rho);
+
+        void normalCDFFloat(const float* x, float* result, std::size_t count);
+
+        void expFloat(const float* x, float* result, std::size_t count);
+
+        void logFloat(const float* x, float* result, std::size_t count);
+
+        void blackScholesPriceFloat(std::size_t count, const float* underlyingPrice, const float* strikePrice,
+                                    const float* timeToExperation, const float* riskFreeRate, const float* volatility,
+                                    const OptionType* optionType, float* optionPrice, float* relativeError);
+
+        void normalCDFTabulated(const double* x, double* result, std::size_t count);
+
+        void blackScholesPriceTabulated(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                        const double* timeToExperation, const double* riskFreeRate,
+                                        const double* volatility, const OptionType* optionType, double* optionPrice);
+
+        template <OptionType Type>
+        void blackScholesPriceTabulatedOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                          const double* timeToExperation, const double* riskFreeRate,
+                                          const double* volatility, double* optionPrice);
+
+        void blackScholesChainPrice(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                    std::size_t count, const double* strikePrice, const double* volatility,
+                                    const OptionType* optionType, double* optionPrice);
+
+        void blackScholesChainGreeks(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                     std::size_t count, const double* strikePrice, const double* volatility,
+                                     const OptionType* optionType, double* optionPrice, double* delta,
+                                     double* gamma, double* vega, double* theta, double* rho);
+
+        void impliedVolatility(std::size_t count, const double* optionPrice, const double* underlyingPrice,
+                               const double* strikePrice, const double* timeToExperation, const double* riskFreeRate,
+                               const OptionType* optionType, double* volatility, std::uint8_t* iterations);
+
+        void impliedVolatilityChain(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                    std::size_t count, const double* optionPrice, const double* strikePrice,
+                                    const OptionType* optionType, const double* previousVolatility,
+                                    double* volatility, std::uint8_t* iterations);
+
+        void sviVolatility(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                           const double* timeToExperation, const double* riskFreeRate, std::size_t sliceCount,
+                           const double* sliceTable, double* volatility);
+
+        void blackScholesSelectedGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                        const double* timeToExperation, const double* riskFreeRate,
+                                        const double* volatility, const OptionType* optionType, unsigned greeks,
+                                        double* const* output);
+
+        void philoxNormalPairs(std::uint64_t seed, std::uint64_t stream, std::uint64_t index, std::size_t count,
+                               double* first, double* second);
+
+        void hestonEulerVariance(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0,
+                                 double kappa, double theta, double sigma, double rho, double dt, int numTimeSteps,
+                                 double* variance);
+
+        void hestonQEVariance(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0, double decay,
+                              double mean, double varianceSlope, double varianceConstant, double rho, int numTimeSteps,
+                              double* variance);
+    }
+
+#if defined(SIMD_X86)
+    namespace sse42
+    {
+        void normalCDF(const double* x, double* result, std::size_t count);
+
+        void exp(const double* x, double* result, std::size_t count);
+
+        void log(const double* x, double* result, std::size_t count);
+
+        void blackScholesPrice(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                               const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                               const OptionType* optionType, double* optionPrice);
+
+        void blackScholesGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                const OptionType* optionType, double* optionPrice, double* delta, double* gamma,
+                                double* vega, double* theta, double* rho);
+
+        template <OptionType Type>
+        void blackScholesPriceOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                 const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                 double* optionPrice);
+
+        template <OptionType Type>
+        void blackScholesGreeksOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                  const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                  double* optionPrice, double* delta, double* gamma, double* vega, double* theta,
+                                  double* rho);
+
+        void normalCDFFloat(const float* x, float* result, std::size_t count);
+
+        void expFloat(const float* x, float* result, std::size_t count);
+
+        void logFloat(const float* x, float* result, std::size_t count);
+
+        void blackScholesPriceFloat(std::size_t count, const float* underlyingPrice, const float* strikePrice,
+                                    const float* timeToExperation, const float* riskFreeRate, const float* volatility,
+                                    const OptionType* optionType, float* optionPrice, float* relativeError);
+
+        void normalCDFTabulated(const double* x, double* result, std::size_t count);
+
+        void blackScholesPriceTabulated(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                        const double* timeToExperation, const double* riskFreeRate,
+                                        const double* volatility, const OptionType* optionType, double* optionPrice);
+
+        template <OptionType Type>
+        void blackScholesPriceTabulatedOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                          const double* timeToExperation, const double* riskFreeRate,
+                                          const double* volatility, double* optionPrice);
+
+        void blackScholesChainPrice(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                    std::size_t count, const double* strikePrice, const double* volatility,
+                                    const OptionType* optionType, double* optionPrice);
+
+        void blackScholesChainGreeks(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                     std::size_t count, const double* strikePrice, const double* volatility,
+                                     const OptionType* optionType, double* optionPrice, double* delta,
+                                     double* gamma, double* vega, double* theta, double* rho);
+
+        void impliedVolatility(std::size_t count, const double* optionPrice, const double* underlyingPrice,
+                               const double* strikePrice, const double* timeToExperation, const double* riskFreeRate,
+                               const OptionType* optionType, double* volatility, std::uint8_t* iterations);
+
+        void impliedVolatilityChain(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                    std::size_t count, const double* optionPrice, const double* strikePrice,
+                                    const OptionType* optionType, const double* previousVolatility,
+                                    double* volatility, std::uint8_t* iterations);
+
+        void sviVolatility(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                           const double* timeToExperation, const double* riskFreeRate, std::size_t sliceCount,
+                           const double* sliceTable, double* volatility);
+
+        void blackScholesSelectedGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                        const double* timeToExperation, const double* riskFreeRate,
+                                        const double* volatility, const OptionType* optionType, unsigned greeks,
+                                        double* const* output);
+
+        void philoxNormalPairs(std::uint64_t seed, std::uint64_t stream, std::uint64_t index, std::size_t count,
+                               double* first, double* second);
+
+        void hestonEulerVariance(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0,
+                                 double kappa, double theta, double sigma, double rho, double dt, int numTimeSteps,
+                                 double* variance);
+
+        void hestonQEVariance(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0, double decay,
+                              double mean, double varianceSlope, double varianceConstant, double rho, int numTimeSteps,
+                              double* variance);
+    }
+
+    namespace avx2
+    {
+        void normalCDF(const double* x, double* result, std::size_t count);
+
+        void exp(const double* x, double* result, std::size_t count);
+
+        void log(const double* x, double* result, std::size_t count);
+
+        void blackScholesPrice(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                               const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                               const OptionType* optionType, double* optionPrice);
+
+        void blackScholesGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                const OptionType* optionType, double* optionPrice, double* delta, double* gamma,
+                                double* vega, double* theta, double* rho);
+
+        template <OptionType Type>
+        void blackScholesPriceOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                 const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                 double* optionPrice);
+
+        template <OptionType Type>
+        void blackScholesGreeksOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                  const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                  double* optionPrice, double* delta, double* gamma, double* vega, double* theta,
+                                  double* rho);
+
+        void normalCDFFloat(const float* x, float* result, std::size_t count);
+
+        void expFloat(const float* x, float* result, std::size_t count);
+
+        void logFloat(const float* x, float* result, std::size_t count);
+
+        void blackScholesPriceFloat(std::size_t count, const float* underlyingPrice, const float* strikePrice,
+                                    const float* timeToExperation, const float* riskFreeRate, const float* volatility,
+                                    const OptionType* optionType, float* optionPrice, float* relativeError);
+
+        void normalCDFTabulated(const double* x, double* result, std::size_t count);
+
+        void blackScholesPriceTabulated(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                        const double* timeToExperation, const double* riskFreeRate,
+                                        const double* volatility, const OptionType* optionType, double* optionPrice);
+
+        template <OptionType Type>
+        void blackScholesPriceTabulatedOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                          const double* timeToExperation, const double* riskFreeRate,
+                                          const double* volatility, double* optionPrice);
+
+        void blackScholesChainPrice(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                    std::size_t count, const double* strikePrice, const double* volatility,
+                                    const OptionType* optionType, double* optionPrice);
+
+        void blackScholesChainGreeks(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                     std::size_t count, const double* strikePrice, const double* volatility,
+                                     const OptionType* optionType, double* optionPrice, double* delta,
+                                     double* gamma, double* vega, double* theta, double* rho);
+
+        void impliedVolatility(std::size_t count, const double* optionPrice, const double* underlyingPrice,
+                               const double* strikePrice, const double* timeToExperation, const double* riskFreeRate,
+                               const OptionType* optionType, double* volatility, std::uint8_t* iterations);
+
+        void impliedVolatilityChain(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                    std::size_t count, const double* optionPrice, const double* strikePrice,
+                                    const OptionType* optionType, const double* previousVolatility,
+                                    double* volatility, std::uint8_t* iterations);
+
+        void sviVolatility(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                           const double* timeToExperation, const double* riskFreeRate, std::size_t sliceCount,
+                           const double* sliceTable, double* volatility);
+
+        void blackScholesSelectedGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                        const double* timeToExperation, const double* riskFreeRate,
+                                        const double* volatility, const OptionType* optionType, unsigned greeks,
+                                        double* const* output);
+
+        void philoxNormalPairs(std::uint64_t seed, std::uint64_t stream, std::uint64_t index, std::size_t count,
+                               double* first, double* second);
+
+        void hestonEulerVariance(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0,
+                                 double kappa, double theta, double sigma, double rho, double dt, int numTimeSteps,
+                                 double* variance);
+
+        void hestonQEVariance(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0, double decay,
+                              double mean, double varianceSlope, double varianceConstant, double rho, int numTimeSteps,
+                              double* variance);
+    }
+
+    namespace avx512
+    {
+        void normalCDF(const double* x, double* result, std::size_t count);
+
+        void exp(const double* x, double* result, std::size_t count);
+
+        void log(const double* x, double* result, std::size_t count);
+
+        void blackScholesPrice(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                               const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                               const OptionType* optionType, double* optionPrice);
+
+        void blackScholesGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                const OptionType* optionType, double* optionPrice, double* delta, double* gamma,
+                                double* vega, double* theta, double* rho);
+
+        template <OptionType Type>
+        void blackScholesPriceOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                 const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                 double* optionPrice);
+
+        template <OptionType Type>
+        void blackScholesGreeksOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                  const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                                  double* optionPrice, double* delta, double* gamma, double* vega, double* theta,
+                                  double* rho);
+
+        void normalCDFFloat(const float* x, float* result, std::size_t count);
+
+        void expFloat(const float* x, float* result, std::size_t count);
+
+        void logFloat(const float* x, float* result, std::size_t count);
+
+        void blackScholesPriceFloat(std::size_t count, const float* underlyingPrice, const float* strikePrice,
+                                    const float* timeToExperation, const float* riskFreeRate, const float* volatility,
+                                    const OptionType* optionType, float* optionPrice, float* relativeError);
+
+        void normalCDFTabulated(const double* x, double* result, std::size_t count);
+
+        void blackScholesPriceTabulated(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                        const double* timeToExperation, const double* riskFreeRate,
+                                        const double* volatility, const OptionType* optionType, double* optionPrice);
+
+        template <OptionType Type>
+        void blackScholesPriceTabulatedOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                          const double* timeToExperation, const double* riskFreeRate,
+                                          const double* volatility, double* optionPrice);
+
+        void blackScholesChainPrice(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                    std::size_t count, const double* strikePrice, const double* volatility,
+                                    const OptionType* optionType, double* optionPrice);
+
+        void blackScholesChainGreeks(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                     std::size_t count, const double* strikePrice, const double* volatility,
+                                     const OptionType* optionType, double* optionPrice, double* delta,
+                                     double* gamma, double* vega, double* theta, double* rho);
+
+        void impliedVolatility(std::size_t count, const double* optionPrice, const double* underlyingPrice,
+                               const double* strikePrice, const double* timeToExperation, const double* riskFreeRate,
+                               const OptionType* optionType, double* volatility, std::uint8_t* iterations);
+
+        void impliedVolatilityChain(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                    std::size_t count, const double* optionPrice, const double* strikePrice,
+                                    const OptionType* optionType, const double* previousVolatility,
+                                    double* volatility, std::uint8_t* iterations);
+
+        void sviVolatility(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                           const double* timeToExperation, const double* riskFreeRate, std::size_t sliceCount,
+                           const double* sliceTable, double* volatility);
+
+        void blackScholesSelectedGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                        const double* timeToExperation, const double* riskFreeRate,
+                                        const double* volatility, const OptionType* optionType, unsigned greeks,
+                                        double* const* output);
+
+        void philoxNormalPairs(std::uint64_t seed, std::uint64_t stream, std::uint64_t index, std::size_t count,
+                               double* first, double* second);
+
+        void hestonEulerVariance(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0,
+                                 double kappa, double theta, double sigma, double rho, double dt, int numTimeSteps,
+                                 double* variance);
+
+        void hestonQEVariance(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0, double decay,
+                              double mean, double varianceSlope, double varianceConstant, double rho, int numTimeSteps,
+                              double* variance);
+    }
+#endif
+}
+
+#endif // SIMDMATH_H
@@ -0,0 +1,820 @@
+#ifndef SIMDVECTOR_H
+#define SIMDVECTOR_H
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+/**
+ * @file simdVector.h
+ * @brief Thin wrappers over the vector registers used by the kernels in simdKernels.h.
+ *
+ * Every instruction set gets its own namespace (simd::scalar, simd::sse42, simd::avx2, simd::avx512) holding a
+ * `vec` of doubles, a `mask` and the free functions the kernels call (arithmetic, fma, sqrt, compares,
+ * select, any, gather for doubles, ...), plus `vecf` / `maskf`, the same interface over twice as many floats, and
+ * `vecu`, 64-bit integer lanes as many as `vec` has, for the Philox rounds. The kernels are templates over `vec`, so each instruction set instantiates its own copy
+ * and nothing compiled with AVX-512 flags can be picked up by the linker for another level.
+ * vec::fusedMultiplyAdd tells whether fma rounds once; below AVX2 it is a multiply and an add.
+ *
+ * The x86 wrappers are only defined when the translation unit is compiled with the matching flags
+ * (see the per-file COMPILE_OPTIONS in CMakeLists.txt).
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SIMD_INLINE inline __attribute__((always_inline))
+#else
+#define SIMD_INLINE inline
+#endif
+
+namespace simd
+{
+    namespace scalar
+    {
+        /// @brief One-lane fallback with the same interface as the vector types.
+        struct mask
+        {
+            bool m;
+        };
+
+        struct vec
+        {
+            static constexpr std::size_t width = 1;
+            static constexpr bool fusedMultiplyAdd = false;
+            double v;
+
+            vec() = default;
+            SIMD_INLINE vec(double x) : v(x) {}
+
+            SIMD_INLINE static vec load(const double* p, std::size_t = width) { return vec(*p); }
+            SIMD_INLINE void store(double* p, std::size_t = width) const { *p = v; }
+        };
+
+        SIMD_INLINE vec operator+(vec a, vec b) { return a.v + b.v; }
+        SIMD_INLINE vec operator-(vec a, vec b) { return a.v - b.v; }
+        SIMD_INLINE vec operator*(vec a, vec b) { return a.v * b.v; }
+        SIMD_INLINE vec operator/(vec a, vec b) { return a.v / b.v; }
+        SIMD_INLINE vec operator-(vec a) { return -a.v; }
+        SIMD_INLINE vec fma(vec a, vec b, vec c) { return a.v * b.v + c.v; }
+        SIMD_INLINE vec abs(vec a) { return std::fabs(a.v); }
+        SIMD_INLINE vec sqrt(vec a) { return std::sqrt(a.v); }
+        SIMD_INLINE vec min(vec a, vec b) { return a.v < b.v ? a.v : b.v; }
+        SIMD_INLINE vec max(vec a, vec b) { return a.v > b.v ? a.v : b.v; }
+        SIMD_INLINE vec roundNearest(vec a) { return std::nearbyint(a.v); }
+
+        SIMD_INLINE mask operator<(vec a, vec b) { return {a.v < b.v}; }
+        SIMD_INLINE mask operator<=(vec a, vec b) { return {a.v <= b.v}; }
+        SIMD_INLINE mask operator>(vec a, vec b) { return {a.v > b.v}; }
+        SIMD_INLINE mask operator>=(vec a, vec b) { return {a.v >= b.v}; }
+        SIMD_INLINE mask operator==(vec a, vec b) { return {a.v == b.v}; }
+        SIMD_INLINE mask operator&(mask a, mask b) { return {a.m && b.m}; }
+        SIMD_INLINE mask operator|(mask a, mask b) { return {a.m || b.m}; }
+        SIMD_INLINE mask operator!(mask a) { return {!a.m}; }
+        SIMD_INLINE mask isnan(vec a) { return {a.v != a.v}; }
+        SIMD_INLINE vec select(mask m, vec a, vec b) { return m.m ? a : b; }
+        SIMD_INLINE bool any(mask m) { return m.m; }
+
+        // base[index] per lane; index holds non-negative integers.
+        SIMD_INLINE vec gather(const double* base, vec index) { return base[static_cast<std::size_t>(index.v)]; }
+
+        /// @brief 2^n for integral n in [-1022, 1023].
+        SIMD_INLINE vec pow2n(vec n)
+        {
+            return std::bit_cast<double>(static_cast<std::uint64_t>(static_cast<std::int64_t>(n.v) + 1023) << 52);
+        }
+
+        /// @brief Unbiased binary exponent of a positive normal number.
+        SIMD_INLINE vec exponentOf(vec x)
+        {
+            return static_cast<double>(static_cast<std::int64_t>((std::bit_cast<std::uint64_t>(x.v) >> 52) & 0x7ff) - 1023);
+        }
+
+        /// @brief Significand of a positive normal number, in [1, 2).
+        SIMD_INLINE vec mantissaOf(vec x)
+        {
+            return std::bit_cast<double>((std::bit_cast<std::uint64_t>(x.v) & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull);
+        }
+
+        /// @brief One-lane float fallback with the same interface as the float vector types.
+        struct maskf
+        {
+            bool m;
+        };
+
+        struct vecf
+        {
+            static constexpr std::size_t width = 1;
+            float v;
+
+            vecf() = default;
+            SIMD_INLINE vecf(float x) : v(x) {}
+
+            SIMD_INLINE static vecf load(const float* p, std::size_t = width) { return vecf(*p); }
+            SIMD_INLINE void store(float* p, std::size_t = width) const { *p = v; }
+        };
+
+        SIMD_INLINE vecf operator+(vecf a, vecf b) { return a.v + b.v; }
+        SIMD_INLINE vecf operator-(vecf a, vecf b) { return a.v - b.v; }
+        SIMD_INLINE vecf operator*(vecf a, vecf b) { return a.v * b.v; }
+        SIMD_INLINE vecf operator/(vecf a, vecf b) { return a.v / b.v; }
+        SIMD_INLINE vecf operator-(vecf a) { return -a.v; }
+        SIMD_INLINE vecf fma(vecf a, vecf b, vecf c) { return a.v * b.v + c.v; }
+        SIMD_INLINE vecf abs(vecf a) { return std::fabs(a.v); }
+        SIMD_INLINE vecf sqrt(vecf a) { return std::sqrt(a.v); }
+        SIMD_INLINE vecf min(vecf a, vecf b) { return a.v < b.v ? a.v : b.v; }
+        SIMD_INLINE vecf max(vecf a, vecf b) { return a.v > b.v ? a.v : b.v; }
+        SIMD_INLINE vecf roundNearest(vecf a) { return std::nearbyint(a.v); }
+
+        SIMD_INLINE maskf operator<(vecf a, vecf b) { return {a.v < b.v}; }
+        SIMD_INLINE maskf operator<=(vecf a, vecf b) { return {a.v <= b.v}; }
+        SIMD_INLINE maskf operator>(vecf a, vecf b) { return {a.v > b.v}; }
+        SIMD_INLINE maskf operator>=(vecf a, vecf b) { return {a.v >= b.v}; }
+        SIMD_INLINE maskf operator==(vecf a, vecf b) { return {a.v == b.v}; }
+        SIMD_INLINE maskf operator&(maskf a, maskf b) { return {a.m && b.m}; }
+        SIMD_INLINE maskf operator|(maskf a, maskf b) { return {a.m || b.m}; }
+        SIMD_INLINE maskf operator!(maskf a) { return {!a.m}; }
+        SIMD_INLINE maskf isnan(vecf a) { return {a.v != a.v}; }
+        SIMD_INLINE vecf select(maskf m, vecf a, vecf b) { return m.m ? a : b; }
+        SIMD_INLINE bool any(maskf m) { return m.m; }
+
+        /// @brief 2^n for integral n in [-126, 127].
+        SIMD_INLINE vecf pow2n(vecf n)
+        {
+            return std::bit_cast<float>(static_cast<std::uint32_t>(static_cast<std::int32_t>(n.v) + 127) << 23);
+        }
+
+        /// @brief Unbiased binary exponent of a positive normal number.
+        SIMD_INLINE vecf exponentOf(vecf x)
+        {
+            return static_cast<float>(static_cast<std::int32_t>((std::bit_cast<std::uint32_t>(x.v) >> 23) & 0xff) - 127);
+        }
+
+        /// @brief Significand of a positive normal number, in [1, 2).
+        SIMD_INLINE vecf mantissaOf(vecf x)
+        {
+            return std::bit_cast<float>((std::bit_cast<std::uint32_t>(x.v) & 0x007FFFFFu) | 0x3F800000u);
+        }
+
+        /// @brief One 64-bit unsigned lane, for integer work such as the Philox rounds.
+        struct vecu
+        {
+            static constexpr std::size_t width = 1;
+            std::uint64_t v;
+
+            vecu() = default;
+            SIMD_INLINE vecu(std::uint64_t x) : v(x) {}
+
+            SIMD_INLINE static vecu load(const std::uint64_t* p) { return vecu(*p); }
+        };
+
+        SIMD_INLINE vecu operator+(vecu a, vecu b) { return a.v + b.v; }
+        SIMD_INLINE vecu operator^(vecu a, vecu b) { return a.v ^ b.v; }
+        SIMD_INLINE vecu operator&(vecu a, vecu b) { return a.v & b.v; }
+        SIMD_INLINE vecu operator|(vecu a, vecu b) { return a.v | b.v; }
+        template <int n> SIMD_INLINE vecu shiftLeft(vecu a) { return a.v << n; }
+        template <int n> SIMD_INLINE vecu shiftRight(vecu a) { return a.v >> n; }
+
+        /// @brief The full 64-bit products of the low 32 bits of every lane.
+        SIMD_INLINE vecu mulWide(vecu a, vecu b) { return (a.v & 0xFFFFFFFFu) * (b.v & 0xFFFFFFFFu); }
+
+        /// @brief The doubles with the bits of every lane.
+        SIMD_INLINE vec asDouble(vecu a) { return std::bit_cast<double>(a.v); }
+    }
+
+#if defined(__SSE4_2__)
+    namespace sse42
+    {
+        /// @brief Two-lane SSE4.2 vector; no fused multiply-add, masks are full-width lane masks.
+        struct mask
+        {
+            __m128d m;
+        };
+
+        struct vec
+        {
+            static constexpr std::size_t width = 2;
+            static constexpr bool fusedMultiplyAdd = false;
+            __m128d v;
+
+            vec() = default;
+            SIMD_INLINE vec(__m128d x) : v(x) {}
+            SIMD_INLINE vec(double x) : v(_mm_set1_pd(x)) {}
+
+            /// @brief Loads n <= width lanes; lanes past n are zero.
+            SIMD_INLINE static vec load(const double* p, std::size_t n = width)
+            {
+                return n == width ? _mm_loadu_pd(p) : _mm_load_sd(p);
+            }
+
+            /// @brief Stores the first n <= width lanes.
+            SIMD_INLINE void store(double* p, std::size_t n = width) const
+            {
+                if (n == width)
+                {
+                    _mm_storeu_pd(p, v);
+                }
+                else
+                {
+                    _mm_store_sd(p, v);
+                }
+            }
+        };
+
+        SIMD_INLINE vec operator+(vec a, vec b) { return _mm_add_pd(a.v, b.v); }
+        SIMD_INLINE vec operator-(vec a, vec b) { return _mm_sub_pd(a.v, b.v); }
+        SIMD_INLINE vec operator*(vec a, vec b) { return _mm_mul_pd(a.v, b.v); }
+        SIMD_INLINE vec operator/(vec a, vec b) { return _mm_div_pd(a.v, b.v); }
+        SIMD_INLINE vec operator-(vec a) { return _mm_xor_pd(a.v, _mm_set1_pd(-0.0)); }
+        SIMD_INLINE vec fma(vec a, vec b, vec c) { return _mm_add_pd(_mm_mul_pd(a.v, b.v), c.v); }
+        SIMD_INLINE vec abs(vec a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a.v); }
+        SIMD_INLINE vec sqrt(vec a) { return _mm_sqrt_pd(a.v); }
+        SIMD_INLINE vec min(vec a, vec b) { return _mm_min_pd(a.v, b.v); }
+        SIMD_INLINE vec max(vec a, vec b) { return _mm_max_pd(a.v, b.v); }
+        SIMD_INLINE vec roundNearest(vec a) { return _mm_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        SIMD_INLINE mask operator<(vec a, vec b) { return {_mm_cmplt_pd(a.v, b.v)}; }
+        SIMD_INLINE mask operator<=(vec a, vec b) { return {_mm_cmple_pd(a.v, b.v)}; }
+        SIMD_INLINE mask operator>(vec a, vec b) { return {_mm_cmpgt_pd(a.v, b.v)}; }
+        SIMD_INLINE mask operator>=(vec a, vec b) { return {_mm_cmpge_pd(a.v, b.v)}; }
+        SIMD_INLINE mask operator==(vec a, vec b) { return {_mm_cmpeq_pd(a.v, b.v)}; }
+        SIMD_INLINE mask operator&(mask a, mask b) { return {_mm_and_pd(a.m, b.m)}; }
+        SIMD_INLINE mask operator|(mask a, mask b) { return {_mm_or_pd(a.m, b.m)}; }
+        SIMD_INLINE mask operator!(mask a) { return {_mm_xor_pd(a.m, _mm_castsi128_pd(_mm_set1_epi64x(-1)))}; }
+        SIMD_INLINE mask isnan(vec a) { return {_mm_cmpunord_pd(a.v, a.v)}; }
+        SIMD_INLINE vec select(mask m, vec a, vec b) { return _mm_blendv_pd(b.v, a.v, m.m); }
+        SIMD_INLINE bool any(mask m) { return _mm_movemask_pd(m.m) != 0; }
+
+        // No gather instruction before AVX2: two scalar loads.
+        SIMD_INLINE vec gather(const double* base, vec index)
+        {
+            const __m128i i = _mm_cvttpd_epi32(index.v);
+            return _mm_set_pd(base[_mm_extract_epi32(i, 1)], base[_mm_cvtsi128_si32(i)]);
+        }
+
+        /// @brief 2^n for integral n in [-1022, 1023].
+        SIMD_INLINE vec pow2n(vec n)
+        {
+            const __m128d biased = _mm_add_pd(n.v, _mm_set1_pd(0x1.0p52 + 1023.0));
+            return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(biased), 52));
+        }
+
+        /// @brief Unbiased binary exponent of a positive normal number.
+        SIMD_INLINE vec exponentOf(vec x)
+        {
+            const __m128i biased = _mm_srli_epi64(_mm_castpd_si128(x.v), 52);
+            const __m128d asDouble = _mm_castsi128_pd(_mm_or_si128(biased, _mm_castpd_si128(_mm_set1_pd(0x1.0p52))));
+            return _mm_sub_pd(asDouble, _mm_set1_pd(0x1.0p52 + 1023.0));
+        }
+
+        /// @brief Significand of a positive normal number, in [1, 2).
+        SIMD_INLINE vec mantissaOf(vec x)
+        {
+            const __m128i bits = _mm_and_si128(_mm_castpd_si128(x.v), _mm_set1_epi64x(0x000FFFFFFFFFFFFFll));
+            return _mm_castsi128_pd(_mm_or_si128(bits, _mm_set1_epi64x(0x3FF0000000000000ll)));
+        }
+
+        /// @brief Four-lane SSE4.2 float vector.
+        struct maskf
+        {
+            __m128 m;
+        };
+
+        struct vecf
+        {
+            static constexpr std::size_t width = 4;
+            __m128 v;
+
+            vecf() = default;
+            SIMD_INLINE vecf(__m128 x) : v(x) {}
+            SIMD_INLINE vecf(float x) : v(_mm_set1_ps(x)) {}
+
+            /// @brief Loads n <= width lanes; lanes past n are zero.
+            SIMD_INLINE static vecf load(const float* p, std::size_t n = width)
+            {
+                if (n == width)
+                {
+                    return _mm_loadu_ps(p);
+                }
+                alignas(16) float lanes[width] = {};
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    lanes[i] = p[i];
+                }
+                return _mm_load_ps(lanes);
+            }
+
+            /// @brief Stores the first n <= width lanes.
+            SIMD_INLINE void store(float* p, std::size_t n = width) const
+            {
+                if (n == width)
+                {
+                    _mm_storeu_ps(p, v);
+                    return;
+                }
+                alignas(16) float lanes[width];
+                _mm_store_ps(lanes, v);
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    p[i] = lanes[i];
+                }
+            }
+        };
+
+        SIMD_INLINE vecf operator+(vecf a, vecf b) { return _mm_add_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator-(vecf a, vecf b) { return _mm_sub_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator*(vecf a, vecf b) { return _mm_mul_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator/(vecf a, vecf b) { return _mm_div_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator-(vecf a) { return _mm_xor_ps(a.v, _mm_set1_ps(-0.0f)); }
+        SIMD_INLINE vecf fma(vecf a, vecf b, vecf c) { return _mm_add_ps(_mm_mul_ps(a.v, b.v), c.v); }
+        SIMD_INLINE vecf abs(vecf a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a.v); }
+        SIMD_INLINE vecf sqrt(vecf a) { return _mm_sqrt_ps(a.v); }
+        SIMD_INLINE vecf min(vecf a, vecf b) { return _mm_min_ps(a.v, b.v); }
+        SIMD_INLINE vecf max(vecf a, vecf b) { return _mm_max_ps(a.v, b.v); }
+        SIMD_INLINE vecf roundNearest(vecf a) { return _mm_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        SIMD_INLINE maskf operator<(vecf a, vecf b) { return {_mm_cmplt_ps(a.v, b.v)}; }
+        SIMD_INLINE maskf operator<=(vecf a, vecf b) { return {_mm_cmple_ps(a.v, b.v)}; }
+        SIMD_INLINE maskf operator>(vecf a, vecf b) { return {_mm_cmpgt_ps(a.v, b.v)}; }
+        SIMD_INLINE maskf operator>=(vecf a, vecf b) { return {_mm_cmpge_ps(a.v, b.v)}; }
+        SIMD_INLINE maskf operator==(vecf a, vecf b) { return {_mm_cmpeq_ps(a.v, b.v)}; }
+        SIMD_INLINE maskf operator&(maskf a, maskf b) { return {_mm_and_ps(a.m, b.m)}; }
+        SIMD_INLINE maskf operator|(maskf a, maskf b) { return {_mm_or_ps(a.m, b.m)}; }
+        SIMD_INLINE maskf operator!(maskf a) { return {_mm_xor_ps(a.m, _mm_castsi128_ps(_mm_set1_epi32(-1)))}; }
+        SIMD_INLINE maskf isnan(vecf a) { return {_mm_cmpunord_ps(a.v, a.v)}; }
+        SIMD_INLINE vecf select(maskf m, vecf a, vecf b) { return _mm_blendv_ps(b.v, a.v, m.m); }
+        SIMD_INLINE bool any(maskf m) { return _mm_movemask_ps(m.m) != 0; }
+
+        /// @brief 2^n for integral n in [-126, 127].
+        SIMD_INLINE vecf pow2n(vecf n)
+        {
+            const __m128 biased = _mm_add_ps(n.v, _mm_set1_ps(0x1.0p23f + 127.0f));
+            return _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(biased), 23));
+        }
+
+        /// @brief Unbiased binary exponent of a positive normal number.
+        SIMD_INLINE vecf exponentOf(vecf x)
+        {
+            const __m128i biased = _mm_srli_epi32(_mm_castps_si128(x.v), 23);
+            const __m128 asFloat = _mm_castsi128_ps(_mm_or_si128(biased, _mm_castps_si128(_mm_set1_ps(0x1.0p23f))));
+            return _mm_sub_ps(asFloat, _mm_set1_ps(0x1.0p23f + 127.0f));
+        }
+
+        /// @brief Significand of a positive normal number, in [1, 2).
+        SIMD_INLINE vecf mantissaOf(vecf x)
+        {
+            const __m128i bits = _mm_and_si128(_mm_castps_si128(x.v), _mm_set1_epi32(0x007FFFFF));
+            return _mm_castsi128_ps(_mm_or_si128(bits, _mm_set1_epi32(0x3F800000)));
+        }
+
+        /// @brief Two 64-bit unsigned lanes, one per lane of vec, for integer work such as the Philox rounds.
+        struct vecu
+        {
+            static constexpr std::size_t width = 2;
+            __m128i v;
+
+            vecu() = default;
+            SIMD_INLINE vecu(__m128i x) : v(x) {}
+            SIMD_INLINE vecu(std::uint64_t x) : v(_mm_set1_epi64x(static_cast<long long>(x))) {}
+
+            SIMD_INLINE static vecu load(const std::uint64_t* p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+        };
+
+        SIMD_INLINE vecu operator+(vecu a, vecu b) { return _mm_add_epi64(a.v, b.v); }
+        SIMD_INLINE vecu operator^(vecu a, vecu b) { return _mm_xor_si128(a.v, b.v); }
+        SIMD_INLINE vecu operator&(vecu a, vecu b) { return _mm_and_si128(a.v, b.v); }
+        SIMD_INLINE vecu operator|(vecu a, vecu b) { return _mm_or_si128(a.v, b.v); }
+        template <int n> SIMD_INLINE vecu shiftLeft(vecu a) { return _mm_slli_epi64(a.v, n); }
+        template <int n> SIMD_INLINE vecu shiftRight(vecu a) { return _mm_srli_epi64(a.v, n); }
+
+        /// @brief The full 64-bit products of the low 32 bits of every lane.
+        SIMD_INLINE vecu mulWide(vecu a, vecu b) { return _mm_mul_epu32(a.v, b.v); }
+
+        /// @brief The doubles with the bits of every lane.
+        SIMD_INLINE vec asDouble(vecu a) { return _mm_castsi128_pd(a.v); }
+    }
+#endif
+
+#if defined(__AVX2__) && defined(__FMA__)
+    namespace avx2
+    {
+        /// @brief Four-lane AVX2 vector; masks are full-width lane masks.
+        struct mask
+        {
+            __m256d m;
+        };
+
+        struct vec
+        {
+            static constexpr std::size_t width = 4;
+            static constexpr bool fusedMultiplyAdd = true;
+            __m256d v;
+
+            vec() = default;
+            SIMD_INLINE vec(__m256d x) : v(x) {}
+            SIMD_INLINE vec(double x) : v(_mm256_set1_pd(x)) {}
+
+            SIMD_INLINE static __m256i tailMask(std::size_t n)
+            {
+                return _mm256_cmpgt_epi64(_mm256_set1_epi64x(static_cast<long long>(n)), _mm256_setr_epi64x(0, 1, 2, 3));
+            }
+
+            /// @brief Loads n <= width lanes; lanes past n are zero.
+            SIMD_INLINE static vec load(const double* p, std::size_t n = width)
+            {
+                return n == width ? _mm256_loadu_pd(p) : _mm256_maskload_pd(p, tailMask(n));
+            }
+
+            /// @brief Stores the first n <= width lanes.
+            SIMD_INLINE void store(double* p, std::size_t n = width) const
+            {
+                if (n == width)
+                {
+                    _mm256_storeu_pd(p, v);
+                }
+                else
+                {
+                    _mm256_maskstore_pd(p, tailMask(n), v);
+                }
+            }
+        };
+
+        SIMD_INLINE vec operator+(vec a, vec b) { return _mm256_add_pd(a.v, b.v); }
+        SIMD_INLINE vec operator-(vec a, vec b) { return _mm256_sub_pd(a.v, b.v); }
+        SIMD_INLINE vec operator*(vec a, vec b) { return _mm256_mul_pd(a.v, b.v); }
+        SIMD_INLINE vec operator/(vec a, vec b) { return _mm256_div_pd(a.v, b.v); }
+        SIMD_INLINE vec operator-(vec a) { return _mm256_xor_pd(a.v, _mm256_set1_pd(-0.0)); }
+        SIMD_INLINE vec fma(vec a, vec b, vec c) { return _mm256_fmadd_pd(a.v, b.v, c.v); }
+        SIMD_INLINE vec abs(vec a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a.v); }
+        SIMD_INLINE vec sqrt(vec a) { return _mm256_sqrt_pd(a.v); }
+        SIMD_INLINE vec min(vec a, vec b) { return _mm256_min_pd(a.v, b.v); }
+        SIMD_INLINE vec max(vec a, vec b) { return _mm256_max_pd(a.v, b.v); }
+        SIMD_INLINE vec roundNearest(vec a) { return _mm256_round_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        SIMD_INLINE mask operator<(vec a, vec b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LT_OQ)}; }
+        SIMD_INLINE mask operator<=(vec a, vec b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_LE_OQ)}; }
+        SIMD_INLINE mask operator>(vec a, vec b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_GT_OQ)}; }
+        SIMD_INLINE mask operator>=(vec a, vec b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_GE_OQ)}; }
+        SIMD_INLINE mask operator==(vec a, vec b) { return {_mm256_cmp_pd(a.v, b.v, _CMP_EQ_OQ)}; }
+        SIMD_INLINE mask operator&(mask a, mask b) { return {_mm256_and_pd(a.m, b.m)}; }
+        SIMD_INLINE mask operator|(mask a, mask b) { return {_mm256_or_pd(a.m, b.m)}; }
+        SIMD_INLINE mask operator!(mask a) { return {_mm256_xor_pd(a.m, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)))}; }
+        SIMD_INLINE mask isnan(vec a) { return {_mm256_cmp_pd(a.v, a.v, _CMP_UNORD_Q)}; }
+        SIMD_INLINE vec select(mask m, vec a, vec b) { return _mm256_blendv_pd(b.v, a.v, m.m); }
+        SIMD_INLINE bool any(mask m) { return _mm256_movemask_pd(m.m) != 0; }
+
+        SIMD_INLINE vec gather(const double* base, vec index)
+        {
+            return _mm256_i32gather_pd(base, _mm256_cvttpd_epi32(index.v), 8);
+        }
+
+        /// @brief 2^n for integral n in [-1022, 1023].
+        SIMD_INLINE vec pow2n(vec n)
+        {
+            const __m256d biased = _mm256_add_pd(n.v, _mm256_set1_pd(0x1.0p52 + 1023.0));
+            return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(biased), 52));
+        }
+
+        /// @brief Unbiased binary exponent of a positive normal number.
+        SIMD_INLINE vec exponentOf(vec x)
+        {
+            const __m256i biased = _mm256_srli_epi64(_mm256_castpd_si256(x.v), 52);
+            const __m256d asDouble = _mm256_castsi256_pd(_mm256_or_si256(biased, _mm256_castpd_si256(_mm256_set1_pd(0x1.0p52))));
+            return _mm256_sub_pd(asDouble, _mm256_set1_pd(0x1.0p52 + 1023.0));
+        }
+
+        /// @brief Significand of a positive normal number, in [1, 2).
+        SIMD_INLINE vec mantissaOf(vec x)
+        {
+            const __m256i bits = _mm256_and_si256(_mm256_castpd_si256(x.v), _mm256_set1_epi64x(0x000FFFFFFFFFFFFFll));
+            return _mm256_castsi256_pd(_mm256_or_si256(bits, _mm256_set1_epi64x(0x3FF0000000000000ll)));
+        }
+
+        /// @brief Eight-lane AVX2 float vector.
+        struct maskf
+        {
+            __m256 m;
+        };
+
+        struct vecf
+        {
+            static constexpr std::size_t width = 8;
+            __m256 v;
+
+            vecf() = default;
+            SIMD_INLINE vecf(__m256 x) : v(x) {}
+            SIMD_INLINE vecf(float x) : v(_mm256_set1_ps(x)) {}
+
+            SIMD_INLINE static __m256i tailMask(std::size_t n)
+            {
+                return _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(n)), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+            }
+
+            /// @brief Loads n <= width lanes; lanes past n are zero.
+            SIMD_INLINE static vecf load(const float* p, std::size_t n = width)
+            {
+                return n == width ? _mm256_loadu_ps(p) : _mm256_maskload_ps(p, tailMask(n));
+            }
+
+            /// @brief Stores the first n <= width lanes.
+            SIMD_INLINE void store(float* p, std::size_t n = width) const
+            {
+                if (n == width)
+                {
+                    _mm256_storeu_ps(p, v);
+                }
+                else
+                {
+                    _mm256_maskstore_ps(p, tailMask(n), v);
+                }
+            }
+        };
+
+        SIMD_INLINE vecf operator+(vecf a, vecf b) { return _mm256_add_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator-(vecf a, vecf b) { return _mm256_sub_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator*(vecf a, vecf b) { return _mm256_mul_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator/(vecf a, vecf b) { return _mm256_div_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator-(vecf a) { return _mm256_xor_ps(a.v, _mm256_set1_ps(-0.0f)); }
+        SIMD_INLINE vecf fma(vecf a, vecf b, vecf c) { return _mm256_fmadd_ps(a.v, b.v, c.v); }
+        SIMD_INLINE vecf abs(vecf a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.v); }
+        SIMD_INLINE vecf sqrt(vecf a) { return _mm256_sqrt_ps(a.v); }
+        SIMD_INLINE vecf min(vecf a, vecf b) { return _mm256_min_ps(a.v, b.v); }
+        SIMD_INLINE vecf max(vecf a, vecf b) { return _mm256_max_ps(a.v, b.v); }
+        SIMD_INLINE vecf roundNearest(vecf a) { return _mm256_round_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        SIMD_INLINE maskf operator<(vecf a, vecf b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ)}; }
+        SIMD_INLINE maskf operator<=(vecf a, vecf b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_LE_OQ)}; }
+        SIMD_INLINE maskf operator>(vecf a, vecf b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GT_OQ)}; }
+        SIMD_INLINE maskf operator>=(vecf a, vecf b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_GE_OQ)}; }
+        SIMD_INLINE maskf operator==(vecf a, vecf b) { return {_mm256_cmp_ps(a.v, b.v, _CMP_EQ_OQ)}; }
+        SIMD_INLINE maskf operator&(maskf a, maskf b) { return {_mm256_and_ps(a.m, b.m)}; }
+        SIMD_INLINE maskf operator|(maskf a, maskf b) { return {_mm256_or_ps(a.m, b.m)}; }
+        SIMD_INLINE maskf operator!(maskf a) { return {_mm256_xor_ps(a.m, _mm256_castsi256_ps(_mm256_set1_epi32(-1)))}; }
+        SIMD_INLINE maskf isnan(vecf a) { return {_mm256_cmp_ps(a.v, a.v, _CMP_UNORD_Q)}; }
+        SIMD_INLINE vecf select(maskf m, vecf a, vecf b) { return _mm256_blendv_ps(b.v, a.v, m.m); }
+        SIMD_INLINE bool any(maskf m) { return _mm256_movemask_ps(m.m) != 0; }
+
+        /// @brief 2^n for integral n in [-126, 127].
+        SIMD_INLINE vecf pow2n(vecf n)
+        {
+            const __m256 biased = _mm256_add_ps(n.v, _mm256_set1_ps(0x1.0p23f + 127.0f));
+            return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_castps_si256(biased), 23));
+        }
+
+        /// @brief Unbiased binary exponent of a positive normal number.
+        SIMD_INLINE vecf exponentOf(vecf x)
+        {
+            const __m256i biased = _mm256_srli_epi32(_mm256_castps_si256(x.v), 23);
+            const __m256 asFloat = _mm256_castsi256_ps(_mm256_or_si256(biased, _mm256_castps_si256(_mm256_set1_ps(0x1.0p23f))));
+            return _mm256_sub_ps(asFloat, _mm256_set1_ps(0x1.0p23f + 127.0f));
+        }
+
+        /// @brief Significand of a positive normal number, in [1, 2).
+        SIMD_INLINE vecf mantissaOf(vecf x)
+        {
+            const __m256i bits = _mm256_and_si256(_mm256_castps_si256(x.v), _mm256_set1_epi32(0x007FFFFF));
+            return _mm256_castsi256_ps(_mm256_or_si256(bits, _mm256_set1_epi32(0x3F800000)));
+        }
+
+        /// @brief Four 64-bit unsigned lanes, one per lane of vec, for integer work such as the Philox rounds.
+        struct vecu
+        {
+            static constexpr std::size_t width = 4;
+            __m256i v;
+
+            vecu() = default;
+            SIMD_INLINE vecu(__m256i x) : v(x) {}
+            SIMD_INLINE vecu(std::uint64_t x) : v(_mm256_set1_epi64x(static_cast<long long>(x))) {}
+
+            SIMD_INLINE static vecu load(const std::uint64_t* p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+        };
+
+        SIMD_INLINE vecu operator+(vecu a, vecu b) { return _mm256_add_epi64(a.v, b.v); }
+        SIMD_INLINE vecu operator^(vecu a, vecu b) { return _mm256_xor_si256(a.v, b.v); }
+        SIMD_INLINE vecu operator&(vecu a, vecu b) { return _mm256_and_si256(a.v, b.v); }
+        SIMD_INLINE vecu operator|(vecu a, vecu b) { return _mm256_or_si256(a.v, b.v); }
+        template <int n> SIMD_INLINE vecu shiftLeft(vecu a) { return _mm256_slli_epi64(a.v, n); }
+        template <int n> SIMD_INLINE vecu shiftRight(vecu a) { return _mm256_srli_epi64(a.v, n); }
+
+        /// @brief The full 64-bit products of the low 32 bits of every lane.
+        SIMD_INLINE vecu mulWide(vecu a, vecu b) { return _mm256_mul_epu32(a.v, b.v); }
+
+        /// @brief The doubles with the bits of every lane.
+        SIMD_INLINE vec asDouble(vecu a) { return _mm256_castsi256_pd(a.v); }
+    }
+#endif
+
+#if defined(__AVX512F__)
+    namespace avx512
+    {
+        /// @brief Eight-lane AVX-512 vector; masks are k-registers.
+        struct mask
+        {
+            __mmask8 m;
+        };
+
+        struct vec
+        {
+            static constexpr std::size_t width = 8;
+            static constexpr bool fusedMultiplyAdd = true;
+            __m512d v;
+
+            vec() = default;
+            SIMD_INLINE vec(__m512d x) : v(x) {}
+            SIMD_INLINE vec(double x) : v(_mm512_set1_pd(x)) {}
+
+            SIMD_INLINE static __mmask8 tailMask(std::size_t n) { return static_cast<__mmask8>((1u << n) - 1u); }
+
+            /// @brief Loads n <= width lanes; lanes past n are zero.
+            SIMD_INLINE static vec load(const double* p, std::size_t n = width)
+            {
+                return n == width ? _mm512_loadu_pd(p) : _mm512_maskz_loadu_pd(tailMask(n), p);
+            }
+
+            /// @brief Stores the first n <= width lanes.
+            SIMD_INLINE void store(double* p, std::size_t n = width) const
+            {
+                if (n == width)
+                {
+                    _mm512_storeu_pd(p, v);
+                }
+                else
+                {
+                    _mm512_mask_storeu_pd(p, tailMask(n), v);
+                }
+            }
+        };
+
+        SIMD_INLINE vec operator+(vec a, vec b) { return _mm512_add_pd(a.v, b.v); }
+        SIMD_INLINE vec operator-(vec a, vec b) { return _mm512_sub_pd(a.v, b.v); }
+        SIMD_INLINE vec operator*(vec a, vec b) { return _mm512_mul_pd(a.v, b.v); }
+        SIMD_INLINE vec operator/(vec a, vec b) { return _mm512_div_pd(a.v, b.v); }
+        SIMD_INLINE vec operator-(vec a)
+        {
+            return _mm512_castsi512_pd(_mm512_xor_si512(_mm512_castpd_si512(a.v), _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull))));
+        }
+        SIMD_INLINE vec fma(vec a, vec b, vec c) { return _mm512_fmadd_pd(a.v, b.v, c.v); }
+        SIMD_INLINE vec abs(vec a) { return _mm512_abs_pd(a.v); }
+        SIMD_INLINE vec sqrt(vec a) { return _mm512_sqrt_pd(a.v); }
+        SIMD_INLINE vec min(vec a, vec b) { return _mm512_min_pd(a.v, b.v); }
+        SIMD_INLINE vec max(vec a, vec b) { return _mm512_max_pd(a.v, b.v); }
+        SIMD_INLINE vec roundNearest(vec a) { return _mm512_roundscale_pd(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        SIMD_INLINE mask operator<(vec a, vec b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_LT_OQ)}; }
+        SIMD_INLINE mask operator<=(vec a, vec b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_LE_OQ)}; }
+        SIMD_INLINE mask operator>(vec a, vec b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_GT_OQ)}; }
+        SIMD_INLINE mask operator>=(vec a, vec b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_GE_OQ)}; }
+        SIMD_INLINE mask operator==(vec a, vec b) { return {_mm512_cmp_pd_mask(a.v, b.v, _CMP_EQ_OQ)}; }
+        SIMD_INLINE mask operator&(mask a, mask b) { return {static_cast<__mmask8>(a.m & b.m)}; }
+        SIMD_INLINE mask operator|(mask a, mask b) { return {static_cast<__mmask8>(a.m | b.m)}; }
+        SIMD_INLINE mask operator!(mask a) { return {static_cast<__mmask8>(~a.m)}; }
+        SIMD_INLINE mask isnan(vec a) { return {_mm512_cmp_pd_mask(a.v, a.v, _CMP_UNORD_Q)}; }
+        SIMD_INLINE vec select(mask m, vec a, vec b) { return _mm512_mask_blend_pd(m.m, b.v, a.v); }
+        SIMD_INLINE bool any(mask m) { return m.m != 0; }
+
+        SIMD_INLINE vec gather(const double* base, vec index)
+        {
+            return _mm512_i32gather_pd(_mm512_cvttpd_epi32(index.v), base, 8);
+        }
+
+        /// @brief 2^n for integral n in [-1022, 1023].
+        SIMD_INLINE vec pow2n(vec n)
+        {
+            const __m512d biased = _mm512_add_pd(n.v, _mm512_set1_pd(0x1.0p52 + 1023.0));
+            return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_castpd_si512(biased), 52));
+        }
+
+        /// @brief Unbiased binary exponent of a positive normal number.
+        SIMD_INLINE vec exponentOf(vec x)
+        {
+            const __m512i biased = _mm512_srli_epi64(_mm512_castpd_si512(x.v), 52);
+            const __m512d asDouble = _mm512_castsi512_pd(_mm512_or_si512(biased, _mm512_castpd_si512(_mm512_set1_pd(0x1.0p52))));
+            return _mm512_sub_pd(asDouble, _mm512_set1_pd(0x1.0p52 + 1023.0));
+        }
+
+        /// @brief Significand of a positive normal number, in [1, 2).
+        SIMD_INLINE vec mantissaOf(vec x)
+        {
+            const __m512i bits = _mm512_and_si512(_mm512_castpd_si512(x.v), _mm512_set1_epi64(0x000FFFFFFFFFFFFFll));
+            return _mm512_castsi512_pd(_mm512_or_si512(bits, _mm512_set1_epi64(0x3FF0000000000000ll)));
+        }
+
+        /// @brief Sixteen-lane AVX-512 float vector.
+        struct maskf
+        {
+            __mmask16 m;
+        };
+
+        struct vecf
+        {
+            static constexpr std::size_t width = 16;
+            __m512 v;
+
+            vecf() = default;
+            SIMD_INLINE vecf(__m512 x) : v(x) {}
+            SIMD_INLINE vecf(float x) : v(_mm512_set1_ps(x)) {}
+
+            SIMD_INLINE static __mmask16 tailMask(std::size_t n) { return static_cast<__mmask16>((1u << n) - 1u); }
+
+            /// @brief Loads n <= width lanes; lanes past n are zero.
+            SIMD_INLINE static vecf load(const float* p, std::size_t n = width)
+            {
+                return n == width ? _mm512_loadu_ps(p) : _mm512_maskz_loadu_ps(tailMask(n), p);
+            }
+
+            /// @brief Stores the first n <= width lanes.
+            SIMD_INLINE void store(float* p, std::size_t n = width) const
+            {
+                if (n == width)
+                {
+                    _mm512_storeu_ps(p, v);
+                }
+                else
+                {
+                    _mm512_mask_storeu_ps(p, tailMask(n), v);
+                }
+            }
+        };
+
+        SIMD_INLINE vecf operator+(vecf a, vecf b) { return _mm512_add_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator-(vecf a, vecf b) { return _mm512_sub_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator*(vecf a, vecf b) { return _mm512_mul_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator/(vecf a, vecf b) { return _mm512_div_ps(a.v, b.v); }
+        SIMD_INLINE vecf operator-(vecf a)
+        {
+            return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a.v), _mm512_set1_epi32(static_cast<int>(0x80000000u))));
+        }
+        SIMD_INLINE vecf fma(vecf a, vecf b, vecf c) { return _mm512_fmadd_ps(a.v, b.v, c.v); }
+        SIMD_INLINE vecf abs(vecf a) { return _mm512_abs_ps(a.v); }
+        SIMD_INLINE vecf sqrt(vecf a) { return _mm512_sqrt_ps(a.v); }
+        SIMD_INLINE vecf min(vecf a, vecf b) { return _mm512_min_ps(a.v, b.v); }
+        SIMD_INLINE vecf max(vecf a, vecf b) { return _mm512_max_ps(a.v, b.v); }
+        SIMD_INLINE vecf roundNearest(vecf a) { return _mm512_roundscale_ps(a.v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+
+        SIMD_INLINE maskf operator<(vecf a, vecf b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LT_OQ)}; }
+        SIMD_INLINE maskf operator<=(vecf a, vecf b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_LE_OQ)}; }
+        SIMD_INLINE maskf operator>(vecf a, vecf b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GT_OQ)}; }
+        SIMD_INLINE maskf operator>=(vecf a, vecf b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_GE_OQ)}; }
+        SIMD_INLINE maskf operator==(vecf a, vecf b) { return {_mm512_cmp_ps_mask(a.v, b.v, _CMP_EQ_OQ)}; }
+        SIMD_INLINE maskf operator&(maskf a, maskf b) { return {static_cast<__mmask16>(a.m & b.m)}; }
+        SIMD_INLINE maskf operator|(maskf a, maskf b) { return {static_cast<__mmask16>(a.m | b.m)}; }
+        SIMD_INLINE maskf operator!(maskf a) { return {static_cast<__mmask16>(~a.m)}; }
+        SIMD_INLINE maskf isnan(vecf a) { return {_mm512_cmp_ps_mask(a.v, a.v, _CMP_UNORD_Q)}; }
+        SIMD_INLINE vecf select(maskf m, vecf a, vecf b) { return _mm512_mask_blend_ps(m.m, b.v, a.v); }
+        SIMD_INLINE bool any(maskf m) { return m.m != 0; }
+
+        /// @brief 2^n for integral n in [-126, 127].
+        SIMD_INLINE vecf pow2n(vecf n)
+        {
+            const __m512 biased = _mm512_add_ps(n.v, _mm512_set1_ps(0x1.0p23f + 127.0f));
+            return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_castps_si512(biased), 23));
+        }
+
+        /// @brief Unbiased binary exponent of a positive normal number.
+        SIMD_INLINE vecf exponentOf(vecf x)
+        {
+            const __m512i biased = _mm512_srli_epi32(_mm512_castps_si512(x.v), 23);
+            const __m512 asFloat = _mm512_castsi512_ps(_mm512_or_si512(biased, _mm512_castps_si512(_mm512_set1_ps(0x1.0p23f))));
+            return _mm512_sub_ps(asFloat, _mm512_set1_ps(0x1.0p23f + 127.0f));
+        }
+
+        /// @brief Significand of a positive normal number, in [1, 2).
+        SIMD_INLINE vecf mantissaOf(vecf x)
+        {
+            const __m512i bits = _mm512_and_si512(_mm512_castps_si512(x.v), _mm512_set1_epi32(0x007FFFFF));
+            return _mm512_castsi512_ps(_mm512_or_si512(bits, _mm512_set1_epi32(0x3F800000)));
+        }
+
+        /// @brief Eight 64-bit unsigned lanes, one per lane of vec, for integer work such as the Philox rounds.
+        struct vecu
+        {
+            static constexpr std::size_t width = 8;
+            __m512i v;
+
+            vecu() = default;
+            SIMD_INLINE vecu(__m512i x) : v(x) {}
+            SIMD_INLINE vecu(std::uint64_t x) : v(_mm512_set1_epi64(static_cast<long long>(x))) {}
+
+            SIMD_INLINE static vecu load(const std::uint64_t* p) { return _mm512_loadu_si512(p); }
+        };
+
+        SIMD_INLINE vecu operator+(vecu a, vecu b) { return _mm512_add_epi64(a.v, b.v); }
+        SIMD_INLINE vecu operator^(vecu a, vecu b) { return _mm512_xor_si512(a.v, b.v); }
+        SIMD_INLINE vecu operator&(vecu a, vecu b) { return _mm512_and_si512(a.v, b.v); }
+        SIMD_INLINE vecu operator|(vecu a, vecu b) { return _mm512_or_si512(a.v, b.v); }
+        template <int n> SIMD_INLINE vecu shiftLeft(vecu a) { return _mm512_slli_epi64(a.v, n); }
+        template <int n> SIMD_INLINE vecu shiftRight(vecu a) { return _mm512_srli_epi64(a.v, n); }
+
+        /// @brief The full 64-bit products of the low 32 bits of every lane.
+        SIMD_INLINE vecu mulWide(vecu a, vecu b) { return _mm512_mul_epu32(a.v, b.v); }
+
+        /// @brief The doubles with the bits of every lane.
+        SIMD_INLINE vec asDouble(vecu a) { return _mm512_castsi512_pd(a.v); }
+    }
+#endif
+}
+
+#endif // SIMDVECTOR_H
@@ -0,0 +1,520 @@
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+#include "../include/batchPricing.h"
+#include "../include/cpuDispatch.h"
+#include "../include/ErrorHandler.h"
+
+namespace
+{
+    // Runs of one option type shorter than this go to the mixed kernel: below a few vector blocks the
+    // extra kernel calls cost more than multiplying by a per-option sign.
+    const std::size_t minTypedRun = 64;
+
+    /// @brief splits [0, count) into runs of one option type. Runs of at least minTypedRun calls or puts
+    ///        go to typed(type, first, n); everything in between goes to mixed(first, n).
+    template <class Mixed, class Typed>
+    void forEachOptionTypeRun(std::size_t count, const OptionType* optionType, Mixed&& mixed, Typed&& typed)
+    {
+        std::size_t mixedStart = 0;
+        std::size_t i = 0;
+        while (i < count)
+        {
+            std::size_t end = i + 1;
+            while (end < count && optionType[end] == optionType[i])
+            {
+                ++end;
+            }
+
+            if (end - i >= minTypedRun && (optionType[i] == CALL || optionType[i] == PUT))
+            {
+                if (mixedStart < i)
+                {
+                    mixed(mixedStart, i - mixedStart);
+                }
+                typed(optionType[i], i, end - i);
+                mixedStart = end;
+            }
+            i = end;
+        }
+
+        if (mixedStart < count)
+        {
+            mixed(mixedStart, count - mixedStart);
+        }
+    }
+
+    /// @brief sets the outputs of every invalid option to NaN. Written as a select so the loop vectorizes.
+    void markInvalid(const batchStatus& status, std::vector<double>& values)
+    {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        for (std::size_t i = 0; i < status.size(); ++i)
+        {
+            values[i] = status.status[i] != OPTION_VALID ? nan : values[i];
+        }
+    }
+
+    /// @brief logs one line for the batch if any of its options is invalid.
+    void logBatchStatus(const char* function, const batchStatus& status)
+    {
+        if (status.invalidCount != 0)
+        {
+            ErrorHandler::logError("Error in " + std::string(function) + ": " + describeBatchStatus(status));
+        }
+    }
+}
+
+/// @brief resizes every column of the batch.
+/// @param count
+void optionBatch::resize(std::size_t count)
+{
+    underlyingPrice.resize(count);
+    strikePrice.resize(count);
+    timeToExperation.resize(count);
+    riskFreeRate.resize(count);
+    volatility.resize(count);
+    optionType.resize(count);
+}
+
+/// @brief resizes every column of the batch.
+/// @param count
+void optionBatchFloat::resize(std::size_t count)
+{
+    underlyingPrice.resize(count);
+    strikePrice.resize(count);
+    timeToExperation.resize(count);
+    riskFreeRate.resize(count);
+    volatility.resize(count);
+    optionType.resize(count);
+}
+
+/// @brief resizes every column of the batch.
+/// @param count
+void greeksBatch::resize(std::size_t count)
+{
+    price.resize(count);
+    delta.resize(count);
+    gamma.resize(count);
+    vega.resize(count);
+    theta.resize(count);
+    rho.resize(count);
+}
+
+/// @brief sizes the selected columns and empties the others.
+/// @param count
+/// @param selected
+void selectedGreeksBatch::resize(std::size_t count, unsigned selected)
+{
+    greeks = selected;
+    for (unsigned b = 0; b < GREEK_COUNT; ++b)
+    {
+        if ((selected & (1u << b)) != 0)
+        {
+            columns[b].resize(count);
+        }
+        else
+        {
+            columns[b].clear();
+        }
+    }
+}
+
+/// @brief reorders the batch so all calls come first, keeping the relative order within each type.
+/// @param batch
+/// @param originalIndex
+/// @return the number of calls.
+std::size_t partitionByOptionType(optionBatch& batch, std::vector<std::size_t>& originalIndex)
+{
+    originalIndex.resize(batch.size());
+    std::iota(originalIndex.begin(), originalIndex.end(), std::size_t{0});
+    auto firstPut = std::stable_partition(originalIndex.begin(), originalIndex.end(),
+                                          [&](std::size_t i) { return batch.optionType[i] == CALL; });
+
+    optionBatch sorted;
+    sorted.resize(batch.size());
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        const std::size_t from = originalIndex[i];
+        sorted.underlyingPrice[i] = batch.underlyingPrice[from];
+        sorted.strikePrice[i] = batch.strikePrice[from];
+        sorted.timeToExperation[i] = batch.timeToExperation[from];
+        sorted.riskFreeRate[i] = batch.riskFreeRate[from];
+        sorted.volatility[i] = batch.volatility[from];
+        sorted.optionType[i] = batch.optionType[from];
+    }
+    batch = std::move(sorted);
+
+    return static_cast<std::size_t>(firstPut - originalIndex.begin());
+}
+
+/// @brief prices count options stored as structure-of-arrays with the Black-Scholes formula,
+///        using the vectorized kernels selected by cpuDispatch. Long runs of calls or puts use the
+///        kernels specialized on the option type.
+/// @param count
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param volatility
+/// @param optionType
+/// @param optionPrice
+/// @param cdfMethod
+void blackScholesBatchPrice(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                            const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                            const OptionType* optionType, double* optionPrice, NormalCDFMethod cdfMethod)
+{
+    const simdKernelTable& kernels = simdKernels();
+    const bool tabulated = cdfMethod == CDF_TABLE;
+    const auto mixedKernel = tabulated ? kernels.blackScholesPriceTabulated : kernels.blackScholesPrice;
+    const auto typedKernels = tabulated ? kernels.blackScholesPriceTabulatedOf : kernels.blackScholesPriceOf;
+    forEachOptionTypeRun(count, optionType,
+        [&](std::size_t i, std::size_t n) {
+            mixedKernel(n, underlyingPrice + i, strikePrice + i, timeToExperation + i, riskFreeRate + i,
+                        volatility + i, optionType + i, optionPrice + i);
+        },
+        [&](OptionType type, std::size_t i, std::size_t n) {
+            typedKernels[type](n, underlyingPrice + i, strikePrice + i, timeToExperation + i, riskFreeRate + i,
+                               volatility + i, optionPrice + i);
+        });
+}
+
+/// @brief prices every option of the batch with the Black-Scholes formula.
+/// @param batch
+/// @param optionPrice
+/// @param cdfMethod
+void blackScholesBatchPrice(const optionBatch& batch, std::vector<double>& optionPrice, NormalCDFMethod cdfMethod)
+{
+    optionPrice.resize(batch.size());
+    blackScholesBatchPrice(batch.size(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                           batch.timeToExperation.data(), batch.riskFreeRate.data(), batch.volatility.data(),
+                           batch.optionType.data(), optionPrice.data(), cdfMethod);
+}
+
+/// @brief computes the price and first-order Greeks of count options in one pass,
+///        using the vectorized kernels selected by cpuDispatch. Long runs of calls or puts use the
+///        kernels specialized on the option type.
+/// @param count
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param volatility
+/// @param optionType
+/// @param optionPrice
+/// @param delta
+/// @param gamma
+/// @param vega
+/// @param theta
+/// @param rho
+void blackScholesBatchGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                             const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                             const OptionType* optionType, double* optionPrice, double* delta, double* gamma,
+                             double* vega, double* theta, double* rho)
+{
+    const simdKernelTable& kernels = simdKernels();
+    forEachOptionTypeRun(count, optionType,
+        [&](std::size_t i, std::size_t n) {
+            kernels.blackScholesGreeks(n, underlyingPrice + i, strikePrice + i, timeToExperation + i, riskFreeRate + i,
+                                       volatility + i, optionType + i, optionPrice + i, delta + i, gamma + i,
+                                       vega + i, theta + i, rho + i);
+        },
+        [&](OptionType type, std::size_t i, std::size_t n) {
+            kernels.blackScholesGreeksOf[type](n, underlyingPrice + i, strikePrice + i, timeToExperation + i,
+                                               riskFreeRate + i, volatility + i, optionPrice + i, delta + i,
+                                               gamma + i, vega + i, theta + i, rho + i);
+        });
+}
+
+/// @brief computes the price and first-order Greeks of every option of the batch.
+/// @param batch
+/// @param greeks
+void blackScholesBatchGreeks(const optionBatch& batch, greeksBatch& greeks)
+{
+    greeks.resize(batch.size());
+    blackScholesBatchGreeks(batch.size(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                            batch.timeToExperation.data(), batch.riskFreeRate.data(), batch.volatility.data(),
+                            batch.optionType.data(), greeks.price.data(), greeks.delta.data(), greeks.gamma.data(),
+                            greeks.vega.data(), greeks.theta.data(), greeks.rho.data());
+}
+
+/// @brief computes only the results selected by greeks, each into its own column.
+/// @param count
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param volatility
+/// @param optionType
+/// @param greeks
+/// @param output
+void blackScholesBatchGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                             const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                             const OptionType* optionType, unsigned greeks, double* const* output)
+{
+    simdKernels().blackScholesSelectedGreeks(count, underlyingPrice, strikePrice, timeToExperation, riskFreeRate,
+                                             volatility, optionType, greeks, output);
+}
+
+/// @brief computes the results selected by greeks for every option of the batch.
+/// @param batch
+/// @param greeks
+/// @param output
+void blackScholesBatchGreeks(const optionBatch& batch, unsigned greeks, selectedGreeksBatch& output)
+{
+    output.resize(batch.size(), greeks);
+    std::array<double*, GREEK_COUNT> columns;
+    for (unsigned b = 0; b < GREEK_COUNT; ++b)
+    {
+        columns[b] = output.columns[b].empty() ? nullptr : output.columns[b].data();
+    }
+    blackScholesBatchGreeks(batch.size(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                            batch.timeToExperation.data(), batch.riskFreeRate.data(), batch.volatility.data(),
+                            batch.optionType.data(), greeks, columns.data());
+}
+
+/// @brief computes the OptionStatus bits of count options in one branch-free pass.
+/// @param count
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param volatility
+/// @param optionType
+/// @param status
+/// @return the number of invalid options.
+std::size_t validateBatch(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                          const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                          const OptionType* optionType, std::uint8_t* status)
+{
+    std::size_t invalidCount = 0;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        status[i] = optionInputStatus(underlyingPrice[i], strikePrice[i], timeToExperation[i], riskFreeRate[i],
+                                      volatility[i], optionType[i]);
+        invalidCount += status[i] != OPTION_VALID;
+    }
+    return invalidCount;
+}
+
+/// @brief computes the OptionStatus bits of every option of the batch.
+/// @param batch
+/// @param status
+void validateBatch(const optionBatch& batch, batchStatus& status)
+{
+    status.status.resize(batch.size());
+    status.invalidCount = validateBatch(batch.size(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                                        batch.timeToExperation.data(), batch.riskFreeRate.data(),
+                                        batch.volatility.data(), batch.optionType.data(), status.status.data());
+    std::uint8_t fields = 0;
+    for (std::uint8_t bits : status.status)
+    {
+        fields |= bits;
+    }
+    status.fields = fields;
+}
+
+/// @brief describes the invalid options of a batch in one line.
+/// @param status
+/// @param maxIndices
+/// @return the description, empty if every option is valid.
+std::string describeBatchStatus(const batchStatus& status, std::size_t maxIndices)
+{
+    if (status.invalidCount == 0)
+    {
+        return "";
+    }
+
+    static const std::array<const char*, 6> fieldNames = {"underlying price", "strike price", "time to expiration",
+                                                          "risk free rate", "volatility", "option type"};
+    std::array<std::size_t, 6> fieldCount{};
+    std::string indices;
+    std::size_t listed = 0;
+    for (std::size_t i = 0; i < status.size(); ++i)
+    {
+        const std::uint8_t bits = status.status[i];
+        if (bits == OPTION_VALID)
+        {
+            continue;
+        }
+        for (std::size_t field = 0; field < fieldNames.size(); ++field)
+        {
+            fieldCount[field] += (bits >> field) & 1u;
+        }
+        if (listed < maxIndices)
+        {
+            indices += (listed == 0 ? "" : ", ") + std::to_string(i);
+            ++listed;
+        }
+    }
+
+    std::string message = std::to_string(status.invalidCount) + " of " + std::to_string(status.size())
+                        + " options have invalid inputs (";
+    bool first = true;
+    for (std::size_t field = 0; field < fieldNames.size(); ++field)
+    {
+        if (fieldCount[field] != 0)
+        {
+            message += (first ? "" : ", ") + std::string(fieldNames[field]) + ": " + std::to_string(fieldCount[field]);
+            first = false;
+        }
+    }
+    message += "), first at " + indices;
+    if (status.invalidCount > listed)
+    {
+        message += ", ...";
+    }
+    return message;
+}
+
+/// @brief prices every option of the batch without throwing, reporting invalid inputs in status and
+///        logging them once for the batch.
+/// @param batch
+/// @param optionPrice
+/// @param status
+/// @param cdfMethod
+void blackScholesBatchPrice(const optionBatch& batch, std::vector<double>& optionPrice, batchStatus& status,
+                            NormalCDFMethod cdfMethod)
+{
+    blackScholesBatchPrice(batch, optionPrice, cdfMethod);
+    validateBatch(batch, status);
+    if (status.invalidCount != 0)
+    {
+        markInvalid(status, optionPrice);
+        logBatchStatus("blackScholesBatchPrice", status);
+    }
+}
+
+/// @brief computes the price and first-order Greeks of every option of the batch without throwing,
+///        reporting invalid inputs in status and logging them once for the batch.
+/// @param batch
+/// @param greeks
+/// @param status
+void blackScholesBatchGreeks(const optionBatch& batch, greeksBatch& greeks, batchStatus& status)
+{
+    blackScholesBatchGreeks(batch, greeks);
+    validateBatch(batch, status);
+    if (status.invalidCount != 0)
+    {
+        for (std::vector<double>* column : {&greeks.price, &greeks.delta, &greeks.gamma, &greeks.vega, &greeks.theta,
+                                            &greeks.rho})
+        {
+            markInvalid(status, *column);
+        }
+        logBatchStatus("blackScholesBatchGreeks", status);
+    }
+}
+
+/// @brief prices count options stored as single-precision structure-of-arrays with the Black-Scholes formula.
+/// @param count
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param volatility
+/// @param optionType
+/// @param optionPrice
+/// @param relativeError
+void blackScholesBatchPrice(std::size_t count, const float* underlyingPrice, const float* strikePrice,
+                            const float* timeToExperation, const float* riskFreeRate, const float* volatility,
+                            const OptionType* optionType, float* optionPrice, float* relativeError)
+{
+    simdKernels().blackScholesPriceFloat(count, underlyingPrice, strikePrice, timeToExperation, riskFreeRate,
+                                         volatility, optionType, optionPrice, relativeError);
+}
+
+/// @brief prices every option of the single-precision batch.
+/// @param batch
+/// @param optionPrice
+void blackScholesBatchPrice(const optionBatchFloat& batch, std::vector<float>& optionPrice)
+{
+    optionPrice.resize(batch.size());
+    blackScholesBatchPrice(batch.size(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                           batch.timeToExperation.data(), batch.riskFreeRate.data(), batch.volatility.data(),
+                           batch.optionType.data(), optionPrice.data());
+}
+
+/// @brief prices the batch in float and re-prices in double the options whose estimated error exceeds tolerance.
+/// @param batch
+/// @param optionPrice
+/// @param tolerance
+/// @param stats
+void blackScholesBatchPriceMixed(const optionBatch& batch, std::vector<double>& optionPrice, double tolerance,
+                                 mixedPrecisionStats* stats)
+{
+    // Small enough that the float columns stay in L1/L2 between conversion and pricing.
+    const std::size_t chunk = 2048;
+    const std::size_t count = batch.size();
+    const simdKernelTable& kernels = simdKernels();
+
+    optionPrice.resize(count);
+    std::vector<float> columns(7 * chunk);
+    float* S = columns.data();
+    float* K = S + chunk;
+    float* T = K + chunk;
+    float* r = T + chunk;
+    float* vol = r + chunk;
+    float* price = vol + chunk;
+    float* relativeError = price + chunk;
+
+    optionBatch retry;
+    std::vector<std::size_t> retryIndex;
+    std::vector<double> retryPrice;
+    std::size_t reevaluated = 0;
+
+    for (std::size_t first = 0; first < count; first += chunk)
+    {
+        const std::size_t n = std::min(chunk, count - first);
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            S[j] = static_cast<float>(batch.underlyingPrice[first + j]);
+            K[j] = static_cast<float>(batch.strikePrice[first + j]);
+            T[j] = static_cast<float>(batch.timeToExperation[first + j]);
+            r[j] = static_cast<float>(batch.riskFreeRate[first + j]);
+            vol[j] = static_cast<float>(batch.volatility[first + j]);
+        }
+        kernels.blackScholesPriceFloat(n, S, K, T, r, vol, batch.optionType.data() + first, price, relativeError);
+
+        retryIndex.clear();
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            // Written so that a NaN estimate (invalid option) also goes to the double path.
+            if (relativeError[j] <= tolerance)
+            {
+                optionPrice[first + j] = price[j];
+            }
+            else
+            {
+                retryIndex.push_back(first + j);
+            }
+        }
+        if (retryIndex.empty())
+        {
+            continue;
+        }
+
+        retry.resize(retryIndex.size());
+        for (std::size_t k = 0; k < retryIndex.size(); ++k)
+        {
+            const std::size_t i = retryIndex[k];
+            retry.underlyingPrice[k] = batch.underlyingPrice[i];
+            retry.strikePrice[k] = batch.strikePrice[i];
+            retry.timeToExperation[k] = batch.timeToExperation[i];
+            retry.riskFreeRate[k] = batch.riskFreeRate[i];
+            retry.volatility[k] = batch.volatility[i];
+            retry.optionType[k] = batch.optionType[i];
+        }
+        blackScholesBatchPrice(retry, retryPrice);
+        for (std::size_t k = 0; k < retryIndex.size(); ++k)
+        {
+            optionPrice[retryIndex[k]] = retryPrice[k];
+        }
+        reevaluated += retryIndex.size();
+    }
+
+    if (stats != nullptr)
+    {
+        stats->count = count;
+        stats->reevaluated = reevaluated;
+    }
+}
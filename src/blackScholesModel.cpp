@@ -2,6 +2,7 @@
 #include <cmath>
 #include <numbers>
 #include "../include/blackScholesModel.h"
+#include "../include/pricingCore.h"
 #include "../include/ErrorHandler.h"
 
 using namespace std;
@@ -16,12 +17,7 @@ void blackScholesModel::calculateD1()
             setD1(nan(""));
             return;
         }
-        double numerator = log(getUnderlyingPrice()/getStrikePrice()) + (getRiskFreeRate() + 0.5 * getVolatility() * getVolatility()) * getTimeToExperation();
-        double denominator = getVolatility() * sqrt(getTimeToExperation());
-        
-        double d1 = numerator / denominator;
-
-        setD1(d1);
+        setD1(blackScholesD1(getUnderlyingPrice(), getStrikePrice(), getTimeToExperation(), getRiskFreeRate(), getVolatility()));
     }
     catch (const std::exception& e)
     {
@@ -40,9 +36,7 @@ void blackScholesModel::calculateD2()
             setD2(nan(""));
             return;
         }
-        double d2 = getD1() - getVolatility() * sqrt(getTimeToExperation());
-
-        setD2(d2);
+        setD2(blackScholesD2(getD1(), getTimeToExperation(), getVolatility()));
     }
     catch (const std::exception& e)
     {
@@ -54,7 +48,7 @@ void blackScholesModel::calculateD2()
 
 /// @brief calculates the option price using the Black-Scholes model.
 /// @return the option price.
-double blackScholesModel::calculateOptionPrice()
+double blackScholesModel::calculateOptionPrice() const
 {
     try
     {
@@ -62,16 +56,8 @@ double blackScholesModel::calculateOptionPrice()
         {
             return nan("");
         }
-        switch(getOptionType()) 
-        {
-            case CALL:
-                return getUnderlyingPrice() * normalCDF(getD1()) - getStrikePrice() * exp(-getRiskFreeRate() * getTimeToExperation()) * normalCDF(getD2());
-            
-            case PUT:
-                return getStrikePrice() * exp(-getRiskFreeRate() * getTimeToExperation()) * normalCDF(-getD2()) - getUnderlyingPrice() * normalCDF(-getD1());
-            default:
-                return nan("");
-        }
+        return blackScholesPrice(getUnderlyingPrice(), getStrikePrice(), getTimeToExperation(), getRiskFreeRate(),
+                                 getD1(), getD2(), getOptionType());
     }
     catch (const std::exception& e)
     {
@@ -81,6 +67,28 @@ double blackScholesModel::calculateOptionPrice()
 }
 
 
+/// @brief calculates the price and its sensitivities by forward-mode differentiation of the price.
+/// @return the price, delta, gamma, vega, theta, rho, vanna, volga and charm.
+blackScholesSensitivities blackScholesModel::calculateSensitivities() const
+{
+    try
+    {
+        if (isnan(getD1()) || isnan(getD2()))
+        {
+            const double nan = std::nan("");
+            return {nan, nan, nan, nan, nan, nan, nan, nan, nan};
+        }
+        return blackScholesPriceAndSensitivities(getUnderlyingPrice(), getStrikePrice(), getTimeToExperation(),
+                                                 getRiskFreeRate(), getVolatility(), getOptionType());
+    }
+    catch (const std::exception& e)
+    {
+        ErrorHandler::logError("Error in calculateSensitivities: " + std::string(e.what()));
+        const double nan = std::nan("");
+        return {nan, nan, nan, nan, nan, nan, nan, nan, nan};
+    }
+}
+
 /// @brief calculates and sets the K value in the Black-Scholes model.
 void blackScholesModel::calculateK()
 {
@@ -91,9 +99,7 @@ void blackScholesModel::calculateK()
             setK(nan(""));
             return;
         }
-        double K = 1.0 / (1.0 + 0.2316419 * abs(getD1()));
-
-        setK(K);
+        setK(blackScholesK(getD1()));
     }
     catch (const std::exception& e)
     {
@@ -231,21 +237,21 @@ void blackScholesModel::setOptionType(const OptionType& option)
 
 /// @brief sets the D1 value in the Black-Scholes model.
 /// @param value 
-void blackScholesModel::setD1(const double& value) const 
+void blackScholesModel::setD1(const double& value)
 {
     _d1 = value;
 }
 
 /// @brief sets the D2 value in the Black-Scholes model.
 /// @param value 
-void blackScholesModel::setD2(const double& value) const 
+void blackScholesModel::setD2(const double& value)
 {
     _d2 = value;
 }
 
 /// @brief sets the K value in the Black-Scholes model.
 /// @param value 
-void blackScholesModel::setK(const double& value) const 
+void blackScholesModel::setK(const double& value)
 {
     _K = value;
 }
@@ -291,22 +297,5 @@ const double& blackScholesModel::getK() const { return _K; }
 /// @return cumilative distribution of d.
 const double blackScholesModel::normalCDF(const double& d) const
 {
-    double z = abs(d);
-    double K = 1.0 / (1.0 + 0.2316419 * z);
-
-    if (isnan(d))
-    {
-        return nan("");
-    }
-
-    double a1 = 0.319381530;
-    double a2 = -0.356563782;
-    double a3 = 1.781477937;
-    double a4 = -1.821255978;
-    double a5 = 1.330274429;
-
-    double y = 1.0 - (1.0 / sqrt(2 * M_PI)) * exp(-0.5 * z * z) * 
-               (a1 * K + a2 * K * K + a3 * K * K * K + a4 * K * K * K * K + a5 * K * K * K * K * K);
-
-    return d < 0 ? 1.0 - y : y;
+    return ::normalCDF(d);
 }
@@ -0,0 +1,125 @@
+#include <bit>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include "../include/chainPricing.h"
+#include "../include/cpuDispatch.h"
+
+void optionChain::resize(std::size_t count)
+{
+    strikePrice.resize(count);
+    volatility.resize(count);
+    optionType.resize(count);
+}
+
+/// @brief groups the options of a batch by (underlying price, time to expiration, rate).
+/// @param batch
+/// @param originalIndex
+/// @return the chains, in order of first appearance.
+std::vector<optionChain> groupIntoChains(const optionBatch& batch, std::vector<std::size_t>& originalIndex)
+{
+    // Keyed on the bit patterns, so equal values group together and NaN inputs still form a chain.
+    using expiryKey = std::tuple<std::uint64_t, std::uint64_t, std::uint64_t>;
+    std::map<expiryKey, std::size_t> chainOf;
+    std::vector<std::vector<std::size_t>> rows;
+
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        const expiryKey key{std::bit_cast<std::uint64_t>(batch.underlyingPrice[i]),
+                            std::bit_cast<std::uint64_t>(batch.timeToExperation[i]),
+                            std::bit_cast<std::uint64_t>(batch.riskFreeRate[i])};
+        auto [it, inserted] = chainOf.try_emplace(key, rows.size());
+        if (inserted)
+        {
+            rows.emplace_back();
+        }
+        rows[it->second].push_back(i);
+    }
+
+    std::vector<optionChain> chains(rows.size());
+    originalIndex.clear();
+    originalIndex.reserve(batch.size());
+    for (std::size_t c = 0; c < rows.size(); ++c)
+    {
+        optionChain& chain = chains[c];
+        const std::size_t first = rows[c].front();
+        chain.underlyingPrice = batch.underlyingPrice[first];
+        chain.timeToExperation = batch.timeToExperation[first];
+        chain.riskFreeRate = batch.riskFreeRate[first];
+        chain.resize(rows[c].size());
+        for (std::size_t k = 0; k < rows[c].size(); ++k)
+        {
+            const std::size_t i = rows[c][k];
+            chain.strikePrice[k] = batch.strikePrice[i];
+            chain.volatility[k] = batch.volatility[i];
+            chain.optionType[k] = batch.optionType[i];
+            originalIndex.push_back(i);
+        }
+    }
+
+    return chains;
+}
+
+/// @brief prices count strikes of one expiry with the Black-Scholes formula, using the vectorized
+///        kernels selected by cpuDispatch and the expiry-level terms computed once.
+/// @param underlyingPrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param count
+/// @param strikePrice
+/// @param volatility
+/// @param optionType
+/// @param optionPrice
+void blackScholesChainPrice(double underlyingPrice, double timeToExperation, double riskFreeRate, std::size_t count,
+                            const double* strikePrice, const double* volatility, const OptionType* optionType,
+                            double* optionPrice)
+{
+    simdKernels().blackScholesChainPrice(underlyingPrice, timeToExperation, riskFreeRate, count, strikePrice,
+                                         volatility, optionType, optionPrice);
+}
+
+/// @brief prices every strike of the chain.
+/// @param chain
+/// @param optionPrice
+void blackScholesChainPrice(const optionChain& chain, std::vector<double>& optionPrice)
+{
+    optionPrice.resize(chain.size());
+    blackScholesChainPrice(chain.underlyingPrice, chain.timeToExperation, chain.riskFreeRate, chain.size(),
+                           chain.strikePrice.data(), chain.volatility.data(), chain.optionType.data(),
+                           optionPrice.data());
+}
+
+/// @brief computes the price and first-order Greeks of count strikes of one expiry in one pass.
+/// @param underlyingPrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param count
+/// @param strikePrice
+/// @param volatility
+/// @param optionType
+/// @param optionPrice
+/// @param delta
+/// @param gamma
+/// @param vega
+/// @param theta
+/// @param rho
+void blackScholesChainGreeks(double underlyingPrice, double timeToExperation, double riskFreeRate, std::size_t count,
+                             const double* strikePrice, const double* volatility, const OptionType* optionType,
+                             double* optionPrice, double* delta, double* gamma, double* vega, double* theta,
+                             double* rho)
+{
+    simdKernels().blackScholesChainGreeks(underlyingPrice, timeToExperation, riskFreeRate, count, strikePrice,
+                                          volatility, optionType, optionPrice, delta, gamma, vega, theta, rho);
+}
+
+/// @brief computes the price and first-order Greeks of every strike of the chain.
+/// @param chain
+/// @param greeks
+void blackScholesChainGreeks(const optionChain& chain, greeksBatch& greeks)
+{
+    greeks.resize(chain.size());
+    blackScholesChainGreeks(chain.underlyingPrice, chain.timeToExperation, chain.riskFreeRate, chain.size(),
+                            chain.strikePrice.data(), chain.volatility.data(), chain.optionType.data(),
+                            greeks.price.data(), greeks.delta.data(), greeks.gamma.data(), greeks.vega.data(),
+                            greeks.theta.data(), greeks.rho.data());
+}
@@ -0,0 +1,227 @@
+#include <atomic>
+#include <cstdlib>
+#include "../include/cpuDispatch.h"
+#include "../include/simdMath.h"
+#include "../include/ErrorHandler.h"
+
+namespace
+{
+    const simdKernelTable scalarKernels = {SCALAR, simd::scalar::normalCDF, simd::scalar::exp, simd::scalar::log,
+                                           simd::scalar::blackScholesPrice, simd::scalar::blackScholesGreeks,
+                                           {simd::scalar::blackScholesPriceOf<CALL>, simd::scalar::blackScholesPriceOf<PUT>},
+                                           {simd::scalar::blackScholesGreeksOf<CALL>, simd::scalar::blackScholesGreeksOf<PUT>},
+                                           simd::scalar::normalCDFFloat, simd::scalar::expFloat, simd::scalar::logFloat,
+                                           simd::scalar::blackScholesPriceFloat,
+                                           simd::scalar::normalCDFTabulated, simd::scalar::blackScholesPriceTabulated,
+                                           {simd::scalar::blackScholesPriceTabulatedOf<CALL>, simd::scalar::blackScholesPriceTabulatedOf<PUT>},
+                                           simd::scalar::blackScholesChainPrice, simd::scalar::blackScholesChainGreeks,
+                                           simd::scalar::impliedVolatility, simd::scalar::impliedVolatilityChain,
+                                           simd::scalar::sviVolatility, simd::scalar::blackScholesSelectedGreeks,
+                                           simd::scalar::philoxNormalPairs, simd::scalar::hestonEulerVariance,
+                                           simd::scalar::hestonQEVariance};
+
+#if defined(SIMD_X86)
+    const simdKernelTable sse42Kernels = {SSE42, simd::sse42::normalCDF, simd::sse42::exp, simd::sse42::log,
+                                          simd::sse42::blackScholesPrice, simd::sse42::blackScholesGreeks,
+                                          {simd::sse42::blackScholesPriceOf<CALL>, simd::sse42::blackScholesPriceOf<PUT>},
+                                          {simd::sse42::blackScholesGreeksOf<CALL>, simd::sse42::blackScholesGreeksOf<PUT>},
+                                          simd::sse42::normalCDFFloat, simd::sse42::expFloat, simd::sse42::logFloat,
+                                          simd::sse42::blackScholesPriceFloat,
+                                          simd::sse42::normalCDFTabulated, simd::sse42::blackScholesPriceTabulated,
+                                          {simd::sse42::blackScholesPriceTabulatedOf<CALL>, simd::sse42::blackScholesPriceTabulatedOf<PUT>},
+                                          simd::sse42::blackScholesChainPrice, simd::sse42::blackScholesChainGreeks,
+                                          simd::sse42::impliedVolatility, simd::sse42::impliedVolatilityChain,
+                                          simd::sse42::sviVolatility, simd::sse42::blackScholesSelectedGreeks,
+                                          simd::sse42::philoxNormalPairs, simd::sse42::hestonEulerVariance,
+                                          simd::sse42::hestonQEVariance};
+
+    const simdKernelTable avx2Kernels = {AVX2, simd::avx2::normalCDF, simd::avx2::exp, simd::avx2::log,
+                                         simd::avx2::blackScholesPrice, simd::avx2::blackScholesGreeks,
+                                         {simd::avx2::blackScholesPriceOf<CALL>, simd::avx2::blackScholesPriceOf<PUT>},
+                                         {simd::avx2::blackScholesGreeksOf<CALL>, simd::avx2::blackScholesGreeksOf<PUT>},
+                                         simd::avx2::normalCDFFloat, simd::avx2::expFloat, simd::avx2::logFloat,
+                                         simd::avx2::blackScholesPriceFloat,
+                                         simd::avx2::normalCDFTabulated, simd::avx2::blackScholesPriceTabulated,
+                                         {simd::avx2::blackScholesPriceTabulatedOf<CALL>, simd::avx2::blackScholesPriceTabulatedOf<PUT>},
+                                         simd::avx2::blackScholesChainPrice, simd::avx2::blackScholesChainGreeks,
+                                         simd::avx2::impliedVolatility, simd::avx2::impliedVolatilityChain,
+                                         simd::avx2::sviVolatility, simd::avx2::blackScholesSelectedGreeks,
+                                         simd::avx2::philoxNormalPairs, simd::avx2::hestonEulerVariance,
+                                         simd::avx2::hestonQEVariance};
+
+    const simdKernelTable avx512Kernels = {AVX512, simd::avx512::normalCDF, simd::avx512::exp, simd::avx512::log,
+                                           simd::avx512::blackScholesPrice, simd::avx512::blackScholesGreeks,
+                                           {simd::avx512::blackScholesPriceOf<CALL>, simd::avx512::blackScholesPriceOf<PUT>},
+                                           {simd::avx512::blackScholesGreeksOf<CALL>, simd::avx512::blackScholesGreeksOf<PUT>},
+                                           simd::avx512::normalCDFFloat, simd::avx512::expFloat, simd::avx512::logFloat,
+                                           simd::avx512::blackScholesPriceFloat,
+                                           simd::avx512::normalCDFTabulated, simd::avx512::blackScholesPriceTabulated,
+                                           {simd::avx512::blackScholesPriceTabulatedOf<CALL>, simd::avx512::blackScholesPriceTabulatedOf<PUT>},
+                                           simd::avx512::blackScholesChainPrice, simd::avx512::blackScholesChainGreeks,
+                                           simd::avx512::impliedVolatility, simd::avx512::impliedVolatilityChain,
+                                           simd::avx512::sviVolatility, simd::avx512::blackScholesSelectedGreeks,
+                                           simd::avx512::philoxNormalPairs, simd::avx512::hestonEulerVariance,
+                                           simd::avx512::hestonQEVariance};
+#endif
+
+    std::atomic<const simdKernelTable*> activeKernels{nullptr};
+
+    /// @brief the level chosen at startup: the detected one, lowered by FINANCE_SIMD_LEVEL if set.
+    SimdLevel startupSimdLevel()
+    {
+        static const SimdLevel level = []()
+        {
+            SimdLevel detected = detectSimdLevel();
+            const char* requested = std::getenv("FINANCE_SIMD_LEVEL");
+            if (requested == nullptr)
+            {
+                return detected;
+            }
+
+            SimdLevel forced;
+            if (!parseSimdLevel(requested, forced) || !isSimdLevelSupported(forced))
+            {
+                ErrorHandler::logError("Error in startupSimdLevel: FINANCE_SIMD_LEVEL=" + std::string(requested) +
+                                       " is not a supported level, using " + simdLevelName(detected));
+                return detected;
+            }
+            return forced;
+        }();
+        return level;
+    }
+}
+
+/// @brief detects the most capable level supported by this CPU and build.
+/// @return the detected level.
+SimdLevel detectSimdLevel()
+{
+#if defined(SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return AVX512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+    {
+        return AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        return SSE42;
+    }
+#endif
+    return SCALAR;
+}
+
+/// @brief checks whether the level's kernels can be called on this CPU.
+/// @param level
+/// @return true if supported.
+bool isSimdLevelSupported(SimdLevel level)
+{
+    return simdKernelsFor(level) != nullptr;
+}
+
+/// @brief gets the level simdKernels() currently returns.
+/// @return the active level.
+SimdLevel activeSimdLevel()
+{
+    return simdKernels().level;
+}
+
+/// @brief forces the active level.
+/// @param level
+/// @return false if the level is not supported.
+bool setSimdLevel(SimdLevel level)
+{
+    const simdKernelTable* kernels = simdKernelsFor(level);
+    if (kernels == nullptr)
+    {
+        return false;
+    }
+    activeKernels.store(kernels, std::memory_order_release);
+    return true;
+}
+
+/// @brief returns to the level chosen at startup.
+void resetSimdLevel()
+{
+    activeKernels.store(simdKernelsFor(startupSimdLevel()), std::memory_order_release);
+}
+
+/// @brief gets the kernels of the active level, choosing the startup level on first use.
+/// @return the active kernel table.
+const simdKernelTable& simdKernels()
+{
+    const simdKernelTable* kernels = activeKernels.load(std::memory_order_acquire);
+    if (kernels == nullptr)
+    {
+        kernels = simdKernelsFor(startupSimdLevel());
+        activeKernels.store(kernels, std::memory_order_release);
+    }
+    return *kernels;
+}
+
+/// @brief gets the kernels of a given level.
+/// @param level
+/// @return the kernel table, or nullptr if the level is not supported.
+const simdKernelTable* simdKernelsFor(SimdLevel level)
+{
+    static const SimdLevel detected = detectSimdLevel();
+    if (level > detected)
+    {
+        return nullptr;
+    }
+
+    switch (level)
+    {
+        case SCALAR:
+            return &scalarKernels;
+#if defined(SIMD_X86)
+        case SSE42:
+            return &sse42Kernels;
+        case AVX2:
+            return &avx2Kernels;
+        case AVX512:
+            return &avx512Kernels;
+#endif
+        default:
+            return nullptr;
+    }
+}
+
+/// @brief gets the lowercase name of a level.
+/// @param level
+/// @return the level name.
+const char* simdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+        case SCALAR:
+            return "scalar";
+        case SSE42:
+            return "sse42";
+        case AVX2:
+            return "avx2";
+        case AVX512:
+            return "avx512";
+        default:
+            return "unknown";
+    }
+}
+
+/// @brief parses a level name.
+/// @param name
+/// @param level
+/// @return true if the name is valid.
+bool parseSimdLevel(const std::string& name, SimdLevel& level)
+{
+    for (SimdLevel candidate : {SCALAR, SSE42, AVX2, AVX512})
+    {
+        if (name == simdLevelName(candidate))
+        {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,141 @@
+#include "../include/impliedVolatility.h"
+#include "../include/cpuDispatch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+/// @brief inverts the Black-Scholes price of one option, as a batch of one.
+/// @param optionPrice
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param optionType
+/// @param iterations
+/// @return the implied volatility, 0 at the intrinsic value and NaN outside the price bounds.
+double impliedVolatility(double optionPrice, double underlyingPrice, double strikePrice, double timeToExperation,
+                         double riskFreeRate, OptionType optionType, int* iterations)
+{
+    double volatility;
+    std::uint8_t steps;
+    simdKernels().impliedVolatility(1, &optionPrice, &underlyingPrice, &strikePrice, &timeToExperation,
+                                    &riskFreeRate, &optionType, &volatility, &steps);
+    if (iterations != nullptr)
+    {
+        *iterations = steps;
+    }
+    return volatility;
+}
+
+/// @brief computes the implied volatilities of count quotes on the vectorized kernels selected by cpuDispatch.
+/// @param count
+/// @param optionPrice
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param optionType
+/// @param volatility
+/// @param iterations
+void impliedVolatilityBatch(std::size_t count, const double* optionPrice, const double* underlyingPrice,
+                            const double* strikePrice, const double* timeToExperation, const double* riskFreeRate,
+                            const OptionType* optionType, double* volatility, std::uint8_t* iterations)
+{
+    simdKernels().impliedVolatility(count, optionPrice, underlyingPrice, strikePrice, timeToExperation, riskFreeRate,
+                                    optionType, volatility, iterations);
+}
+
+/// @brief computes the implied volatilities of the options of the batch from their prices.
+/// @param batch
+/// @param optionPrice
+/// @param volatility
+void impliedVolatilityBatch(const optionBatch& batch, const std::vector<double>& optionPrice,
+                            std::vector<double>& volatility)
+{
+    volatility.resize(batch.size());
+    impliedVolatilityBatch(batch.size(), optionPrice.data(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                           batch.timeToExperation.data(), batch.riskFreeRate.data(), batch.optionType.data(),
+                           volatility.data());
+}
+
+/// @brief computes the implied volatilities of the strikes of one expiry, seeded from previousVolatility or the
+///        last volatility solved in the previous block of strikes.
+/// @param underlyingPrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param count
+/// @param optionPrice
+/// @param strikePrice
+/// @param optionType
+/// @param previousVolatility
+/// @param volatility
+/// @param iterations
+void impliedVolatilityChain(double underlyingPrice, double timeToExperation, double riskFreeRate, std::size_t count,
+                            const double* optionPrice, const double* strikePrice, const OptionType* optionType,
+                            const double* previousVolatility, double* volatility, std::uint8_t* iterations)
+{
+    simdKernels().impliedVolatilityChain(underlyingPrice, timeToExperation, riskFreeRate, count, optionPrice,
+                                         strikePrice, optionType, previousVolatility, volatility, iterations);
+}
+
+/// @brief solves the chains on threadCount workers, each taking the next unsolved chain until none are left.
+/// @param chains
+/// @param optionPrice
+/// @param iterations
+/// @param threadCount
+/// @return the step counts of all chains.
+impliedVolatilityStats impliedVolatilitySurface(std::vector<optionChain>& chains,
+                                                const std::vector<std::vector<double>>& optionPrice,
+                                                std::vector<std::vector<std::uint8_t>>& iterations,
+                                                unsigned threadCount)
+{
+    iterations.resize(chains.size());
+    for (std::size_t c = 0; c < chains.size(); ++c)
+    {
+        iterations[c].resize(chains[c].size());
+    }
+
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threadCount = static_cast<unsigned>(std::min<std::size_t>(threadCount, chains.size()));
+
+    // Chains differ in size, so workers pull them one at a time rather than taking fixed shares.
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (std::size_t c = next.fetch_add(1); c < chains.size(); c = next.fetch_add(1))
+        {
+            optionChain& chain = chains[c];
+            // The previous volatilities are read block by block before the block is written, so they can be
+            // solved in place.
+            impliedVolatilityChain(chain.underlyingPrice, chain.timeToExperation, chain.riskFreeRate, chain.size(),
+                                   optionPrice[c].data(), chain.strikePrice.data(), chain.optionType.data(),
+                                   chain.volatility.data(), chain.volatility.data(), iterations[c].data());
+        }
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < threadCount; ++t)
+    {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (std::thread& thread : workers)
+    {
+        thread.join();
+    }
+
+    impliedVolatilityStats stats;
+    for (const std::vector<std::uint8_t>& steps : iterations)
+    {
+        for (std::uint8_t step : steps)
+        {
+            stats.iterations += step;
+            stats.maxIterations = std::max(stats.maxIterations, step);
+        }
+        stats.options += steps.size();
+    }
+    return stats;
+}
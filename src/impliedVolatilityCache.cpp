@@ -0,0 +1,274 @@
+#include <bit>
+#include <cmath>
+#include "../include/impliedVolatilityCache.h"
+#include "../include/impliedVolatility.h"
+
+/// @brief creates an empty cache of capacity entries in shards shards.
+/// @param capacity
+/// @param eviction
+/// @param quantization
+/// @param shards
+impliedVolatilityCache::impliedVolatilityCache(std::size_t capacity, cacheEviction eviction,
+                                               const quoteQuantization& quantization, std::size_t shards)
+    : _shardCount(shards == 0 ? 1 : shards), _shardCapacity(0), _eviction(eviction), _quantization(quantization),
+      _shards(new shard[shards == 0 ? 1 : shards])
+{
+    configure(capacity, eviction, quantization);
+}
+
+/// @brief mixes the fields of a key with the splitmix64 finalizer, so that the low bits pick a shard.
+/// @param key
+/// @return the hash.
+std::uint64_t impliedVolatilityCache::hashKey(const quoteKey& key)
+{
+    std::uint64_t hash = static_cast<std::uint64_t>(key.type);
+    for (std::int64_t field : {key.price, key.underlying, key.strike, key.time, key.rate})
+    {
+        hash = (hash ^ static_cast<std::uint64_t>(field)) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 29;
+    }
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+    return hash ^ (hash >> 31);
+}
+
+/// @brief the bucket holding key, or index.size() if the shard does not have it.
+/// @param key
+/// @param hash
+/// @return the bucket.
+std::size_t impliedVolatilityCache::shard::find(const quoteKey& key, std::uint64_t hash) const
+{
+    const std::size_t mask = index.size() - 1;
+    for (std::size_t bucket = (hash >> 32) & mask; index[bucket] != 0; bucket = (bucket + 1) & mask)
+    {
+        const entry& candidate = entries[index[bucket] - 1];
+        if (candidate.hash == hash && candidate.key == key)
+        {
+            return bucket;
+        }
+    }
+    return index.size();
+}
+
+/// @brief empties a bucket, shifting later entries of its probe run back so that no lookup stops early.
+/// @param bucket
+void impliedVolatilityCache::shard::erase(std::size_t bucket)
+{
+    const std::size_t mask = index.size() - 1;
+    index[bucket] = 0;
+    for (std::size_t next = (bucket + 1) & mask; index[next] != 0; next = (next + 1) & mask)
+    {
+        const std::size_t home = (entries[index[next] - 1].hash >> 32) & mask;
+        // An entry may move back only if its home bucket is not between the hole and its position.
+        if (((next - home) & mask) >= ((next - bucket) & mask))
+        {
+            index[bucket] = index[next];
+            index[next] = 0;
+            bucket = next;
+        }
+    }
+}
+
+/// @brief takes an entry off the eviction list.
+/// @param e
+void impliedVolatilityCache::shard::unlink(std::uint32_t e)
+{
+    entry& removed = entries[e];
+    (removed.newer == none ? newest : entries[removed.newer].older) = removed.older;
+    (removed.older == none ? oldest : entries[removed.older].newer) = removed.newer;
+}
+
+/// @brief puts an entry at the end of the eviction list that is evicted last.
+/// @param e
+void impliedVolatilityCache::shard::pushNewest(std::uint32_t e)
+{
+    entries[e].newer = none;
+    entries[e].older = newest;
+    (newest == none ? oldest : entries[newest].newer) = e;
+    newest = e;
+}
+
+/// @brief empties the shard and sizes its table for capacity entries, at most half full.
+/// @param capacity
+void impliedVolatilityCache::shard::reset(std::size_t capacity)
+{
+    entries.clear();
+    entries.shrink_to_fit();
+    index.assign(capacity == 0 ? 0 : std::bit_ceil(2 * capacity), 0);
+    newest = none;
+    oldest = none;
+}
+
+/// @brief rounds every field of a quote to a multiple of its tick.
+/// @param optionPrice
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param optionType
+/// @param key
+/// @return false if a field is not finite or does not fit in 2^62 ticks.
+bool impliedVolatilityCache::quantize(double optionPrice, double underlyingPrice, double strikePrice,
+                                      double timeToExperation, double riskFreeRate, OptionType optionType,
+                                      quoteKey& key) const
+{
+    constexpr double limit = 4611686018427387904.0;     // 2^62
+    bool valid = true;
+    auto ticks = [&](double value, double tick) -> std::int64_t {
+        const double scaled = std::nearbyint(value / tick);
+        if (!(std::abs(scaled) < limit))
+        {
+            valid = false;
+            return 0;
+        }
+        return static_cast<std::int64_t>(scaled);
+    };
+
+    key.price = ticks(optionPrice, _quantization.priceTick);
+    key.underlying = ticks(underlyingPrice, _quantization.underlyingTick);
+    key.strike = ticks(strikePrice, _quantization.strikeTick);
+    key.time = ticks(timeToExperation, _quantization.timeTick);
+    key.rate = ticks(riskFreeRate, _quantization.rateTick);
+    key.type = optionType;
+    return valid;
+}
+
+/// @brief looks the quote up in its shard and solves it outside the lock on a miss.
+/// @param optionPrice
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param optionType
+/// @return the implied volatility.
+double impliedVolatilityCache::impliedVolatility(double optionPrice, double underlyingPrice, double strikePrice,
+                                                 double timeToExperation, double riskFreeRate, OptionType optionType)
+{
+    quoteKey key;
+    const bool cacheable = _shardCapacity != 0 && quantize(optionPrice, underlyingPrice, strikePrice,
+                                                            timeToExperation, riskFreeRate, optionType, key);
+    const std::uint64_t hash = cacheable ? hashKey(key) : 0;
+    shard& home = _shards[hash % _shardCount];
+
+    if (!cacheable)
+    {
+        {
+            std::lock_guard<std::mutex> guard(home.lock);
+            ++home.uncacheable;
+        }
+        return ::impliedVolatility(optionPrice, underlyingPrice, strikePrice, timeToExperation, riskFreeRate,
+                                   optionType);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(home.lock);
+        const std::size_t bucket = home.find(key, hash);
+        if (bucket != home.index.size())
+        {
+            ++home.hits;
+            const std::uint32_t e = home.index[bucket] - 1;
+            if (_eviction == LEAST_RECENTLY_USED && e != home.newest)
+            {
+                home.unlink(e);
+                home.pushNewest(e);
+            }
+            return home.entries[e].volatility;
+        }
+        ++home.misses;
+    }
+
+    // Solved without the lock, so other quotes of the shard are not held up; if another thread cached the
+    // same key in the meantime its entry is kept.
+    const double volatility = ::impliedVolatility(optionPrice, underlyingPrice, strikePrice, timeToExperation,
+                                                  riskFreeRate, optionType);
+
+    std::lock_guard<std::mutex> guard(home.lock);
+    if (home.find(key, hash) != home.index.size())
+    {
+        return volatility;
+    }
+
+    std::uint32_t e;
+    if (home.entries.size() < _shardCapacity)
+    {
+        e = static_cast<std::uint32_t>(home.entries.size());
+        home.entries.emplace_back();
+    }
+    else
+    {
+        e = home.oldest;
+        home.erase(home.find(home.entries[e].key, home.entries[e].hash));
+        home.unlink(e);
+        ++home.evictions;
+    }
+    home.entries[e].key = key;
+    home.entries[e].hash = hash;
+    home.entries[e].volatility = volatility;
+    home.pushNewest(e);
+
+    const std::size_t mask = home.index.size() - 1;
+    std::size_t bucket = (hash >> 32) & mask;
+    while (home.index[bucket] != 0)
+    {
+        bucket = (bucket + 1) & mask;
+    }
+    home.index[bucket] = e + 1;
+    return volatility;
+}
+
+/// @brief replaces the settings and empties every shard.
+/// @param capacity
+/// @param eviction
+/// @param quantization
+void impliedVolatilityCache::configure(std::size_t capacity, cacheEviction eviction,
+                                       const quoteQuantization& quantization)
+{
+    _shardCapacity = (capacity + _shardCount - 1) / _shardCount;
+    _eviction = eviction;
+    _quantization = quantization;
+    for (std::size_t s = 0; s < _shardCount; ++s)
+    {
+        std::lock_guard<std::mutex> guard(_shards[s].lock);
+        _shards[s].reset(_shardCapacity);
+    }
+}
+
+/// @brief empties every shard.
+void impliedVolatilityCache::clear()
+{
+    for (std::size_t s = 0; s < _shardCount; ++s)
+    {
+        std::lock_guard<std::mutex> guard(_shards[s].lock);
+        _shards[s].reset(_shardCapacity);
+    }
+}
+
+/// @brief sums the counters of every shard, locking one shard at a time.
+/// @return the statistics.
+impliedVolatilityCacheStats impliedVolatilityCache::statistics() const
+{
+    impliedVolatilityCacheStats stats;
+    for (std::size_t s = 0; s < _shardCount; ++s)
+    {
+        std::lock_guard<std::mutex> guard(_shards[s].lock);
+        stats.hits += _shards[s].hits;
+        stats.misses += _shards[s].misses;
+        stats.evictions += _shards[s].evictions;
+        stats.uncacheable += _shards[s].uncacheable;
+        stats.size += _shards[s].entries.size();
+    }
+    return stats;
+}
+
+/// @brief zeroes the counters of every shard.
+void impliedVolatilityCache::resetStatistics()
+{
+    for (std::size_t s = 0; s < _shardCount; ++s)
+    {
+        std::lock_guard<std::mutex> guard(_shards[s].lock);
+        _shards[s].hits = 0;
+        _shards[s].misses = 0;
+        _shards[s].evictions = 0;
+        _shards[s].uncacheable = 0;
+    }
+}
@@ -5,9 +5,11 @@
 #include <string>
 
 #include "../include/blackScholesModel.h"
+#include "../include/batchPricing.h"
 #include "../include/hestonModel.h"
 #include "../include/RMSE.h"
 #include "../include/inputReader.h"
+#include "../include/volatilitySurface.h"
 #include "../include/optionType.h"
 
 using namespace std;
@@ -54,20 +56,22 @@ int main()
     else
     {
 
-        // get data from CSV file and plug into models
-        std::vector<double> estimatedPrices;
-        for (const auto& row : data)
+        // get data from CSV file and plug into the batch Black-Scholes pricer
+        optionBatch batch;
+        batch.resize(data.size());
+        for (size_t i = 0; i < data.size(); ++i)
         {
-            double expiration = row.getExpiration();
-            double stockPrice = row.getStockPrice();
-            double CSVstrikePrice = row.getStrikePrice();
-            double callPrice = row.getCallPrice();
-
-            blackScholesModel bModel(stockPrice, CSVstrikePrice, expiration, 6.50e-10, 2.38e-3, CALL);
-            double estimatedPrice = bModel.calculateOptionPrice();
-            estimatedPrices.push_back(estimatedPrice);
+            batch.underlyingPrice[i] = data[i].getStockPrice();
+            batch.strikePrice[i] = data[i].getStrikePrice();
+            batch.timeToExperation[i] = data[i].getExpiration();
+            batch.riskFreeRate[i] = 6.50e-10;
+            batch.volatility[i] = 2.38e-3;
+            batch.optionType[i] = CALL;
         }
 
+        std::vector<double> estimatedPrices;
+        blackScholesBatchPrice(batch, estimatedPrices);
+
 
         // calculate the RMSE
         std::vector<double> actualPrices;
@@ -78,6 +82,19 @@ int main()
         double rmse = rootMeanSquareError(estimatedPrices, actualPrices);
         cout << " Black-Scholes RMSE: " << rmse << endl;
 
+        // Volatilities from an SVI surface fitted to the same quotes, expirations read as days
+        volatilitySurface surface;
+        updateVolatilitySurface(surface, data, 0.0);
+        optionBatch surfaceBatch = batch;
+        for (size_t i = 0; i < data.size(); ++i)
+        {
+            surfaceBatch.timeToExperation[i] = data[i].getExpiration() / 365.0;
+            surfaceBatch.riskFreeRate[i] = 0.0;
+        }
+        std::vector<double> surfacePrices;
+        blackScholesBatchPrice(surfaceBatch, surface, surfacePrices);
+        cout << " Black-Scholes (SVI surface) RMSE: " << rootMeanSquareError(surfacePrices, actualPrices) << endl;
+
         // OptionGreeksModel
         std::vector<double> estimatedPricesGreeks;
         for (const auto& row : data)
@@ -122,23 +122,32 @@ const double& optionGreeksModel::getThetaAdjustedDelta() const { return _thetaAd
 
 const double& optionGreeksModel::getGammaVegaAdjustedDelta() const { return _gammaVegaAdjustedDelta; }
 
-/// @brief Reverse of the blackScholesModel to find the implied volatility
+/// @brief Reverse of the blackScholesModel to find the implied volatility of the model's own price
 /// @return ImpliedVol
 double optionGreeksModel::calculateImpliedVolatility() const
+{
+    return calculateImpliedVolatility(calculateOptionPrice());
+}
+
+/// @brief Reverse of the blackScholesModel to find the volatility that reproduces a market price
+/// @param marketPrice
+/// @return ImpliedVol
+double optionGreeksModel::calculateImpliedVolatility(double marketPrice) const
 {
     try
     {
-        if (isnan(getD1()) || isnan(getUnderlyingPrice()) || isnan(getStrikePrice()) || isnan(getRiskFreeRate()) || isnan(getTimeToExperation()))
+        if (isnan(marketPrice) || isnan(getUnderlyingPrice()) || isnan(getStrikePrice()) || isnan(getRiskFreeRate()) || isnan(getTimeToExperation()))
         {
             throw std::invalid_argument("Invalid input: NaN value detected");
         }
-        // Derive implied volatility from Black-Scholes formula
-        double d1 = getD1();
-        double d2 = d1 - (getVolatility() * sqrt(getTimeToExperation()));
 
-        double impliedVolatility = (getUnderlyingPrice() * normalCDF(d1) - getStrikePrice() * exp(-getRiskFreeRate() * getTimeToExperation()) * normalCDF(d2)) / getUnderlyingPrice();
+        double impliedVol = impliedVolatilityQuoteCache().impliedVolatility(marketPrice, getUnderlyingPrice(), getStrikePrice(), getTimeToExperation(), getRiskFreeRate(), getOptionType());
+        if (isnan(impliedVol))
+        {
+            throw std::invalid_argument("Invalid input: Price outside the Black-Scholes bounds");
+        }
 
-        return impliedVolatility;
+        return impliedVol;
     }
     catch (const std::exception& e)
     {
@@ -147,8 +156,15 @@ double optionGreeksModel::calculateImpliedVolatility() const
     }
 }
 
+/// @brief The cache shared by every optionGreeksModel, created on first use
+/// @return the cache
+impliedVolatilityCache& optionGreeksModel::impliedVolatilityQuoteCache()
+{
+    static impliedVolatilityCache cache;
+    return cache;
+}
 
-void optionGreeksModel::calculateOptionPriceIV() const
+void optionGreeksModel::calculateOptionPriceIV()
 {
     try
     {
@@ -357,7 +373,7 @@ void optionGreeksModel::calculateGammaVegaAdjustedDelta() const
     }
 }
 
-void optionGreeksModel::calculateD1(double impliedVolatility) const
+void optionGreeksModel::calculateD1(double impliedVolatility)
 {
     try
     {
@@ -366,11 +382,7 @@ void optionGreeksModel::calculateD1(double impliedVolatility) const
             throw std::invalid_argument("Invalid input: NaN value detected");
         }
 
-        double numerator = log(getUnderlyingPrice()/getStrikePrice()) + (getRiskFreeRate() + 0.5 * impliedVolatility * impliedVolatility) * getTimeToExperation();
-        double denominator = impliedVolatility * sqrt(getTimeToExperation());
-
-        double d1 = numerator / denominator;
-        setD1(d1);
+        setD1(blackScholesD1(getUnderlyingPrice(), getStrikePrice(), getTimeToExperation(), getRiskFreeRate(), impliedVolatility));
     }
     catch (const std::exception& e)
     {
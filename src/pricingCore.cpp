@@ -0,0 +1,771 @@
+#include <cmath>
+#include <complex>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include "../include/pricingCore.h"
+#include "../include/randomNormals.h"
+#include "../include/cpuDispatch.h"
+
+namespace
+{
+    /// @brief the full-truncation Euler steps, two normals per step drawn from normal().
+    template <class NormalSource>
+    double simulateVariance(const hestonParameters& params, double timeToExperation, int numTimeSteps,
+                            NormalSource& normal)
+    {
+        double Vt = params.v0;
+        const double dt = timeToExperation / numTimeSteps;
+        const double rhoComplement = std::sqrt(1.0 - params.rho * params.rho);
+
+        for (int i = 0; i < numTimeSteps; i++)
+        {
+            double Z1 = normal();
+            double Z2 = params.rho * Z1 + rhoComplement * normal();
+
+            Vt += params.kappa * (params.theta - std::max(0.0, Vt)) * dt + params.sigma * std::sqrt(std::max(0.0, Vt) * dt) * Z2;
+            Vt = std::max(0.0, Vt); // Ensure non-negativity
+        }
+
+        return Vt;
+    }
+
+    /// @brief the constants of one quadratic-exponential step: the next variance has the conditional mean
+    /// mean + decay v and variance varianceSlope v + varianceConstant, as hestonQEVarianceArray takes them.
+    struct quadraticExponentialStep
+    {
+        double decay;
+        double mean;
+        double varianceSlope;
+        double varianceConstant;
+    };
+
+    quadraticExponentialStep quadraticExponentialStepOf(const hestonParameters& params, double dt)
+    {
+        const double decay = std::exp(-params.kappa * dt);
+        const double growth = -std::expm1(-params.kappa * dt);
+        const double growthPerKappa = params.kappa > 0.0 ? growth / params.kappa : dt;
+        const double sigma2 = params.sigma * params.sigma;
+        return {decay, params.theta * growth, sigma2 * decay * growthPerKappa,
+                0.5 * params.theta * sigma2 * growth * growthPerKappa};
+    }
+
+    /// @brief the quadratic-exponential steps, with the two normals per step of the Euler scheme correlated
+    /// into the one the variance uses, so both schemes draw the same numbers.
+    template <class NormalSource>
+    double simulateVarianceQE(const hestonParameters& params, double timeToExperation, int numTimeSteps,
+                              NormalSource& normal)
+    {
+        const quadraticExponentialStep step = quadraticExponentialStepOf(params, timeToExperation / numTimeSteps);
+        const double rhoComplement = std::sqrt(1.0 - params.rho * params.rho);
+        double Vt = params.v0;
+
+        for (int i = 0; i < numTimeSteps; i++)
+        {
+            double Z1 = normal();
+            double Z2 = params.rho * Z1 + rhoComplement * normal();
+
+            const double m = step.mean + step.decay * Vt;
+            const double psi = (step.varianceSlope * Vt + step.varianceConstant) / (m * m);
+            if (!(m > 0.0))
+            {
+                Vt = 0.0;
+            }
+            else if (psi == 0.0)
+            {
+                Vt = m;
+            }
+            else if (psi <= 1.5)
+            {
+                // Moment-matched square of a shifted normal.
+                const double twoOverPsi = 2.0 / psi;
+                const double b2 = twoOverPsi - 1.0 + std::sqrt(twoOverPsi * (twoOverPsi - 1.0));
+                const double root = std::sqrt(b2) + Z2;
+                Vt = m / (1.0 + b2) * (root * root);
+            }
+            else
+            {
+                // Zero with probability p, else exponential: inverted from u = N(Z2), 1 - u = N(-Z2).
+                const double p = (psi - 1.0) / (psi + 1.0);
+                const double tail = normalCDF(-Z2);
+                Vt = tail >= 1.0 - p ? 0.0 : std::log((1.0 - p) / tail) * m / (1.0 - p);
+            }
+        }
+
+        return Vt;
+    }
+
+    template <class NormalSource>
+    double simulateVarianceWith(HestonDiscretization discretization, const hestonParameters& params,
+                                double timeToExperation, int numTimeSteps, NormalSource& normal)
+    {
+        return discretization == HESTON_QE ? simulateVarianceQE(params, timeToExperation, numTimeSteps, normal)
+                                           : simulateVariance(params, timeToExperation, numTimeSteps, normal);
+    }
+}
+
+/// @brief simulates the terminal variance with a full-truncation Euler or quadratic-exponential scheme.
+/// @param params
+/// @param timeToExperation
+/// @param numTimeSteps
+/// @param generator
+/// @param discretization
+/// @return Vt
+double hestonSimulateVariance(const hestonParameters& params, double timeToExperation, int numTimeSteps,
+                              std::mt19937& generator, HestonDiscretization discretization)
+{
+    std::normal_distribution<double> normalDist(0.0, 1.0);
+    auto normal = [&]() { return normalDist(generator); };
+    return simulateVarianceWith(discretization, params, timeToExperation, numTimeSteps, normal);
+}
+
+namespace
+{
+    /// @brief the number of streams of hestonPathsPerStream paths that cover numSimulations.
+    int pathStreamCount(int numSimulations)
+    {
+        return numSimulations > 0 ? (numSimulations + hestonPathsPerStream - 1) / hestonPathsPerStream : 0;
+    }
+
+    /// @brief runs work(stream, first, paths) for every stream of paths on threadCount workers, each worker
+    /// taking the next stream until none are left.
+    template <class StreamWork>
+    void forEachPathStream(int numSimulations, unsigned threadCount, StreamWork&& work)
+    {
+        const int streams = pathStreamCount(numSimulations);
+        if (threadCount == 0)
+        {
+            threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        threadCount = std::min(threadCount, static_cast<unsigned>(streams));
+
+        std::atomic<int> next{0};
+        auto worker = [&]() {
+            for (int stream = next.fetch_add(1); stream < streams; stream = next.fetch_add(1))
+            {
+                const int first = stream * hestonPathsPerStream;
+                work(stream, first, std::min(hestonPathsPerStream, numSimulations - first));
+            }
+        };
+
+        std::vector<std::thread> workers;
+        for (unsigned t = 1; t < threadCount; ++t)
+        {
+            workers.emplace_back(worker);
+        }
+        worker();
+        for (std::thread& thread : workers)
+        {
+            thread.join();
+        }
+    }
+
+    /// @brief the normals of the generator overloads: stream s draws its paths one after another from a
+    /// std::mt19937 seeded with (seed, s), whichever worker runs it.
+    class streamGeneratorNormals
+    {
+        public:
+            streamGeneratorNormals(std::uint64_t seed, int stream, int)
+            {
+                std::seed_seq sequence{static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(stream)};
+                _generator.seed(sequence);
+            }
+
+            void startPath(int) {}
+
+            double operator()() { return _distribution(_generator); }
+
+        private:
+            std::mt19937 _generator;
+            std::normal_distribution<double> _distribution{0.0, 1.0};
+    };
+
+    /// @brief the normals of the seed overloads: draw k of path p is a function of (seed, p, k) only. The
+    /// draws of a path are generated into a buffer at once by the vectorized kernel.
+    class counterNormals
+    {
+        public:
+            counterNormals(std::uint64_t seed, int, int drawsPerPath) : _seed(seed), _draws(drawsPerPath) {}
+
+            void startPath(int path)
+            {
+                philoxNormals(_seed, static_cast<std::uint64_t>(path), 0, _draws.size(), _draws.data());
+                _next = 0;
+            }
+
+            double operator()() { return _draws[_next++]; }
+
+        private:
+            std::uint64_t _seed;
+            std::vector<double> _draws;
+            std::size_t _next = 0;
+    };
+
+    /// @brief the Monte Carlo loop specialized on the option type and the normal CDF, so neither is
+    /// re-examined per path.
+    template <OptionType Type, NormalCDFMethod Method, class Normals>
+    double hestonMonteCarloPriceOf(double underlyingPrice, double strikePrice, double timeToExperation,
+                                   double riskFreeRate, const hestonParameters& params, int numSimulations,
+                                   int numTimeSteps, std::uint64_t seed, unsigned threadCount,
+                                   HestonDiscretization discretization)
+    {
+        std::vector<double> streamSums(pathStreamCount(numSimulations));
+        forEachPathStream(numSimulations, threadCount, [&](int stream, int first, int paths) {
+            Normals normals(seed, stream, 2 * numTimeSteps);
+            double optionPriceSum = 0.0;
+            for (int sim = 0; sim < paths; sim++)
+            {
+                normals.startPath(first + sim);
+                const double Vt = simulateVarianceWith(discretization, params, timeToExperation, numTimeSteps, normals);
+                const double simulatedVolatility = std::sqrt(Vt);
+
+                optionPriceSum += blackScholesPrice<Type, Method>(underlyingPrice, strikePrice, timeToExperation,
+                                                                  riskFreeRate, simulatedVolatility);
+            }
+            streamSums[stream] = optionPriceSum;
+        });
+
+        // Summed in stream order, so the result does not depend on the thread count.
+        double optionPriceSum = 0.0;
+        for (double streamSum : streamSums)
+        {
+            optionPriceSum += streamSum;
+        }
+        return optionPriceSum / numSimulations;
+    }
+
+    /// @brief picks the loop for the option type.
+    template <NormalCDFMethod Method, class Normals>
+    double hestonMonteCarloPriceWith(double underlyingPrice, double strikePrice, double timeToExperation,
+                                     double riskFreeRate, const hestonParameters& params, OptionType optionType,
+                                     int numSimulations, int numTimeSteps, std::uint64_t seed, unsigned threadCount,
+                                     HestonDiscretization discretization)
+    {
+        switch (optionType)
+        {
+            case CALL:
+                return hestonMonteCarloPriceOf<CALL, Method, Normals>(underlyingPrice, strikePrice, timeToExperation,
+                                                                      riskFreeRate, params, numSimulations,
+                                                                      numTimeSteps, seed, threadCount, discretization);
+            case PUT:
+                return hestonMonteCarloPriceOf<PUT, Method, Normals>(underlyingPrice, strikePrice, timeToExperation,
+                                                                     riskFreeRate, params, numSimulations,
+                                                                     numTimeSteps, seed, threadCount, discretization);
+            default:
+                return std::nan("");
+        }
+    }
+}
+
+namespace
+{
+    /// @brief picks the loop for the normal CDF.
+    template <class Normals>
+    double hestonMonteCarloPriceFrom(double underlyingPrice, double strikePrice, double timeToExperation,
+                                     double riskFreeRate, const hestonParameters& params, OptionType optionType,
+                                     int numSimulations, int numTimeSteps, std::uint64_t seed,
+                                     NormalCDFMethod cdfMethod, unsigned threadCount,
+                                     HestonDiscretization discretization)
+    {
+        if (cdfMethod == CDF_TABLE)
+        {
+            return hestonMonteCarloPriceWith<CDF_TABLE, Normals>(underlyingPrice, strikePrice, timeToExperation,
+                                                                 riskFreeRate, params, optionType, numSimulations,
+                                                                 numTimeSteps, seed, threadCount, discretization);
+        }
+        return hestonMonteCarloPriceWith<CDF_POLYNOMIAL, Normals>(underlyingPrice, strikePrice, timeToExperation,
+                                                                  riskFreeRate, params, optionType, numSimulations,
+                                                                  numTimeSteps, seed, threadCount, discretization);
+    }
+}
+
+namespace
+{
+    /// @brief the counter-based Monte Carlo loop: the terminal variances of a stream come from the path-blocked
+    /// hestonEulerVariance kernel, then are priced path by path.
+    template <OptionType Type, NormalCDFMethod Method>
+    double hestonMonteCarloPriceBlocked(double underlyingPrice, double strikePrice, double timeToExperation,
+                                        double riskFreeRate, const hestonParameters& params, int numSimulations,
+                                        int numTimeSteps, std::uint64_t seed, unsigned threadCount,
+                                        HestonDiscretization discretization)
+    {
+        const simdKernelTable& kernels = simdKernels();
+        const double dt = timeToExperation / numTimeSteps;
+        const quadraticExponentialStep step = quadraticExponentialStepOf(params, dt);
+
+        std::vector<double> streamSums(pathStreamCount(numSimulations));
+        forEachPathStream(numSimulations, threadCount, [&](int stream, int first, int paths) {
+            std::array<double, hestonPathsPerStream> variance;
+            if (discretization == HESTON_QE)
+            {
+                kernels.hestonQEVariance(seed, static_cast<std::uint64_t>(first), paths, params.v0, step.decay,
+                                         step.mean, step.varianceSlope, step.varianceConstant, params.rho,
+                                         numTimeSteps, variance.data());
+            }
+            else
+            {
+                kernels.hestonEulerVariance(seed, static_cast<std::uint64_t>(first), paths, params.v0, params.kappa,
+                                            params.theta, params.sigma, params.rho, dt, numTimeSteps, variance.data());
+            }
+
+            // Full truncation leaves many variances at exactly zero, which the scalar price handles.
+            double optionPriceSum = 0.0;
+            for (int sim = 0; sim < paths; sim++)
+            {
+                optionPriceSum += blackScholesPrice<Type, Method>(underlyingPrice, strikePrice, timeToExperation,
+                                                                  riskFreeRate, std::sqrt(variance[sim]));
+            }
+            streamSums[stream] = optionPriceSum;
+        });
+
+        // Summed in stream order, so the result does not depend on the thread count.
+        double optionPriceSum = 0.0;
+        for (double streamSum : streamSums)
+        {
+            optionPriceSum += streamSum;
+        }
+        return optionPriceSum / numSimulations;
+    }
+
+    /// @brief picks the blocked loop for the option type and the normal CDF.
+    template <NormalCDFMethod Method>
+    double hestonMonteCarloPriceBlockedWith(double underlyingPrice, double strikePrice, double timeToExperation,
+                                            double riskFreeRate, const hestonParameters& params,
+                                            OptionType optionType, int numSimulations, int numTimeSteps,
+                                            std::uint64_t seed, unsigned threadCount,
+                                            HestonDiscretization discretization)
+    {
+        switch (optionType)
+        {
+            case CALL:
+                return hestonMonteCarloPriceBlocked<CALL, Method>(underlyingPrice, strikePrice, timeToExperation,
+                                                                  riskFreeRate, params, numSimulations, numTimeSteps,
+                                                                  seed, threadCount, discretization);
+            case PUT:
+                return hestonMonteCarloPriceBlocked<PUT, Method>(underlyingPrice, strikePrice, timeToExperation,
+                                                                 riskFreeRate, params, numSimulations, numTimeSteps,
+                                                                 seed, threadCount, discretization);
+            default:
+                return std::nan("");
+        }
+    }
+}
+
+/// @brief prices with the Black-Scholes formula averaged over simulated terminal volatilities.
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param params
+/// @param optionType
+/// @param numSimulations
+/// @param numTimeSteps
+/// @param generator
+/// @param cdfMethod
+/// @param threadCount
+/// @param discretization
+/// @return the option price.
+double hestonMonteCarloPrice(double underlyingPrice, double strikePrice, double timeToExperation, double riskFreeRate,
+                             const hestonParameters& params, OptionType optionType, int numSimulations,
+                             int numTimeSteps, std::mt19937& generator, NormalCDFMethod cdfMethod,
+                             unsigned threadCount, HestonDiscretization discretization)
+{
+    const std::uint32_t seed = static_cast<std::uint32_t>(generator());
+    return hestonMonteCarloPriceFrom<streamGeneratorNormals>(underlyingPrice, strikePrice, timeToExperation,
+                                                             riskFreeRate, params, optionType, numSimulations,
+                                                             numTimeSteps, seed, cdfMethod, threadCount, discretization);
+}
+
+/// @brief prices with the Black-Scholes formula averaged over simulated terminal volatilities, with the
+/// counter-based normals of seed.
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param params
+/// @param optionType
+/// @param numSimulations
+/// @param numTimeSteps
+/// @param seed
+/// @param cdfMethod
+/// @param threadCount
+/// @param discretization
+/// @return the option price.
+double hestonMonteCarloPrice(double underlyingPrice, double strikePrice, double timeToExperation, double riskFreeRate,
+                             const hestonParameters& params, OptionType optionType, int numSimulations,
+                             int numTimeSteps, std::uint64_t seed, NormalCDFMethod cdfMethod, unsigned threadCount,
+                             HestonDiscretization discretization)
+{
+    if (cdfMethod == CDF_TABLE)
+    {
+        return hestonMonteCarloPriceBlockedWith<CDF_TABLE>(underlyingPrice, strikePrice, timeToExperation,
+                                                           riskFreeRate, params, optionType, numSimulations,
+                                                           numTimeSteps, seed, threadCount, discretization);
+    }
+    return hestonMonteCarloPriceBlockedWith<CDF_POLYNOMIAL>(underlyingPrice, strikePrice, timeToExperation,
+                                                            riskFreeRate, params, optionType, numSimulations,
+                                                            numTimeSteps, seed, threadCount, discretization);
+}
+
+namespace
+{
+    /// @brief the simulation and adjoint sweep of hestonMonteCarloSensitivities, specialized on the option type.
+    template <OptionType Type, class Normals>
+    hestonSensitivities hestonMonteCarloSensitivitiesOf(double underlyingPrice, double strikePrice,
+                                                        double timeToExperation, double riskFreeRate,
+                                                        const hestonParameters& params, int numSimulations,
+                                                        int numTimeSteps, std::uint64_t seed, unsigned threadCount)
+    {
+        constexpr int block = hestonAdjointBlockPaths;
+        const double dt = timeToExperation / numTimeSteps;
+        const double rhoComplement = std::sqrt(1.0 - params.rho * params.rho);
+        // d rhoComplement / d rho, unbounded at |rho| = 1: there the rho sensitivity is NaN by design and the
+        // slope is set to 0 so the sweep stays finite for the other sensitivities.
+        const bool rhoDifferentiable = rhoComplement > 0.0;
+        const double rhoComplementSlope = rhoDifferentiable ? -params.rho / rhoComplement : 0.0;
+
+        std::vector<hestonSensitivities> streamSums(pathStreamCount(numSimulations));
+        forEachPathStream(numSimulations, threadCount, [&](int stream, int streamFirst, int streamPaths) {
+            Normals normals(seed, stream, 2 * numTimeSteps);
+
+            // The tape, step-major so the backward sweep runs across the paths of a block: variance[i * block + p]
+            // is v_i of path p, shock the correlated normal of step i and shockSlope its derivative in rho.
+            std::vector<double> variance((numTimeSteps + 1) * block);
+            std::vector<double> shock(numTimeSteps * block);
+            std::vector<double> shockSlope(numTimeSteps * block);
+
+            // Per-path adjoints: dV/dv_i during the sweep, and the parameter derivatives summed over the steps.
+            std::vector<double> varianceAdjoint(block), kappaAdjoint(block), thetaAdjoint(block), sigmaAdjoint(block),
+                                rhoAdjoint(block);
+
+            hestonSensitivities sums = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+            for (int first = 0; first < streamPaths; first += block)
+            {
+                const int paths = std::min(block, streamPaths - first);
+
+                // Forward: the steps of hestonSimulateVariance, path by path.
+                for (int p = 0; p < paths; p++)
+                {
+                    normals.startPath(streamFirst + first + p);
+                    double Vt = params.v0;
+                    variance[p] = Vt;
+                    for (int i = 0; i < numTimeSteps; i++)
+                    {
+                        const double Z1 = normals();
+                        const double independent = normals();
+                        const double Z2 = params.rho * Z1 + rhoComplement * independent;
+
+                        Vt += params.kappa * (params.theta - std::max(0.0, Vt)) * dt + params.sigma * std::sqrt(std::max(0.0, Vt) * dt) * Z2;
+                        Vt = std::max(0.0, Vt);
+
+                        shock[i * block + p] = Z2;
+                        shockSlope[i * block + p] = Z1 + rhoComplementSlope * independent;
+                        variance[(i + 1) * block + p] = Vt;
+                    }
+
+                    const double simulatedVolatility = std::sqrt(Vt);
+                    const blackScholesGreeks greeks = blackScholesPriceAndGreeks<Type, GREEK_PRICE | GREEK_DELTA | GREEK_VEGA | GREEK_RHO>(
+                        underlyingPrice, strikePrice, timeToExperation, riskFreeRate, simulatedVolatility);
+                    sums.price += greeks.price;
+                    sums.delta += greeks.delta;
+                    sums.riskFreeRate += greeks.rho;
+
+                    // dV/dv_T = vega dvol/dv_T; a path absorbed at zero has no variance sensitivity.
+                    varianceAdjoint[p] = simulatedVolatility > 0.0 ? greeks.vega / (2.0 * simulatedVolatility) : 0.0;
+                    kappaAdjoint[p] = thetaAdjoint[p] = sigmaAdjoint[p] = rhoAdjoint[p] = 0.0;
+                }
+
+                // Backward: v_{i+1} = max(0, v_i + kappa (theta - v_i) dt + sigma sqrt(v_i dt) Z2), with v_i >= 0.
+                for (int i = numTimeSteps - 1; i >= 0; i--)
+                {
+                    const double* stepVariance = &variance[i * block];
+                    const double* nextVariance = &variance[(i + 1) * block];
+                    const double* stepShock = &shock[i * block];
+                    const double* stepShockSlope = &shockSlope[i * block];
+                    for (int p = 0; p < paths; p++)
+                    {
+                        const double v = stepVariance[p];
+                        const double adjoint = nextVariance[p] > 0.0 ? varianceAdjoint[p] : 0.0;
+                        const double diffusion = std::sqrt(v * dt);
+                        const double shockAdjoint = adjoint * params.sigma * diffusion;
+
+                        kappaAdjoint[p] += adjoint * (params.theta - v) * dt;
+                        thetaAdjoint[p] += adjoint * params.kappa * dt;
+                        sigmaAdjoint[p] += adjoint * diffusion * stepShock[p];
+                        rhoAdjoint[p] += shockAdjoint * stepShockSlope[p];
+                        // d sqrt(v dt) / dv is taken as 0 at v = 0, where the path was truncated.
+                        const double diffusionSlope = v > 0.0 ? 0.5 * dt / diffusion : 0.0;
+                        varianceAdjoint[p] = adjoint * (1.0 - params.kappa * dt + params.sigma * stepShock[p] * diffusionSlope);
+                    }
+                }
+
+                for (int p = 0; p < paths; p++)
+                {
+                    sums.v0 += varianceAdjoint[p];
+                    sums.kappa += kappaAdjoint[p];
+                    sums.theta += thetaAdjoint[p];
+                    sums.sigma += sigmaAdjoint[p];
+                    sums.rho += rhoAdjoint[p];
+                }
+            }
+            streamSums[stream] = sums;
+        });
+
+        // Summed in stream order, so the result does not depend on the thread count.
+        hestonSensitivities sums = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+        for (const hestonSensitivities& streamSum : streamSums)
+        {
+            sums.price += streamSum.price;
+            sums.delta += streamSum.delta;
+            sums.riskFreeRate += streamSum.riskFreeRate;
+            sums.v0 += streamSum.v0;
+            sums.kappa += streamSum.kappa;
+            sums.theta += streamSum.theta;
+            sums.sigma += streamSum.sigma;
+            sums.rho += streamSum.rho;
+        }
+
+        const double scale = 1.0 / numSimulations;
+        return {sums.price * scale, sums.delta * scale, sums.riskFreeRate * scale, sums.v0 * scale,
+                sums.kappa * scale, sums.theta * scale, sums.sigma * scale,
+                rhoDifferentiable ? sums.rho * scale : std::numeric_limits<double>::quiet_NaN()};
+    }
+}
+
+namespace
+{
+    /// @brief picks the adjoint for the option type.
+    template <class Normals>
+    hestonSensitivities hestonMonteCarloSensitivitiesFrom(double underlyingPrice, double strikePrice,
+                                                          double timeToExperation, double riskFreeRate,
+                                                          const hestonParameters& params, OptionType optionType,
+                                                          int numSimulations, int numTimeSteps, std::uint64_t seed,
+                                                          unsigned threadCount)
+    {
+        switch (optionType)
+        {
+            case CALL:
+                return hestonMonteCarloSensitivitiesOf<CALL, Normals>(underlyingPrice, strikePrice, timeToExperation,
+                                                                      riskFreeRate, params, numSimulations,
+                                                                      numTimeSteps, seed, threadCount);
+            case PUT:
+                return hestonMonteCarloSensitivitiesOf<PUT, Normals>(underlyingPrice, strikePrice, timeToExperation,
+                                                                     riskFreeRate, params, numSimulations,
+                                                                     numTimeSteps, seed, threadCount);
+            default:
+            {
+                const double nan = std::nan("");
+                return {nan, nan, nan, nan, nan, nan, nan, nan};
+            }
+        }
+    }
+}
+
+/// @brief prices with hestonMonteCarloPrice and differentiates the simulation by its adjoint.
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param params
+/// @param optionType
+/// @param numSimulations
+/// @param numTimeSteps
+/// @param generator
+/// @param threadCount
+/// @return the price and its sensitivities.
+hestonSensitivities hestonMonteCarloSensitivities(double underlyingPrice, double strikePrice, double timeToExperation,
+                                                  double riskFreeRate, const hestonParameters& params,
+                                                  OptionType optionType, int numSimulations, int numTimeSteps,
+                                                  std::mt19937& generator, unsigned threadCount)
+{
+    const std::uint32_t seed = static_cast<std::uint32_t>(generator());
+    return hestonMonteCarloSensitivitiesFrom<streamGeneratorNormals>(underlyingPrice, strikePrice, timeToExperation,
+                                                                     riskFreeRate, params, optionType, numSimulations,
+                                                                     numTimeSteps, seed, threadCount);
+}
+
+/// @brief prices with the counter-based hestonMonteCarloPrice and differentiates the simulation by its adjoint.
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param params
+/// @param optionType
+/// @param numSimulations
+/// @param numTimeSteps
+/// @param seed
+/// @param threadCount
+/// @return the price and its sensitivities.
+hestonSensitivities hestonMonteCarloSensitivities(double underlyingPrice, double strikePrice, double timeToExperation,
+                                                  double riskFreeRate, const hestonParameters& params,
+                                                  OptionType optionType, int numSimulations, int numTimeSteps,
+                                                  std::uint64_t seed, unsigned threadCount)
+{
+    return hestonMonteCarloSensitivitiesFrom<counterNormals>(underlyingPrice, strikePrice, timeToExperation,
+                                                             riskFreeRate, params, optionType, numSimulations,
+                                                             numTimeSteps, seed, threadCount);
+}
+
+/// @brief prices from the Heston characteristic function.
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param params
+/// @return the option price.
+double hestonCharacteristicPrice(double underlyingPrice, double strikePrice, double timeToExperation,
+                                 double riskFreeRate, const hestonParameters& params)
+{
+    //TODO: Incorporate variance / volatility into the characteristic function.
+    const double pi = std::numbers::pi;
+    const std::complex<double> i(0, 1);
+
+    const auto alpha = [&](std::complex<double> u) -> std::complex<double> {
+        return -u * u * 0.5 - i * u * params.kappa * params.theta;
+    };
+
+    const auto beta = [&](std::complex<double> u) -> std::complex<double> {
+        return params.kappa - params.rho * params.sigma * i * u;
+    };
+
+    const auto gamma = [&](std::complex<double> u) -> std::complex<double> {
+        return params.sigma * params.sigma * 0.5;
+    };
+
+    const auto D = [&](std::complex<double> u) -> std::complex<double> {
+        return std::sqrt(beta(u) * beta(u) - 4.0 * alpha(u) * gamma(u));
+    };
+
+    const auto G = [&](std::complex<double> u) -> std::complex<double> {
+        return (beta(u) - D(u)) / (beta(u) + D(u));
+    };
+
+    const auto C = [&](std::complex<double> u) -> std::complex<double> {
+        return params.kappa * (params.theta * timeToExperation * (beta(u) - D(u)) - 2.0 * std::log((1.0 - G(u) * std::exp(-D(u) * timeToExperation)) / (1.0 - G(u))));
+    };
+
+    const auto characteristicFunction = [&](std::complex<double> u) -> std::complex<double> {
+        return std::exp(C(u) + params.v0 * (beta(u) - D(u)) * (1.0 - std::exp(-D(u) * timeToExperation)) / (1.0 - G(u) * std::exp(-D(u) * timeToExperation)));
+    };
+
+    const auto integrand = [&](double phi) -> double {
+        std::complex<double> u(phi, -0.5);
+        std::complex<double> numerator = std::exp(i * u * std::log(underlyingPrice / strikePrice)) * characteristicFunction(u);
+        std::complex<double> denominator = i * u;
+        return std::real(numerator / denominator);
+    };
+
+    const auto adaptiveIntegrate = [&](double lower, double upper, int maxSteps) -> double {
+        double result = 0.0;
+        double step = (upper - lower) / maxSteps;
+        for (int j = 0; j < maxSteps; ++j) {
+            double phi1 = lower + j * step;
+            double phi2 = phi1 + step;
+            result += (integrand(phi1) + integrand(phi2)) * step / 2.0; // Trapezoidal rule
+        }
+        return result;
+    };
+
+    double integral = adaptiveIntegrate(0.0, 100.0, 1000);
+    return underlyingPrice - strikePrice * std::exp(-riskFreeRate * timeToExperation) * integral / pi;
+}
+
+/// @brief averages the Black-Scholes price over the noncentral chi-square law of the terminal variance.
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param params
+/// @param optionType
+/// @return the option price.
+double hestonTerminalVariancePrice(double underlyingPrice, double strikePrice, double timeToExperation,
+                                   double riskFreeRate, const hestonParameters& params, OptionType optionType)
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    if ((optionType != CALL && optionType != PUT) || !(params.kappa > 0.0) || !(params.theta > 0.0))
+    {
+        return nan;
+    }
+
+    // Full truncation prices a zero variance too; the limit is the discounted intrinsic value.
+    const double discountedStrike = strikePrice * std::exp(-riskFreeRate * timeToExperation);
+    const double sign = optionType == CALL ? 1.0 : -1.0;
+    const auto price = [&](double variance) {
+        return variance > 0.0 ? blackScholesPrice(underlyingPrice, strikePrice, timeToExperation, riskFreeRate,
+                                                  std::sqrt(variance), optionType)
+                              : std::max(sign * (underlyingPrice - discountedStrike), 0.0);
+    };
+
+    const double decay = std::exp(-params.kappa * timeToExperation);
+    if (params.sigma == 0.0)
+    {
+        return price(params.theta + (params.v0 - params.theta) * decay);
+    }
+
+    const double sigma2 = params.sigma * params.sigma;
+    const double growth = -std::expm1(-params.kappa * timeToExperation);
+    const double scale = sigma2 * growth / (4.0 * params.kappa);
+    const double halfDegrees = 2.0 * params.kappa * params.theta / sigma2;
+    const double halfNoncentrality = 2.0 * params.kappa * decay * params.v0 / (sigma2 * growth);
+
+    // Poisson(halfNoncentrality) weights of the central densities of 2 (halfDegrees + n) degrees of freedom,
+    // each with its normalization folded in, as logarithms; terms beyond 12 deviations are dropped.
+    const double spread = 12.0 * std::sqrt(halfNoncentrality) + 20.0;
+    const int firstTerm = static_cast<int>(std::max(0.0, halfNoncentrality - spread));
+    const int lastTerm = static_cast<int>(halfNoncentrality + spread);
+    std::vector<double> logWeight(lastTerm - firstTerm + 1);
+    for (int n = firstTerm; n <= lastTerm; ++n)
+    {
+        const double logPoisson = n == 0 ? -halfNoncentrality
+                                         : -halfNoncentrality + n * std::log(halfNoncentrality) - std::lgamma(n + 1.0);
+        logWeight[n - firstTerm] = logPoisson - (halfDegrees + n) * std::numbers::ln2 - std::lgamma(halfDegrees + n);
+    }
+
+    // The density times x^{power - halfDegrees + 1}: power = halfDegrees - 1 is the density itself, power = 0
+    // is finite at zero. Summed in logarithms, as the factors alone overflow for large degrees of freedom.
+    const auto density = [&](double x, double power) {
+        if (x == 0.0)
+        {
+            return firstTerm == 0 && power == 0.0 ? std::exp(logWeight[0]) : 0.0;
+        }
+        const double logX = std::log(x);
+        double sum = 0.0;
+        for (int n = firstTerm; n <= lastTerm; ++n)
+        {
+            sum += std::exp(logWeight[n - firstTerm] + (power + n) * logX - 0.5 * x);
+        }
+        return sum;
+    };
+
+    const auto simpson = [](auto integrand, double lower, double upper, int intervals) {
+        const double step = (upper - lower) / intervals;
+        double sum = integrand(lower) + integrand(upper);
+        for (int j = 1; j < intervals; ++j)
+        {
+            sum += (j % 2 == 1 ? 4.0 : 2.0) * integrand(lower + j * step);
+        }
+        return sum * step / 3.0;
+    };
+
+    // X has mean d + lambda and variance 2 (d + 2 lambda); the body is integrated over 12 deviations of it.
+    const double mean = 2.0 * (halfDegrees + halfNoncentrality);
+    const double deviation = std::sqrt(4.0 * (halfDegrees + 2.0 * halfNoncentrality));
+    const double split = std::min(1.0, 0.25 * mean);
+    const double lower = std::max(split, mean - 12.0 * deviation);
+    const double upper = mean + 12.0 * deviation + 20.0;
+
+    // Below the split x = s^{1 / halfDegrees}, whose Jacobian cancels the power of the density.
+    const double nearZero = simpson(
+        [&](double s) {
+            const double x = std::pow(s, 1.0 / halfDegrees);
+            return price(scale * x) * density(x, 0.0) / halfDegrees;
+        },
+        0.0, std::pow(split, halfDegrees), 400);
+    const double body = simpson(
+        [&](double x) { return price(scale * x) * density(x, halfDegrees - 1.0); },
+        lower, upper, 4000);
+    return nearZero + body;
+}
@@ -0,0 +1,45 @@
+#include <algorithm>
+#include "../include/randomNormals.h"
+#include "../include/cpuDispatch.h"
+
+/// @brief generates the normal pairs of counters (stream, index + k) with the dispatched kernel.
+/// @param seed
+/// @param stream
+/// @param index
+/// @param count
+/// @param first
+/// @param second
+void philoxNormalPairs(std::uint64_t seed, std::uint64_t stream, std::uint64_t index, std::size_t count,
+                       double* first, double* second)
+{
+    simdKernels().philoxNormalPairs(seed, stream, index, count, first, second);
+}
+
+/// @brief generates the pairs in chunks on the stack and interleaves them into output.
+/// @param seed
+/// @param stream
+/// @param firstPair
+/// @param count
+/// @param output
+void philoxNormals(std::uint64_t seed, std::uint64_t stream, std::uint64_t firstPair, std::size_t count,
+                   double* output)
+{
+    constexpr std::size_t chunk = 256;
+    double first[chunk], second[chunk];
+    const std::size_t pairs = (count + 1) / 2;
+    for (std::size_t start = 0; start < pairs; start += chunk)
+    {
+        const std::size_t n = std::min(chunk, pairs - start);
+        simdKernels().philoxNormalPairs(seed, stream, firstPair + start, n, first, second);
+        double* out = output + 2 * start;
+        const std::size_t remaining = count - 2 * start;
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            out[2 * k] = first[k];
+            if (2 * k + 1 < remaining)
+            {
+                out[2 * k + 1] = second[k];
+            }
+        }
+    }
+}
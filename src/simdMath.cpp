@@ -0,0 +1,222 @@
+#include "../include/simdMath.h"
+#include "../include/simdKernels.h"
+
+//  Scalar level: the shared kernels instantiated one element at a time, usable on any CPU.
+namespace simd::scalar
+{
+    /// @brief N(x) for every element of x.
+    /// @param x
+    /// @param result
+    /// @param count
+    void normalCDF(const double* x, double* result, std::size_t count)
+    {
+        normalCDFArray<vec>(x, result, count);
+    }
+
+    /// @brief e^x for every element of x.
+    /// @param x
+    /// @param result
+    /// @param count
+    void exp(const double* x, double* result, std::size_t count)
+    {
+        expArray<vec>(x, result, count);
+    }
+
+    /// @brief ln(x) for every element of x.
+    /// @param x
+    /// @param result
+    /// @param count
+    void log(const double* x, double* result, std::size_t count)
+    {
+        logArray<vec>(x, result, count);
+    }
+
+    /// @brief Black-Scholes prices for count options stored as structure-of-arrays.
+    void blackScholesPrice(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                           const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                           const OptionType* optionType, double* optionPrice)
+    {
+        blackScholesPriceArray<vec>(count, underlyingPrice, strikePrice, timeToExperation, riskFreeRate, volatility,
+                                    optionType, optionPrice);
+    }
+
+    /// @brief Black-Scholes prices and first-order Greeks for count options stored as structure-of-arrays.
+    void blackScholesGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                            const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                            const OptionType* optionType, double* optionPrice, double* delta, double* gamma,
+                            double* vega, double* theta, double* rho)
+    {
+        blackScholesGreeksArray<vec>(count, underlyingPrice, strikePrice, timeToExperation, riskFreeRate, volatility,
+                                     optionType, optionPrice, delta, gamma, vega, theta, rho);
+    }
+
+    /// @brief Black-Scholes prices for count options of type Type.
+    template <OptionType Type>
+    void blackScholesPriceOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                             const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                             double* optionPrice)
+    {
+        blackScholesPriceArrayOf<vec, Type>(count, underlyingPrice, strikePrice, timeToExperation, riskFreeRate,
+                                            volatility, optionPrice);
+    }
+
+    /// @brief Black-Scholes prices and first-order Greeks for count options of type Type.
+    template <OptionType Type>
+    void blackScholesGreeksOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                              const double* timeToExperation, const double* riskFreeRate, const double* volatility,
+                              double* optionPrice, double* delta, double* gamma, double* vega, double* theta,
+                              double* rho)
+    {
+        blackScholesGreeksArrayOf<vec, Type, GREEK_ALL>(count, underlyingPrice, strikePrice, timeToExperation,
+                                                        riskFreeRate, volatility, optionPrice, delta, gamma, vega,
+                                                        theta, rho);
+    }
+
+    template void blackScholesPriceOf<CALL>(std::size_t, const double*, const double*, const double*, const double*,
+                                            const double*, double*);
+    template void blackScholesPriceOf<PUT>(std::size_t, const double*, const double*, const double*, const double*,
+                                           const double*, double*);
+    template void blackScholesGreeksOf<CALL>(std::size_t, const double*, const double*, const double*, const double*,
+                                             const double*, double*, double*, double*, double*, double*, double*);
+    template void blackScholesGreeksOf<PUT>(std::size_t, const double*, const double*, const double*, const double*,
+                                            const double*, double*, double*, double*, double*, double*, double*);
+
+    /// @brief N(x) for every element of x, in float.
+    void normalCDFFloat(const float* x, float* result, std::size_t count)
+    {
+        normalCDFArrayF<vecf>(x, result, count);
+    }
+
+    /// @brief e^x for every element of x, in float.
+    void expFloat(const float* x, float* result, std::size_t count)
+    {
+        expArrayF<vecf>(x, result, count);
+    }
+
+    /// @brief ln(x) for every element of x, in float.
+    void logFloat(const float* x, float* result, std::size_t count)
+    {
+        logArrayF<vecf>(x, result, count);
+    }
+
+    /// @brief Black-Scholes prices and their estimated relative errors for count options, in float.
+    void blackScholesPriceFloat(std::size_t count, const float* underlyingPrice, const float* strikePrice,
+                                const float* timeToExperation, const float* riskFreeRate, const float* volatility,
+                                const OptionType* optionType, float* optionPrice, float* relativeError)
+    {
+        blackScholesPriceArrayF<vecf>(count, underlyingPrice, strikePrice, timeToExperation, riskFreeRate, volatility,
+                                      optionType, optionPrice, relativeError);
+    }
+
+    /// @brief N(x) for every element of x, from the interpolation table.
+    void normalCDFTabulated(const double* x, double* result, std::size_t count)
+    {
+        normalCDFTableArray<vec>(x, result, count);
+    }
+
+    /// @brief Black-Scholes prices for count options, with N(x) from the interpolation table.
+    void blackScholesPriceTabulated(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                    const double* timeToExperation, const double* riskFreeRate,
+                                    const double* volatility, const OptionType* optionType, double* optionPrice)
+    {
+        blackScholesPriceArray<vec, CDF_TABLE>(count, underlyingPrice, strikePrice, timeToExperation, riskFreeRate,
+                                               volatility, optionType, optionPrice);
+    }
+
+    /// @brief Black-Scholes prices for count options of type Type, with N(x) from the interpolation table.
+    template <OptionType Type>
+    void blackScholesPriceTabulatedOf(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                      const double* timeToExperation, const double* riskFreeRate,
+                                      const double* volatility, double* optionPrice)
+    {
+        blackScholesPriceArrayOf<vec, Type, CDF_TABLE>(count, underlyingPrice, strikePrice, timeToExperation,
+                                                       riskFreeRate, volatility, optionPrice);
+    }
+
+    template void blackScholesPriceTabulatedOf<CALL>(std::size_t, const double*, const double*, const double*,
+                                                     const double*, const double*, double*);
+    template void blackScholesPriceTabulatedOf<PUT>(std::size_t, const double*, const double*, const double*,
+                                                    const double*, const double*, double*);
+
+    /// @brief Black-Scholes prices for count strikes of one expiry.
+    void blackScholesChainPrice(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                std::size_t count, const double* strikePrice, const double* volatility,
+                                const OptionType* optionType, double* optionPrice)
+    {
+        blackScholesChainArray<vec, GREEK_PRICE>(underlyingPrice, timeToExperation, riskFreeRate, count, strikePrice,
+                                                 volatility, optionType, optionPrice, nullptr, nullptr, nullptr,
+                                                 nullptr, nullptr);
+    }
+
+    /// @brief Black-Scholes prices and first-order Greeks for count strikes of one expiry.
+    void blackScholesChainGreeks(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                 std::size_t count, const double* strikePrice, const double* volatility,
+                                 const OptionType* optionType, double* optionPrice, double* delta, double* gamma,
+                                 double* vega, double* theta, double* rho)
+    {
+        blackScholesChainArray<vec, GREEK_ALL>(underlyingPrice, timeToExperation, riskFreeRate, count, strikePrice,
+                                               volatility, optionType, optionPrice, delta, gamma, vega, theta, rho);
+    }
+
+    /// @brief Implied volatilities of count options of mixed type; iterations may be null.
+    void impliedVolatility(std::size_t count, const double* optionPrice, const double* underlyingPrice,
+                           const double* strikePrice, const double* timeToExperation, const double* riskFreeRate,
+                           const OptionType* optionType, double* volatility, std::uint8_t* iterations)
+    {
+        impliedVolatilityArray<vec>(count, optionPrice, underlyingPrice, strikePrice, timeToExperation, riskFreeRate,
+                                    optionType, volatility, iterations);
+    }
+
+    /// @brief Warm-started implied volatilities of count strikes of one expiry; previousVolatility and iterations may be null.
+    void impliedVolatilityChain(double underlyingPrice, double timeToExperation, double riskFreeRate,
+                                std::size_t count, const double* optionPrice, const double* strikePrice,
+                                const OptionType* optionType, const double* previousVolatility, double* volatility,
+                                std::uint8_t* iterations)
+    {
+        impliedVolatilityChainArray<vec>(underlyingPrice, timeToExperation, riskFreeRate, count, optionPrice,
+                                         strikePrice, optionType, previousVolatility, volatility, iterations);
+    }
+
+    /// @brief Volatilities of count options from the SVI surface packed in sliceTable.
+    void sviVolatility(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                       const double* timeToExperation, const double* riskFreeRate, std::size_t sliceCount,
+                       const double* sliceTable, double* volatility)
+    {
+        sviVolatilityArray<vec>(count, underlyingPrice, strikePrice, timeToExperation, riskFreeRate, sliceCount,
+                                sliceTable, volatility);
+    }
+
+    /// @brief The price, Greeks and adjusted Greeks selected by greeks for a batch, into output[greekIndex(bit)].
+    void blackScholesSelectedGreeks(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                    const double* timeToExperation, const double* riskFreeRate,
+                                    const double* volatility, const OptionType* optionType, unsigned greeks,
+                                    double* const* output)
+    {
+        blackScholesSelectedGreeksArray<vec>(count, underlyingPrice, strikePrice, timeToExperation, riskFreeRate,
+                                             volatility, optionType, greeks, output);
+    }
+
+    /// @brief The Philox normal pairs of counters (stream, index + k) of seed.
+    void philoxNormalPairs(std::uint64_t seed, std::uint64_t stream, std::uint64_t index, std::size_t count,
+                           double* first, double* second)
+    {
+        philoxNormalPairsArray<vec, vecu>(seed, stream, index, count, first, second);
+    }
+
+    /// @brief The Heston full-truncation Euler variances of paths firstPath + k of seed.
+    void hestonEulerVariance(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0, double kappa,
+                             double theta, double sigma, double rho, double dt, int numTimeSteps, double* variance)
+    {
+        hestonEulerVarianceArray<vec, vecu>(seed, firstPath, count, v0, kappa, theta, sigma, rho, dt, numTimeSteps,
+                                            variance);
+    }
+
+    /// @brief The Heston quadratic-exponential variances of paths firstPath + k of seed.
+    void hestonQEVariance(std::uint64_t seed, std::uint64_t firstPath, std::size_t count, double v0, double decay,
+                          double mean, double varianceSlope, double varianceConstant, double rho, int numTimeSteps,
+                          double* variance)
+    {
+        hestonQEVarianceArray<vec, vecu>(seed, firstPath, count, v0, decay, mean, varianceSlope, varianceConstant, rho,
+                                         numTimeSteps, variance);
+    }
+}
@@ -0,0 +1,521 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <numbers>
+#include "../include/volatilitySurface.h"
+#include "../include/impliedVolatility.h"
+#include "../include/cpuDispatch.h"
+
+/// @brief raw SVI total variance.
+/// @param logMoneyness
+/// @return w(k)
+double sviParameters::totalVariance(double logMoneyness) const
+{
+    const double x = logMoneyness - m;
+    return a + b * (rho * x + std::sqrt(x * x + sigma * sigma));
+}
+
+namespace
+{
+    /// @brief the best (a, d, c) of w = a + d y + c sqrt(y^2 + 1), y = (k - m) / sigma, for fixed (m, sigma).
+    struct sviInnerFit
+    {
+        double a = 0.0;
+        double d = 0.0;
+        double c = 0.0;
+        double error = std::numeric_limits<double>::infinity();
+    };
+
+    /// @brief solves the 3x3 system A x = r by Gaussian elimination with partial pivoting.
+    /// @param A
+    /// @param r
+    /// @param x
+    /// @return false if A is singular.
+    bool solve3(std::array<std::array<double, 3>, 3> A, std::array<double, 3> r, std::array<double, 3>& x)
+    {
+        for (int col = 0; col < 3; ++col)
+        {
+            int pivot = col;
+            for (int row = col + 1; row < 3; ++row)
+            {
+                if (std::abs(A[row][col]) > std::abs(A[pivot][col]))
+                {
+                    pivot = row;
+                }
+            }
+            if (!(std::abs(A[pivot][col]) > 1e-300))
+            {
+                return false;
+            }
+            std::swap(A[col], A[pivot]);
+            std::swap(r[col], r[pivot]);
+            for (int row = col + 1; row < 3; ++row)
+            {
+                const double factor = A[row][col] / A[col][col];
+                for (int k = col; k < 3; ++k)
+                {
+                    A[row][k] -= factor * A[col][k];
+                }
+                r[row] -= factor * r[col];
+            }
+        }
+        for (int row = 2; row >= 0; --row)
+        {
+            double sum = r[row];
+            for (int k = row + 1; k < 3; ++k)
+            {
+                sum -= A[row][k] * x[k];
+            }
+            x[row] = sum / A[row][row];
+        }
+        return true;
+    }
+
+    /// @brief the weighted least-squares (a, d, c) for fixed (m, sigma), projected on the region
+    ///        0 <= a, |d| <= c, c + |d| <= 2 sigma, where w > 0 and the wings obey Lee's moment bound.
+    /// @param slice
+    /// @param m
+    /// @param sigma
+    /// @return the fit and its weighted squared error.
+    sviInnerFit fitInner(const volatilitySlice& slice, double m, double sigma)
+    {
+        const std::size_t n = slice.logMoneyness.size();
+        std::array<std::array<double, 3>, 3> A{};
+        std::array<double, 3> r{};
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double y = (slice.logMoneyness[i] - m) / sigma;
+            const double basis[3] = {1.0, y, std::sqrt(y * y + 1.0)};
+            for (int p = 0; p < 3; ++p)
+            {
+                for (int q = 0; q < 3; ++q)
+                {
+                    A[p][q] += slice.weight[i] * basis[p] * basis[q];
+                }
+                r[p] += slice.weight[i] * basis[p] * slice.totalVariance[i];
+            }
+        }
+
+        sviInnerFit fit;
+        std::array<double, 3> x{};
+        if (solve3(A, r, x))
+        {
+            fit.a = x[0];
+            fit.d = x[1];
+            fit.c = x[2];
+        }
+        const bool feasible = fit.a >= 0.0 && std::abs(fit.d) <= fit.c && fit.c + std::abs(fit.d) <= 2.0 * sigma;
+        if (!feasible)
+        {
+            // Clamp c, then d, then take the best a for them.
+            fit.c = std::clamp(fit.c, 0.0, 2.0 * sigma);
+            fit.d = std::clamp(fit.d, -std::min(fit.c, 2.0 * sigma - fit.c), std::min(fit.c, 2.0 * sigma - fit.c));
+            double weightSum = 0.0;
+            double residualSum = 0.0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const double y = (slice.logMoneyness[i] - m) / sigma;
+                weightSum += slice.weight[i];
+                residualSum += slice.weight[i] * (slice.totalVariance[i] - fit.d * y - fit.c * std::sqrt(y * y + 1.0));
+            }
+            fit.a = std::max(0.0, residualSum / weightSum);
+        }
+
+        fit.error = 0.0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double y = (slice.logMoneyness[i] - m) / sigma;
+            const double residual = fit.a + fit.d * y + fit.c * std::sqrt(y * y + 1.0) - slice.totalVariance[i];
+            fit.error += slice.weight[i] * residual * residual;
+        }
+        return fit;
+    }
+
+    constexpr double minimumSigma = 1e-4;
+    constexpr double maximumSigma = 10.0;
+
+    /// @brief the inner error at (m, ln sigma), the point Nelder-Mead moves.
+    double outerError(const volatilitySlice& slice, const std::array<double, 2>& point)
+    {
+        const double sigma = std::exp(point[1]);
+        if (!(sigma >= minimumSigma && sigma <= maximumSigma))
+        {
+            return std::numeric_limits<double>::infinity();
+        }
+        return fitInner(slice, point[0], sigma).error;
+    }
+}
+
+/// @brief quasi-explicit SVI fit: Nelder-Mead on (m, ln sigma) around the linear least squares in (a, d, c).
+/// @param slice
+void fitVolatilitySlice(volatilitySlice& slice)
+{
+    const std::size_t n = slice.logMoneyness.size();
+    slice.stale = false;
+    if (n < 3)
+    {
+        // Too few quotes for a smile: a flat slice at their mean variance.
+        double weightSum = 0.0;
+        double varianceSum = 0.0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            weightSum += slice.weight[i];
+            varianceSum += slice.weight[i] * slice.totalVariance[i];
+        }
+        slice.parameters = sviParameters();
+        slice.parameters.a = weightSum > 0.0 ? varianceSum / weightSum : 0.0;
+        slice.parameters.b = 0.0;
+    }
+    else
+    {
+        // A fitted slice starts where it was, with a small simplex; a new one at the lowest quote.
+        const bool warm = slice.parameters.b > 0.0;
+        std::array<double, 2> start;
+        std::array<double, 2> step;
+        if (warm)
+        {
+            start = {slice.parameters.m, std::log(slice.parameters.sigma)};
+            step = {0.02, 0.1};
+        }
+        else
+        {
+            const std::size_t lowest = std::min_element(slice.totalVariance.begin(), slice.totalVariance.end())
+                                       - slice.totalVariance.begin();
+            start = {slice.logMoneyness[lowest], std::log(0.1)};
+            step = {0.1, 0.5};
+        }
+
+        std::array<std::array<double, 2>, 3> simplex = {start, start, start};
+        simplex[1][0] += step[0];
+        simplex[2][1] += step[1];
+        std::array<double, 3> error;
+        for (int v = 0; v < 3; ++v)
+        {
+            error[v] = outerError(slice, simplex[v]);
+        }
+
+        double scale = 0.0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            scale += slice.weight[i] * slice.totalVariance[i] * slice.totalVariance[i];
+        }
+
+        for (int iteration = 0; iteration < 400; ++iteration)
+        {
+            std::array<int, 3> order = {0, 1, 2};
+            std::sort(order.begin(), order.end(), [&](int p, int q) { return error[p] < error[q]; });
+            const int best = order[0], middle = order[1], worst = order[2];
+            if (error[worst] - error[best] <= 1e-15 * scale)
+            {
+                break;
+            }
+
+            const std::array<double, 2> centroid = {0.5 * (simplex[best][0] + simplex[middle][0]),
+                                                    0.5 * (simplex[best][1] + simplex[middle][1])};
+            auto along = [&](double t) {
+                return std::array<double, 2>{centroid[0] + t * (simplex[worst][0] - centroid[0]),
+                                             centroid[1] + t * (simplex[worst][1] - centroid[1])};
+            };
+
+            const std::array<double, 2> reflected = along(-1.0);
+            const double reflectedError = outerError(slice, reflected);
+            if (reflectedError < error[best])
+            {
+                const std::array<double, 2> expanded = along(-2.0);
+                const double expandedError = outerError(slice, expanded);
+                if (expandedError < reflectedError)
+                {
+                    simplex[worst] = expanded;
+                    error[worst] = expandedError;
+                }
+                else
+                {
+                    simplex[worst] = reflected;
+                    error[worst] = reflectedError;
+                }
+                continue;
+            }
+            if (reflectedError < error[middle])
+            {
+                simplex[worst] = reflected;
+                error[worst] = reflectedError;
+                continue;
+            }
+
+            const std::array<double, 2> contracted = along(reflectedError < error[worst] ? -0.5 : 0.5);
+            const double contractedError = outerError(slice, contracted);
+            if (contractedError < std::min(reflectedError, error[worst]))
+            {
+                simplex[worst] = contracted;
+                error[worst] = contractedError;
+                continue;
+            }
+
+            for (int v : {middle, worst})
+            {
+                simplex[v][0] = simplex[best][0] + 0.5 * (simplex[v][0] - simplex[best][0]);
+                simplex[v][1] = simplex[best][1] + 0.5 * (simplex[v][1] - simplex[best][1]);
+                error[v] = outerError(slice, simplex[v]);
+            }
+        }
+
+        const int best = static_cast<int>(std::min_element(error.begin(), error.end()) - error.begin());
+        const double m = simplex[best][0];
+        const double sigma = std::exp(simplex[best][1]);
+        const sviInnerFit fit = fitInner(slice, m, sigma);
+        slice.parameters.a = fit.a;
+        slice.parameters.b = fit.c / sigma;
+        slice.parameters.rho = fit.c > 0.0 ? fit.d / fit.c : 0.0;
+        slice.parameters.m = m;
+        slice.parameters.sigma = sigma;
+    }
+
+    double squaredError = 0.0;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        const double fitted = std::sqrt(std::max(0.0, slice.parameters.totalVariance(slice.logMoneyness[i])) / slice.timeToExperation);
+        const double quoted = std::sqrt(slice.totalVariance[i] / slice.timeToExperation);
+        squaredError += (fitted - quoted) * (fitted - quoted);
+    }
+    slice.rootMeanSquareError = n == 0 ? 0.0 : std::sqrt(squaredError / n);
+}
+
+volatilitySurface::volatilitySurface(double underlyingPrice, double riskFreeRate)
+    : _underlyingPrice(underlyingPrice), _riskFreeRate(riskFreeRate), _logUnderlyingPrice(std::log(underlyingPrice))
+{
+}
+
+void volatilitySurface::setUnderlyingPrice(double underlyingPrice)
+{
+    _underlyingPrice = underlyingPrice;
+    _logUnderlyingPrice = std::log(underlyingPrice);
+}
+
+void volatilitySurface::setRiskFreeRate(double riskFreeRate)
+{
+    _riskFreeRate = riskFreeRate;
+}
+
+/// @brief replaces the quotes of a slice, keeping its parameters as the start of the next fit.
+/// @param timeToExperation
+/// @param logMoneyness
+/// @param impliedVolatility
+/// @param weight
+/// @return true if the slice is new or its quotes changed.
+bool volatilitySurface::setSliceQuotes(double timeToExperation, const std::vector<double>& logMoneyness,
+                                       const std::vector<double>& impliedVolatility, const std::vector<double>& weight)
+{
+    volatilitySlice quotes;
+    quotes.timeToExperation = timeToExperation;
+    for (std::size_t i = 0; i < logMoneyness.size() && i < impliedVolatility.size(); ++i)
+    {
+        const double w = weight.empty() ? 1.0 : weight[i];
+        if (impliedVolatility[i] > 0.0 && std::isfinite(impliedVolatility[i]) && std::isfinite(logMoneyness[i])
+            && w > 0.0 && std::isfinite(w))
+        {
+            quotes.logMoneyness.push_back(logMoneyness[i]);
+            quotes.totalVariance.push_back(impliedVolatility[i] * impliedVolatility[i] * timeToExperation);
+            quotes.weight.push_back(w);
+        }
+    }
+
+    auto position = std::lower_bound(_expiries.begin(), _expiries.end(), timeToExperation);
+    const std::size_t index = position - _expiries.begin();
+    if (position != _expiries.end() && *position == timeToExperation)
+    {
+        volatilitySlice& slice = _slices[index];
+        if (slice.logMoneyness == quotes.logMoneyness && slice.totalVariance == quotes.totalVariance
+            && slice.weight == quotes.weight)
+        {
+            return false;
+        }
+        slice.logMoneyness = std::move(quotes.logMoneyness);
+        slice.totalVariance = std::move(quotes.totalVariance);
+        slice.weight = std::move(quotes.weight);
+        slice.stale = true;
+        return true;
+    }
+
+    _expiries.insert(position, timeToExperation);
+    _slices.insert(_slices.begin() + index, std::move(quotes));
+    packTable();
+    return true;
+}
+
+/// @brief removes the slice of an expiry.
+/// @param timeToExperation
+/// @return true if it existed.
+bool volatilitySurface::removeSlice(double timeToExperation)
+{
+    auto position = std::lower_bound(_expiries.begin(), _expiries.end(), timeToExperation);
+    if (position == _expiries.end() || *position != timeToExperation)
+    {
+        return false;
+    }
+    _slices.erase(_slices.begin() + (position - _expiries.begin()));
+    _expiries.erase(position);
+    packTable();
+    return true;
+}
+
+/// @brief fits the stale slices.
+/// @return the number fitted.
+std::size_t volatilitySurface::refit()
+{
+    std::size_t fitted = 0;
+    for (volatilitySlice& slice : _slices)
+    {
+        if (slice.stale)
+        {
+            fitVolatilitySlice(slice);
+            ++fitted;
+        }
+    }
+    if (fitted != 0)
+    {
+        packTable();
+    }
+    return fitted;
+}
+
+/// @brief copies the expiries and parameters into the columns read by the sviVolatility kernel.
+void volatilitySurface::packTable()
+{
+    const std::size_t count = _slices.size();
+    _table.resize(6 * count);
+    for (std::size_t s = 0; s < count; ++s)
+    {
+        const sviParameters& parameters = _slices[s].parameters;
+        _table[s] = _slices[s].timeToExperation;
+        _table[count + s] = parameters.a;
+        _table[2 * count + s] = parameters.b;
+        _table[3 * count + s] = parameters.rho;
+        _table[4 * count + s] = parameters.m;
+        _table[5 * count + s] = parameters.sigma * parameters.sigma;
+    }
+}
+
+/// @brief total variance at (k, T), linear in T between the slices around T.
+/// @param logMoneyness
+/// @param timeToExperation
+/// @return w(k, T)
+double volatilitySurface::totalVariance(double logMoneyness, double timeToExperation) const
+{
+    if (_slices.empty() || !(timeToExperation > 0.0))
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    const std::size_t next = std::upper_bound(_expiries.begin(), _expiries.end(), timeToExperation) - _expiries.begin();
+    if (next == 0 || next == _slices.size())
+    {
+        // Outside the slices: the volatility of the nearest one.
+        const volatilitySlice& nearest = _slices[next == 0 ? 0 : next - 1];
+        return nearest.parameters.totalVariance(logMoneyness) * (timeToExperation / nearest.timeToExperation);
+    }
+
+    const volatilitySlice& before = _slices[next - 1];
+    const volatilitySlice& after = _slices[next];
+    const double t = (timeToExperation - before.timeToExperation) / (after.timeToExperation - before.timeToExperation);
+    const double w0 = before.parameters.totalVariance(logMoneyness);
+    return w0 + t * (after.parameters.totalVariance(logMoneyness) - w0);
+}
+
+/// @brief implied volatility at a strike, against the reference forward S e^{rT}.
+/// @param strikePrice
+/// @param timeToExperation
+/// @return the volatility.
+double volatilitySurface::volatility(double strikePrice, double timeToExperation) const
+{
+    if (!(strikePrice > 0.0))
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    const double logMoneyness = std::log(strikePrice) - _logUnderlyingPrice - _riskFreeRate * timeToExperation;
+    return std::sqrt(totalVariance(logMoneyness, timeToExperation) / timeToExperation);
+}
+
+/// @brief volatilities of a batch, each option against its own forward, by the vectorized kernel.
+/// @param count
+/// @param underlyingPrice
+/// @param strikePrice
+/// @param timeToExperation
+/// @param riskFreeRate
+/// @param volatility
+void volatilitySurface::volatilityBatch(std::size_t count, const double* underlyingPrice, const double* strikePrice,
+                                        const double* timeToExperation, const double* riskFreeRate,
+                                        double* volatility) const
+{
+    simdKernels().sviVolatility(count, underlyingPrice, strikePrice, timeToExperation, riskFreeRate, _slices.size(),
+                                _table.data(), volatility);
+}
+
+/// @brief groups CSV rows by expiry, inverts their prices and refits the slices that changed.
+/// @param surface
+/// @param data
+/// @param riskFreeRate
+/// @return the number of slices refit.
+std::size_t updateVolatilitySurface(volatilitySurface& surface, const std::vector<CSVData>& data,
+                                    double riskFreeRate)
+{
+    std::map<int, std::vector<std::size_t>> rowsOf;
+    double spotSum = 0.0;
+    for (std::size_t i = 0; i < data.size(); ++i)
+    {
+        rowsOf[data[i].getExpiration()].push_back(i);
+        spotSum += data[i].getStockPrice();
+    }
+    if (!data.empty())
+    {
+        surface.setUnderlyingPrice(spotSum / data.size());
+    }
+    surface.setRiskFreeRate(riskFreeRate);
+
+    for (const auto& [expiration, rows] : rowsOf)
+    {
+        const double timeToExperation = expiration / 365.0;
+        const std::size_t count = rows.size();
+        std::vector<double> price(count), spot(count), strike(count), time(count, timeToExperation);
+        std::vector<double> rate(count, riskFreeRate), volatility(count), logMoneyness(count), weight(count);
+        std::vector<OptionType> type(count, CALL);
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            price[j] = data[rows[j]].getCallPrice();
+            spot[j] = data[rows[j]].getStockPrice();
+            strike[j] = data[rows[j]].getStrikePrice();
+        }
+        impliedVolatilityBatch(count, price.data(), spot.data(), strike.data(), time.data(), rate.data(), type.data(),
+                               volatility.data());
+
+        for (std::size_t j = 0; j < count; ++j)
+        {
+            logMoneyness[j] = std::log(strike[j] / spot[j]) - riskFreeRate * timeToExperation;
+            const double s = volatility[j] * std::sqrt(timeToExperation);
+            const double d1 = -logMoneyness[j] / s + 0.5 * s;
+            const double vega = spot[j] * std::sqrt(timeToExperation) * std::exp(-0.5 * d1 * d1) / std::sqrt(2.0 * std::numbers::pi);
+            // dPrice / dw = vega / (2 vol T), squared.
+            weight[j] = std::pow(vega / (2.0 * volatility[j] * timeToExperation), 2);
+        }
+        surface.setSliceQuotes(timeToExperation, logMoneyness, volatility, weight);
+    }
+    return surface.refit();
+}
+
+/// @brief prices a batch with volatilities from the surface.
+/// @param batch
+/// @param surface
+/// @param optionPrice
+/// @param cdfMethod
+void blackScholesBatchPrice(const optionBatch& batch, const volatilitySurface& surface, std::vector<double>& optionPrice,
+                            NormalCDFMethod cdfMethod)
+{
+    std::vector<double> volatility(batch.size());
+    surface.volatilityBatch(batch.size(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                            batch.timeToExperation.data(), batch.riskFreeRate.data(), volatility.data());
+    optionPrice.resize(batch.size());
+    blackScholesBatchPrice(batch.size(), batch.underlyingPrice.data(), batch.strikePrice.data(),
+                           batch.timeToExperation.data(), batch.riskFreeRate.data(), volatility.data(),
+                           batch.optionType.data(), optionPrice.data(), cdfMethod);
+}